@@ -27,7 +27,7 @@ public:
 
 	static const std::string paramsNames[];
 	static const std::string paramsUnitNames[];
-	static const int OVERSAMPLING_RATIO = 12;
+	static const int OVERSAMPLING_RATIO = 16;
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
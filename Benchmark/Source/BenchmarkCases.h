@@ -0,0 +1,771 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../../../zazzVSTPlugins/Shared/Utilities/Platform.h"
+
+#include <JuceHeader.h>
+
+#include "../../../zazzVSTPlugins/Shared/Utilities/Math.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/Oversampling.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/BiquadFilters.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/MultiLaneBiquadFilter.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/OnePoleFilters.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/HighOrderBiquadFilter.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/LinkwitzRileyFilter.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/ThreeBandEQ.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/ThreeBandSplit.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/HilbertFilter.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/AllPassFilters.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/SmallSpeakerSimulation.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/SpeakerCabinetSimulation.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/StateVariableFilters.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/EnvelopeFollowers.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/MultiLaneEnvelopeFollower.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/RMS.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/Compressors.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/Limiter.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/Limiter2.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/Limiter3.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/SideChainCompressor.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/VocalCompressorClean.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/NoiseGate.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/TransientShaper.h"
+#include "../../../zazzVSTPlugins/Shared/NonLinearFilters/Clippers.h"
+#include "../../../zazzVSTPlugins/Shared/NonLinearFilters/WaveShapers.h"
+#include "../../../zazzVSTPlugins/Shared/NonLinearFilters/BitCrusher.h"
+#include "../../../zazzVSTPlugins/Shared/NonLinearFilters/BitmaskCrusher.h"
+#include "../../../zazzVSTPlugins/Shared/NonLinearFilters/PhaseDistortion.h"
+#include "../../../zazzVSTPlugins/Shared/NonLinearFilters/TubeEmulation.h"
+#include "../../../zazzVSTPlugins/Shared/NonLinearFilters/ClassBAmplifier.h"
+#include "../../../zazzVSTPlugins/Shared/Delays/AllPassFilter.h"
+#include "../../../zazzVSTPlugins/Shared/Delays/CombFilter.h"
+#include "../../../zazzVSTPlugins/Shared/Delays/Delay.h"
+#include "../../../zazzVSTPlugins/Shared/Delays/AmbientDelay.h"
+#include "../../../zazzVSTPlugins/Shared/Delays/KarplusStrongDelay.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/EarlyReflections.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/Difuser.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/Tank.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/VelvetNoiseReverb.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/SmallRoomReverb.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/MultiLaneSmallRoomReverb.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/FibonacciSphereEarlyReflections.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/SchroederReverb.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/GriesingerPlateReverb.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/MoorerReverb.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/FeedbackDelayNetwork.h"
+#include "../../../zazzVSTPlugins/Shared/Oscillators/SinOscillator.h"
+#include "../../../zazzVSTPlugins/Shared/Oscillators/SawOscillator.h"
+#include "../../../zazzVSTPlugins/Shared/Oscillators/SinSawOscillator.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/PitchDetection.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/Convolutions.h"
+
+#include "BenchmarkRunner.h"
+
+// Shared/ classes left out on purpose:
+// - NestedCombFilter does not compile, it includes Utilities/CombFilter.h and Utilities/AllPassFilter.h which do not exist
+//   and uses members it does not declare. No plugin includes it.
+// - VocalCompressor does not compile, it calls TubeEmulation::init() and set(), which are gone, and Compressor::set()
+//   with 5 arguments. VocalCompressorClean is measured instead.
+// - GUI, FFT spectrum and offline analysis classes, they do not process audio per sample or per block.
+namespace Benchmark
+{
+	//==============================================================================
+	// Settings used by all reverbs with the shared 10 parameter set() signature
+	template <typename Reverb>
+	inline void setReverbDefaults(Reverb& reverb, const int sampleRate)
+	{
+		reverb.init(sampleRate);
+		reverb.set(5.0f, 0.5f, 0.5f, 0.5f, 1.0f, 20.0f, 0.5f, 0.5f, 0.5f, 1.0f);
+	}
+
+	//==============================================================================
+	// Parallel peak bands summed to one output, scalar reference for MultiLaneBiquadFilter
+	template <int Bands>
+	struct BiquadFilterBands
+	{
+		BiquadFilter filters[Bands];
+	};
+
+	template <int Bands>
+	inline void setBands(BiquadFilterBands<Bands>& bands, const int sampleRate)
+	{
+		for (int band = 0; band < Bands; band++)
+		{
+			bands.filters[band].init(sampleRate);
+			bands.filters[band].setPeak(100.0f * static_cast<float>(2 << band), 1.0f, 3.0f);
+		}
+	}
+
+	template <int Bands>
+	inline void setBands(MultiLaneBiquadFilter<Bands>& bands, const int sampleRate)
+	{
+		bands.init(sampleRate);
+		for (int band = 0; band < Bands; band++)
+		{
+			bands.set(band, BiquadFilter::Type::Peak, 100.0f * static_cast<float>(2 << band), 1.0f, 3.0f);
+		}
+	}
+
+	//==============================================================================
+	// 5.0 bed as processed by SmallRoomReverb51, scalar reference for MultiLaneSmallRoomReverb
+	struct SmallRoomReverbs5
+	{
+		static constexpr int CHANNELS = 5;
+		SmallRoomReverb reverbs[CHANNELS];
+	};
+
+	//==============================================================================
+	// Delay lines from 20 to 80 ms
+	template <int Lines>
+	inline void addFeedbackDelayNetworkCase(std::vector<Case>& cases)
+	{
+		const std::string linesName = std::to_string(Lines) + " lines";
+
+		cases.push_back(makeSampleCase<FeedbackDelayNetwork<Lines>>("Reverbs", ("FeedbackDelayNetwork/" + linesName).c_str(),
+			[](FeedbackDelayNetwork<Lines>& r, const int sr)
+			{
+				int sizes[Lines];
+				for (int line = 0; line < Lines; line++)
+				{
+					sizes[line] = (int)((0.02f + 0.06f * (float)line / (float)Lines) * (float)sr);
+				}
+
+				r.init(sr, sizes);
+				for (int line = 0; line < Lines; line++)
+				{
+					r.setInputGain(line, 0.5f);
+					r.setDampingFrequency(line, 8000.0f);
+				}
+				r.setFeedback(0.9f);
+			},
+			[](FeedbackDelayNetwork<Lines>& r, const float in)
+			{
+				float out = 0.0f;
+				r.process(&in, &out, 1);
+				return out;
+			}));
+	}
+
+	template <int Bands>
+	inline void addBandCases(std::vector<Case>& cases)
+	{
+		const std::string bandsName = std::to_string(Bands) + " bands";
+
+		cases.push_back(makeSampleCase<BiquadFilterBands<Bands>>("Filters", ("BiquadFilter/" + bandsName).c_str(),
+			[](BiquadFilterBands<Bands>& f, const int sr) { setBands(f, sr); },
+			[](BiquadFilterBands<Bands>& f, const float in)
+			{
+				float out = 0.0f;
+				for (int band = 0; band < Bands; band++)
+				{
+					out += f.filters[band].processDF2T(in);
+				}
+				return out;
+			}));
+
+		cases.push_back(makeSampleCase<MultiLaneBiquadFilter<Bands>>("Filters", ("MultiLaneBiquadFilter/" + bandsName).c_str(),
+			[](MultiLaneBiquadFilter<Bands>& f, const int sr) { setBands(f, sr); },
+			[](MultiLaneBiquadFilter<Bands>& f, const float in)
+			{
+				alignas(32) float frame[Bands];
+				for (int band = 0; band < Bands; band++)
+				{
+					frame[band] = in;
+				}
+
+				f.process(frame);
+
+				float out = 0.0f;
+				for (int band = 0; band < Bands; band++)
+				{
+					out += frame[band];
+				}
+				return out;
+			}));
+	}
+
+	//==============================================================================
+	inline void addFilterCases(std::vector<Case>& cases)
+	{
+		cases.push_back(makeSampleCase<BiquadFilter>("Filters", "BiquadFilter/LowPass DF1",
+			[](BiquadFilter& f, const int sr) { f.init(sr); f.setLowPass(2000.0f, 0.707f); },
+			[](BiquadFilter& f, const float in) { return f.processDF1(in); }));
+
+		cases.push_back(makeSampleCase<BiquadFilter>("Filters", "BiquadFilter/LowPass DF2T",
+			[](BiquadFilter& f, const int sr) { f.init(sr); f.setLowPass(2000.0f, 0.707f); },
+			[](BiquadFilter& f, const float in) { return f.processDF2T(in); }));
+
+		cases.push_back(makeCase<BiquadFilter>("Filters", "BiquadFilter/LowPass DF1 block",
+			[](BiquadFilter& f, const int sr) { f.init(sr); f.setLowPass(2000.0f, 0.707f); },
+			[](BiquadFilter& f, float* buffer, const int samples) { f.processBlockDF1(buffer, samples); }));
+
+		cases.push_back(makeCase<BiquadFilter>("Filters", "BiquadFilter/LowPass DF2T block",
+			[](BiquadFilter& f, const int sr) { f.init(sr); f.setLowPass(2000.0f, 0.707f); },
+			[](BiquadFilter& f, float* buffer, const int samples) { f.processBlockDF2T(buffer, samples); }));
+
+		cases.push_back(makeSampleCase<BiquadFilter>("Filters", "BiquadFilter/Peak DF1",
+			[](BiquadFilter& f, const int sr) { f.init(sr); f.setPeak(1000.0f, 1.0f, 6.0f); },
+			[](BiquadFilter& f, const float in) { return f.processDF1(in); }));
+
+		cases.push_back(makeSampleCase<BiquadFilter>("Filters", "BiquadFilter/Peak std::function",
+			[](BiquadFilter& f, const int sr) { f.init(sr); f.setType(BiquadFilter::Type::Peak); f.setAlgorithm(BiquadFilter::Algorithm::DF1); f.set(1000.0f, 1.0f, 6.0f); },
+			[](BiquadFilter& f, const float in) { return f.process(in); }));
+
+		// Coefficient update every sample, as done by Resynthesizer
+		cases.push_back(makeSampleCase<BiquadFilter>("Filters", "BiquadFilter/BandPass set per sample",
+			[](BiquadFilter& f, const int sr) { f.init(sr); },
+			[](BiquadFilter& f, const float in) { f.setBandPassPeakGain(1000.0f + 100.0f * in, 4.0f); return f.processDF1(in); }));
+
+		// Same sweep with coefficients set once per 32 samples and ramped in between
+		cases.push_back(makeCase<BiquadFilter>("Filters", "BiquadFilter/BandPass smoothed 32",
+			[](BiquadFilter& f, const int sr) { f.init(sr); },
+			[](BiquadFilter& f, float* buffer, const int samples)
+			{
+				for (int sample = 0; sample < samples; sample++)
+				{
+					if (sample % 32 == 0)
+					{
+						f.setSmoothed(BiquadFilter::Type::BandPassPeakGain, 1000.0f + 100.0f * buffer[sample], 4.0f, 0.0f, 32);
+					}
+
+					buffer[sample] = f.processSmoothedDF1(buffer[sample]);
+				}
+			}));
+
+		addBandCases<4>(cases);
+		addBandCases<8>(cases);
+
+		cases.push_back(makeSampleCase<LowPassBiquadFilter>("Filters", "LowPassBiquadFilter",
+			[](LowPassBiquadFilter& f, const int sr) { f.init(sr); f.set(2000.0f, 0.707f); },
+			[](LowPassBiquadFilter& f, const float in) { return f.process(in); }));
+
+		cases.push_back(makeSampleCase<OnePoleLowPassFilter>("Filters", "OnePoleLowPassFilter",
+			[](OnePoleLowPassFilter& f, const int sr) { f.init(sr); f.set(2000.0f); },
+			[](OnePoleLowPassFilter& f, const float in) { return f.process(in); }));
+
+		cases.push_back(makeSampleCase<ForthOrderLowPassFilter>("Filters", "ForthOrderLowPassFilter",
+			[](ForthOrderLowPassFilter& f, const int sr) { f.init(sr); f.set(2000.0f); },
+			[](ForthOrderLowPassFilter& f, const float in) { return f.process(in); }));
+
+		cases.push_back(makeSampleCase<EighthOrderLowPassFilter>("Filters", "EighthOrderLowPassFilter",
+			[](EighthOrderLowPassFilter& f, const int sr) { f.init(sr); f.set(2000.0f); },
+			[](EighthOrderLowPassFilter& f, const float in) { return f.process(in); }));
+
+		cases.push_back(makeSampleCase<LinkwitzRileyFilter>("Filters", "LinkwitzRileyFilter/LowPass",
+			[](LinkwitzRileyFilter& f, const int sr) { f.init(sr); f.set(2000.0f); },
+			[](LinkwitzRileyFilter& f, const float in) { return f.processLP(in); }));
+
+		cases.push_back(makeSampleCase<ThreeBandEQ>("Filters", "ThreeBandEQ",
+			[](ThreeBandEQ& f, const int sr) { f.init(sr); f.set(200.0f, 2000.0f, 3.0f, -2.0f, 4.0f); },
+			[](ThreeBandEQ& f, const float in) { return f.process(in); }));
+
+		cases.push_back(makeSampleCase<ThreeBandSplit>("Filters", "ThreeBandSplit",
+			[](ThreeBandSplit& f, const int sr) { f.init(sr); f.set(200.0f, 2000.0f); },
+			[](ThreeBandSplit& f, const float in) { float low, mid, high; f.process(in, low, mid, high); return low + mid + high; }));
+
+		cases.push_back(makeSampleCase<SecondOrderAllPass>("Filters", "SecondOrderAllPass",
+			[](SecondOrderAllPass& f, const int sr) { f.init(sr); f.setFrequency(1000.0f, 0.707f); },
+			[](SecondOrderAllPass& f, const float in) { return f.process(in); }));
+
+		cases.push_back(makeSampleCase<HilbertFilterIIR>("Filters", "HilbertFilterIIR",
+			[](HilbertFilterIIR& f, const int sr) { f.init(sr); f.set(); },
+			[](HilbertFilterIIR& f, const float in) { float real, imaginary; f.process(in, real, imaginary); return real + imaginary; }));
+
+		cases.push_back(makeSampleCase<SmallSpeakerSimulation>("Filters", "SmallSpeakerSimulation",
+			[](SmallSpeakerSimulation& f, const int sr) { f.init(sr); f.set(0, 0.0f); },
+			[](SmallSpeakerSimulation& f, const float in) { return f.process(in); }));
+
+		cases.push_back(makeSampleCase<SpeakerCabineSimulation>("Filters", "SpeakerCabineSimulation",
+			[](SpeakerCabineSimulation& f, const int sr) { f.init(sr); f.set(); },
+			[](SpeakerCabineSimulation& f, const float in) { return f.process(in); }));
+
+		cases.push_back(makeSampleCase<StateVariableFilter>("Filters", "StateVariableFilter/LowPass",
+			[](StateVariableFilter& f, const int sr) { f.init(sr); f.setLowPass(2000.0f, 0.707f); },
+			[](StateVariableFilter& f, const float in) { return f.processLowPass(in); }));
+
+		cases.push_back(makeSampleCase<StateVariableFilter>("Filters", "StateVariableFilter/BandPass",
+			[](StateVariableFilter& f, const int sr) { f.init(sr); f.setBandPass(1000.0f, 2.0f); },
+			[](StateVariableFilter& f, const float in) { return f.processBandPass(in); }));
+	}
+
+	//==============================================================================
+	inline void addDynamicsCases(std::vector<Case>& cases)
+	{
+		cases.push_back(makeSampleCase<BranchingEnvelopeFollower<float>>("Dynamics", "BranchingEnvelopeFollower",
+			[](BranchingEnvelopeFollower<float>& e, const int sr) { e.init(sr); e.set(5.0f, 50.0f); },
+			[](BranchingEnvelopeFollower<float>& e, const float in) { return e.process(in); }));
+
+		cases.push_back(makeSampleCase<DecoupeledEnvelopeFollower<float>>("Dynamics", "DecoupeledEnvelopeFollower",
+			[](DecoupeledEnvelopeFollower<float>& e, const int sr) { e.init(sr); e.set(5.0f, 50.0f); },
+			[](DecoupeledEnvelopeFollower<float>& e, const float in) { return e.process(in); }));
+
+		cases.push_back(makeSampleCase<HoldEnvelopeFollower<float>>("Dynamics", "HoldEnvelopeFollower",
+			[](HoldEnvelopeFollower<float>& e, const int sr) { e.init(sr); e.set(5.0f, 50.0f, 10.0f); },
+			[](HoldEnvelopeFollower<float>& e, const float in) { return e.process(in); }));
+
+		cases.push_back(makeSampleCase<OptoEnvelopeFollower<float>>("Dynamics", "OptoEnvelopeFollower",
+			[](OptoEnvelopeFollower<float>& e, const int sr) { e.init(sr); e.set(5.0f, 50.0f); },
+			[](OptoEnvelopeFollower<float>& e, const float in) { return e.process(in); }));
+
+		cases.push_back(makeSampleCase<ZCHoldEnvelopeFollower<float>>("Dynamics", "ZCHoldEnvelopeFollower",
+			[](ZCHoldEnvelopeFollower<float>& e, const int sr) { e.init(sr); e.set(5.0f, 50.0f); },
+			[](ZCHoldEnvelopeFollower<float>& e, const float in) { return e.process(in); }));
+
+		// 8 bands, scalar followers vs one multi-lane follower
+		cases.push_back(makeSampleCase<std::array<BranchingEnvelopeFollower<float>, 8>>("Dynamics", "BranchingEnvelopeFollower/8 bands",
+			[](std::array<BranchingEnvelopeFollower<float>, 8>& e, const int sr)
+			{
+				for (int band = 0; band < 8; band++)
+				{
+					e[band].init(sr);
+					e[band].set(5.0f + (float)band, 50.0f);
+				}
+			},
+			[](std::array<BranchingEnvelopeFollower<float>, 8>& e, const float in)
+			{
+				float out = 0.0f;
+				for (int band = 0; band < 8; band++)
+				{
+					out += e[band].process(in * (float)(band + 1));
+				}
+				return out;
+			}));
+
+		cases.push_back(makeSampleCase<MultiLaneEnvelopeFollower<8>>("Dynamics", "MultiLaneEnvelopeFollower/8 bands",
+			[](MultiLaneEnvelopeFollower<8>& e, const int sr)
+			{
+				e.init(sr);
+				for (int band = 0; band < 8; band++)
+				{
+					e.set(band, 5.0f + (float)band, 50.0f);
+				}
+			},
+			[](MultiLaneEnvelopeFollower<8>& e, const float in)
+			{
+				alignas(32) float frame[8];
+				for (int band = 0; band < 8; band++)
+				{
+					frame[band] = in * (float)(band + 1);
+				}
+
+				e.process(frame);
+
+				float out = 0.0f;
+				for (int band = 0; band < 8; band++)
+				{
+					out += frame[band];
+				}
+				return out;
+			}));
+
+		cases.push_back(makeSampleCase<RMS>("Dynamics", "RMS",
+			[](RMS& r, const int sr) { r.init(sr / 100); },
+			[](RMS& r, const float in) { return r.process(in); }));
+
+		cases.push_back(makeSampleCase<Compressor<>>("Dynamics", "Compressor/HardKnee",
+			[](Compressor<>& c, const int sr) { c.init(sr); c.set(-18.0f, 4.0f, 0.0f, 5.0f, 50.0f, 0.5f, 0.5f); },
+			[](Compressor<>& c, const float in) { return c.processHardKnee(in); }));
+
+		cases.push_back(makeSampleCase<Compressor<>>("Dynamics", "Compressor/HardKnee Peak Log",
+			[](Compressor<>& c, const int sr) { c.init(sr); c.set(-18.0f, 4.0f, 0.0f, 5.0f, 50.0f, 1.0f, 1.0f); },
+			[](Compressor<>& c, const float in) { return c.processHardKnee<CompressorDetector::Peak, CompressorEnvelope::Log>(in); }));
+
+		using CompressorApprox = Compressor<DecibelConversion::Approx>;
+		cases.push_back(makeSampleCase<CompressorApprox>("Dynamics", "Compressor/HardKnee Approx",
+			[](CompressorApprox& c, const int sr) { c.init(sr); c.set(-18.0f, 4.0f, 0.0f, 5.0f, 50.0f, 0.5f, 0.5f); },
+			[](CompressorApprox& c, const float in) { return c.processHardKnee(in); }));
+
+		using CompressorTable = Compressor<DecibelConversion::Table>;
+		cases.push_back(makeSampleCase<CompressorTable>("Dynamics", "Compressor/HardKnee Table",
+			[](CompressorTable& c, const int sr) { c.init(sr); c.set(-18.0f, 4.0f, 0.0f, 5.0f, 50.0f, 0.5f, 0.5f); },
+			[](CompressorTable& c, const float in) { return c.processHardKnee(in); }));
+
+		cases.push_back(makeSampleCase<SlewCompressor<>>("Dynamics", "SlewCompressor/HardKnee",
+			[](SlewCompressor<>& c, const int sr) { c.init(sr); c.set(-18.0f, 4.0f, 0.0f, 5.0f, 50.0f, 0.5f, 0.5f); },
+			[](SlewCompressor<>& c, const float in) { return c.processHardKnee(in); }));
+
+		cases.push_back(makeSampleCase<OptoCompressor<>>("Dynamics", "OptoCompressor/HardKnee",
+			[](OptoCompressor<>& c, const int sr) { c.init(sr); c.set(-18.0f, 4.0f, 0.0f, 5.0f, 50.0f, 0.5f, 0.5f); },
+			[](OptoCompressor<>& c, const float in) { return c.processHardKnee(in); }));
+
+		cases.push_back(makeSampleCase<DualCompressor<>>("Dynamics", "DualCompressor/HardKnee",
+			[](DualCompressor<>& c, const int sr) { c.init(sr); c.set(-18.0f, 4.0f, 0.0f, 5.0f, 50.0f, 0.5f, 0.5f); },
+			[](DualCompressor<>& c, const float in) { return c.processHardKnee(in); }));
+
+		cases.push_back(makeSampleCase<AdaptiveCompressor<>>("Dynamics", "AdaptiveCompressor/HardKnee",
+			[](AdaptiveCompressor<>& c, const int sr) { c.init(sr); c.set(-18.0f, 4.0f, 0.0f, 5.0f, 50.0f, 0.5f, 0.5f); },
+			[](AdaptiveCompressor<>& c, const float in) { return c.processHardKnee(in); }));
+
+		cases.push_back(makeSampleCase<SmoothCompressor<>>("Dynamics", "SmoothCompressor/HardKnee",
+			[](SmoothCompressor<>& c, const int sr) { c.init(sr); c.set(-18.0f, 4.0f, 0.0f, 5.0f, 50.0f, 0.5f, 0.5f); },
+			[](SmoothCompressor<>& c, const float in) { return c.processHardKnee(in); }));
+
+		cases.push_back(makeSampleCase<Limiter3<>>("Dynamics", "Limiter3/5ms",
+			[](Limiter3<>& l, const int sr) { const int size = (int)(0.005f * (float)sr); l.init(sr, size + 1); l.set(5.0f, 50.0f, 0.25f); },
+			[](Limiter3<>& l, const float in) { return l.process(in); }));
+
+		cases.push_back(makeSampleCase<Limiter3<>>("Dynamics", "Limiter3/10ms",
+			[](Limiter3<>& l, const int sr) { const int size = (int)(0.010f * (float)sr); l.init(sr, size + 1); l.set(10.0f, 50.0f, 0.25f); },
+			[](Limiter3<>& l, const float in) { return l.process(in); }));
+
+		using Limiter3Approx = Limiter3<DecibelConversion::Approx>;
+		cases.push_back(makeSampleCase<Limiter3Approx>("Dynamics", "Limiter3/10ms Approx",
+			[](Limiter3Approx& l, const int sr) { const int size = (int)(0.010f * (float)sr); l.init(sr, size + 1); l.set(10.0f, 50.0f, 0.25f); },
+			[](Limiter3Approx& l, const float in) { return l.process(in); }));
+
+		cases.push_back(makeSampleCase<Limiter>("Dynamics", "Limiter/5ms",
+			[](Limiter& l, const int sr) { const int size = (int)(0.005f * (float)sr); l.init(sr, size + 1); l.set(5.0f, 50.0f, 0.25f); },
+			[](Limiter& l, const float in) { return l.process(in); }));
+
+		cases.push_back(makeSampleCase<Limiter2>("Dynamics", "Limiter2/5ms",
+			[](Limiter2& l, const int sr) { const int size = (int)(0.005f * (float)sr); l.init(sr, size + 1); l.set(5.0f, 50.0f, 0.25f); },
+			[](Limiter2& l, const float in) { return l.process(in); }));
+
+		// set() does not set the side chain filters, so the side chain stays silent and this measures the below threshold path
+		cases.push_back(makeSampleCase<SideChainCompressor<>>("Dynamics", "SideChainCompressor/HardKnee",
+			[](SideChainCompressor<>& c, const int sr) { c.init(sr); c.set(-18.0f, 4.0f, 5.0f, 50.0f, 8000.0f, 100.0f); },
+			[](SideChainCompressor<>& c, const float in) { return c.processHardKnee(in); }));
+
+		cases.push_back(makeSampleCase<VocalCompressorClean>("Dynamics", "VocalCompressorClean",
+			[](VocalCompressorClean& c, const int sr) { c.init(sr); },
+			[](VocalCompressorClean& c, const float in) { return c.process(in); }));
+
+		cases.push_back(makeSampleCase<NoiseGate>("Dynamics", "NoiseGate",
+			[](NoiseGate& g, const int sr) { g.init(sr); g.set(1.0f, 50.0f, 10.0f, -30.0f); },
+			[](NoiseGate& g, const float in) { return g.process(in); }));
+
+		cases.push_back(makeSampleCase<TransientShaperAdvanced>("Dynamics", "TransientShaperAdvanced",
+			[](TransientShaperAdvanced& t, const int sr) { t.init(sr); t.set(0.5f, -0.3f, 0.5f, 0.5f); },
+			[](TransientShaperAdvanced& t, const float in) { return t.process(in); }));
+	}
+
+	//==============================================================================
+	struct Stateless {};
+
+	inline Case makeClipperBlockCase(const char* name, void (*block)(const Clippers::Params&), const float wet)
+	{
+		return makeCase<Stateless>("NonLinearFilters", name,
+			[](Stateless&, const int) {},
+			[block, wet](Stateless&, float* buffer, const int samples)
+			{
+				Clippers::Params params;
+				params.threshold = 0.25f;
+				params.wet = wet;
+				params.buffer = buffer;
+				params.samples = static_cast<unsigned int>(samples);
+				block(params);
+			});
+	}
+
+	// Blocks longer than OVERSAMPLING_BLOCK are processed in chunks
+	constexpr int OVERSAMPLING_BLOCK = 4096;
+
+	inline Case makeOversamplingCase(const char* name, const int ratio, const Oversampling::Phase phase)
+	{
+		return makeCase<Oversampling>("NonLinearFilters", name,
+			[ratio, phase](Oversampling& o, const int sr) { o.init(sr, ratio, OVERSAMPLING_BLOCK, phase); },
+			[](Oversampling& o, float* buffer, const int samples)
+			{
+				for (int start = 0; start < samples; start += OVERSAMPLING_BLOCK)
+				{
+					const int chunk = std::min(OVERSAMPLING_BLOCK, samples - start);
+
+					o.oversample(buffer + start, chunk);
+
+					auto* oversampled = o.getOversampeBuffer();
+					for (int sample = 0; sample < o.getOversampeBufferSize(); sample++)
+					{
+						oversampled[sample] = Clippers::Hard(oversampled[sample], 0.25f);
+					}
+
+					o.downsample(buffer + start, chunk);
+				}
+			});
+	}
+
+	inline void addNonLinearCases(std::vector<Case>& cases)
+	{
+		cases.push_back(makeClipperBlockCase("Clippers::HardBlock", Clippers::HardBlock, 1.0f));
+		cases.push_back(makeClipperBlockCase("Clippers::HardBlock/mix", Clippers::HardBlock, 0.5f));
+		cases.push_back(makeClipperBlockCase("Clippers::SoftBlock", Clippers::SoftBlock, 1.0f));
+		cases.push_back(makeClipperBlockCase("Clippers::HalfWaveBlock", Clippers::HalfWaveBlock, 1.0f));
+		cases.push_back(makeClipperBlockCase("Clippers::ABSBlock", Clippers::ABSBlock, 1.0f));
+		cases.push_back(makeClipperBlockCase("Clippers::CrispBlock", Clippers::CrispBlock, 1.0f));
+
+		cases.push_back(makeSampleCase<Stateless>("NonLinearFilters", "Clippers::Soft",
+			[](Stateless&, const int) {},
+			[](Stateless&, const float in) { return Clippers::Soft(in, 0.25f); }));
+
+		cases.push_back(makeSampleCase<Stateless>("NonLinearFilters", "Clippers::FoldBack",
+			[](Stateless&, const int) {},
+			[](Stateless&, const float in) { return Clippers::FoldBack(in, 0.25f); }));
+
+		cases.push_back(makeSampleCase<SlopeClipper>("NonLinearFilters", "SlopeClipper",
+			[](SlopeClipper& c, const int sr) { c.set(sr); },
+			[](SlopeClipper& c, const float in) { return c.process(in, 0.25f); }));
+
+		cases.push_back(makeSampleCase<SoftClipper>("NonLinearFilters", "SoftClipper",
+			[](SoftClipper& c, const int sr) { c.init(sr); },
+			[](SoftClipper& c, const float in) { return c.process(4.0f * in); }));
+
+		cases.push_back(makeSampleCase<Stateless>("NonLinearFilters", "Waveshapers::Tanh",
+			[](Stateless&, const int) {},
+			[](Stateless&, const float in) { return Waveshapers::Tanh(in, 4.0f); }));
+
+		cases.push_back(makeSampleCase<BitCrusher>("NonLinearFilters", "BitCrusher/Floor",
+			[](BitCrusher& b, const int sr) { b.init(sr); b.set(8.0f, 2, 8000.0f); },
+			[](BitCrusher& b, const float in) { return b.processFloor(in); }));
+
+		cases.push_back(makeSampleCase<BitmaskCrusher>("NonLinearFilters", "BitmaskCrusher",
+			[](BitmaskCrusher& b, const int) { b.set(0.5f, 0x78); },
+			[](BitmaskCrusher& b, const float in) { return b.process(in); }));
+
+		cases.push_back(makeSampleCase<Stateless>("NonLinearFilters", "TubeEmulation",
+			[](Stateless&, const int) {},
+			[](Stateless&, const float in) { return TubeEmulation::process(4.0f * in); }));
+
+		cases.push_back(makeSampleCase<ClassBAmplifier>("NonLinearFilters", "ClassBAmplifier",
+			[](ClassBAmplifier& a, const int sr) { a.init(sr); a.set(4.0f); },
+			[](ClassBAmplifier& a, const float in) { return a.process(in); }));
+
+		cases.push_back(makeSampleCase<PhaseDistortion>("NonLinearFilters", "PhaseDistortion",
+			[](PhaseDistortion& p, const int sr) { p.init(sr); p.set(0.5f, -6.0f); },
+			[](PhaseDistortion& p, const float in) { return p.process(in); }));
+
+		cases.push_back(makeOversamplingCase("Oversampling/2x HardClip", 2, Oversampling::Phase::Minimum));
+		cases.push_back(makeOversamplingCase("Oversampling/4x HardClip", 4, Oversampling::Phase::Minimum));
+		cases.push_back(makeOversamplingCase("Oversampling/16x HardClip", 16, Oversampling::Phase::Minimum));
+		cases.push_back(makeOversamplingCase("Oversampling/2x HardClip linear phase", 2, Oversampling::Phase::Linear));
+		cases.push_back(makeOversamplingCase("Oversampling/16x HardClip linear phase", 16, Oversampling::Phase::Linear));
+	}
+
+	//==============================================================================
+	inline void addDelayAndReverbCases(std::vector<Case>& cases)
+	{
+		cases.push_back(makeSampleCase<AllPassFilter>("Delays", "AllPassFilter",
+			[](AllPassFilter& f, const int sr) { f.init(sr / 100); f.set(sr / 100, 0.6f); },
+			[](AllPassFilter& f, const float in) { return f.process(in); }));
+
+		cases.push_back(makeSampleCase<LowPassCombFilter>("Delays", "LowPassCombFilter",
+			[](LowPassCombFilter& f, const int sr) { f.init(sr / 30, sr); f.set(sr / 30, 0.8f, 4000.0f); },
+			[](LowPassCombFilter& f, const float in) { return f.process(in); }));
+
+		cases.push_back(makeSampleCase<Delay>("Delays", "Delay",
+			[](Delay& d, const int sr) { d.init(sr, sr / 2); d.set(0.5f, sr / 4); },
+			[](Delay& d, const float in) { return d.process(in); }));
+
+		cases.push_back(makeSampleCase<AmbientDelay>("Delays", "AmbientDelay",
+			[](AmbientDelay& d, const int sr) { d.init(sr / 2, sr); d.set(0.25f * (float)sr, 8000.0f, 200.0f, 0.5f, -0.3f, 10.0f, 2.0f); },
+			[](AmbientDelay& d, const float in) { return d.process(in); }));
+
+		cases.push_back(makeSampleCase<KarplusStrongDelay>("Delays", "KarplusStrongDelay",
+			[](KarplusStrongDelay& d, const int sr) { d.init(sr, 40.0f); d.set(220.0f, 1.0f); },
+			[](KarplusStrongDelay& d, const float in) { return d.process(in); }));
+
+		// Early reflections, diffuser and tank as used by SmallRoomReverb
+		const auto setEarlyReflections = [](EarlyReflections& r, const int sr)
+		{
+			r.init(sr, 0);
+
+			EarlyReflectionsParams params = {};
+			params.predelay = 10.0f;
+			params.length = 60.0f;
+			params.decay = -8.0f;
+			params.diffusion = 0.5f;
+			params.damping = 0.0f;
+			params.width = 0.05f;
+			r.set(params);
+		};
+		cases.push_back(makeSampleCase<EarlyReflections>("Reverbs", "EarlyReflections", setEarlyReflections,
+			[](EarlyReflections& r, const float in) { return r.process(in); }));
+		cases.push_back(makeCase<EarlyReflections>("Reverbs", "EarlyReflections/block", setEarlyReflections,
+			[](EarlyReflections& r, float* buffer, const int samples) { r.processBlock(buffer, buffer, samples); }));
+
+		const std::pair<const char*, int> types[] = { { "Schroeder", 0 }, { "Moorer", 1 }, { "Griesinger", 2 }, { "Zazz", 3 } };
+		for (const auto& type : types)
+		{
+			const int typeIndex = type.second;
+
+			cases.push_back(makeSampleCase<Difuser>("Reverbs", (std::string("Difuser/") + type.first).c_str(),
+				[typeIndex](Difuser& d, const int sr)
+				{
+					d.init(sr, 0);
+
+					DifuserParams params = {};
+					params.width = 0.5f;
+					params.size = 0.5f;
+					params.type = static_cast<DifuserParams::Type>(typeIndex);
+					d.set(params);
+				},
+				[](Difuser& d, const float in) { return d.process(in); }));
+
+			cases.push_back(makeSampleCase<Tank>("Reverbs", (std::string("Tank/") + type.first).c_str(),
+				[typeIndex](Tank& t, const int sr)
+				{
+					t.init(sr);
+
+					TankParams params = {};
+					params.predelay = 10.0f;
+					params.length = 0.5f;
+					params.size = 0.5f;
+					params.damping = 0.5f;
+					params.width = 0.5f;
+					params.type = static_cast<TankParams::Type>(typeIndex);
+					t.set(params);
+				},
+				[](Tank& t, const float in) { return t.process(in); }));
+		}
+
+		cases.push_back(makeSampleCase<VelvetNoiseReverb>("Reverbs", "VelvetNoiseReverb/2s",
+			[](VelvetNoiseReverb& r, const int sr) { r.init(sr, 2.5f); r.set(2.0f, 0.01f, 1.0f, 0.5f, 1234, 0.5f, 0.5f); },
+			[](VelvetNoiseReverb& r, const float in) { return r.process(in); }));
+		cases.push_back(makeCase<VelvetNoiseReverb>("Reverbs", "VelvetNoiseReverb/2s block",
+			[](VelvetNoiseReverb& r, const int sr) { r.init(sr, 2.5f); r.set(2.0f, 0.01f, 1.0f, 0.5f, 1234, 0.5f, 0.5f); },
+			[](VelvetNoiseReverb& r, float* buffer, const int samples) { r.process(buffer, buffer, samples); }));
+		cases.push_back(makeCase<VelvetNoiseReverb>("Reverbs", "VelvetNoiseReverb/2s dense block",
+			[](VelvetNoiseReverb& r, const int sr) { r.init(sr, 2.5f); r.set(2.0f, 0.01f, 1.0f, 1.0f, 1234, 0.5f, 0.5f); },
+			[](VelvetNoiseReverb& r, float* buffer, const int samples) { r.process(buffer, buffer, samples); }));
+
+		cases.push_back(makeCase<NonUniformPartitionedConvolution>("Reverbs", "NonUniformPartitionedConvolution/2s block",
+			[](NonUniformPartitionedConvolution& c, const int sr)
+			{
+				// Exponentially decaying noise, -60 dB at 2 s
+				std::vector<float> impulseResponse(2 * sr);
+				juce::Random random(1234);
+				for (size_t i = 0; i < impulseResponse.size(); i++)
+				{
+					impulseResponse[i] = 0.05f * (2.0f * random.nextFloat() - 1.0f) * std::exp(-6.9f * static_cast<float>(i) / impulseResponse.size());
+				}
+
+				c.init(static_cast<int>(impulseResponse.size()));
+				c.setImpulseResponse(impulseResponse.data(), static_cast<int>(impulseResponse.size()));
+			},
+			[](NonUniformPartitionedConvolution& c, float* buffer, const int samples) { c.process(buffer, buffer, samples); }));
+
+		for (const int reflections : { 8, 32 })
+		{
+			const std::string reflectionsName = std::to_string(reflections) + " reflections";
+			const auto setEarlyReflections = [reflections](FibonacciSphereEarlyReflections& r, const int sr)
+			{
+				r.init(40.0f, sr, reflections);
+				r.set(9.0f, 7.0f, 4.0f, 0.5f, { 0.5f, 0.3f, 0.5f }, reflections);
+			};
+
+			cases.push_back(makeSampleCase<FibonacciSphereEarlyReflections>("Reverbs", ("FibonacciSphereEarlyReflections/" + reflectionsName).c_str(),
+				setEarlyReflections,
+				[](FibonacciSphereEarlyReflections& r, const float in) { return r.process(in); }));
+			cases.push_back(makeCase<FibonacciSphereEarlyReflections>("Reverbs", ("FibonacciSphereEarlyReflections/" + reflectionsName + " block").c_str(),
+				setEarlyReflections,
+				[](FibonacciSphereEarlyReflections& r, float* buffer, const int samples) { r.process(buffer, buffer, samples); }));
+		}
+
+		cases.push_back(makeSampleCase<SmallRoomReverb>("Reverbs", "SmallRoomReverb",
+			[](SmallRoomReverb& r, const int sr) { r.init(sr, 0); r.set(5.0f, 0.5f, 0.5f, 0.5f, 1.0f, 20.0f, 0.5f, 0.5f, 0.5f, 1.0f); },
+			[](SmallRoomReverb& r, const float in) { return r.process(in); }));
+
+		cases.push_back(makeSampleCase<SmallRoomReverbs5>("Reverbs", "SmallRoomReverb/5 channels",
+			[](SmallRoomReverbs5& r, const int sr)
+			{
+				for (int channel = 0; channel < SmallRoomReverbs5::CHANNELS; channel++)
+				{
+					r.reverbs[channel].init(sr, channel);
+					r.reverbs[channel].set(5.0f, 0.5f, 0.5f, 0.5f, 1.0f, 20.0f, 0.5f, 0.5f, 0.5f, 1.0f);
+				}
+			},
+			[](SmallRoomReverbs5& r, const float in)
+			{
+				float out = 0.0f;
+				for (int channel = 0; channel < SmallRoomReverbs5::CHANNELS; channel++)
+				{
+					out += r.reverbs[channel].process(in);
+				}
+				return out;
+			}));
+		// Every lane reads the block before any lane writes it back, so all lanes can share one buffer
+		cases.push_back(makeCase<MultiLaneSmallRoomReverb<8>>("Reverbs", "MultiLaneSmallRoomReverb/5 channels block",
+			[](MultiLaneSmallRoomReverb<8>& r, const int sr) { r.init(sr); r.set(5.0f, 0.5f, 0.5f, 0.5f, 1.0f, 20.0f, 0.5f, 0.5f, 0.5f, 1.0f); },
+			[](MultiLaneSmallRoomReverb<8>& r, float* buffer, const int samples)
+			{
+				float* buffers[SmallRoomReverbs5::CHANNELS] = { buffer, buffer, buffer, buffer, buffer };
+				r.process(buffers, SmallRoomReverbs5::CHANNELS, samples);
+			}));
+
+		cases.push_back(makeSampleCase<SchroederReverb>("Reverbs", "SchroederReverb",
+			[](SchroederReverb& r, const int sr) { setReverbDefaults(r, sr); },
+			[](SchroederReverb& r, const float in) { return r.process(in); }));
+
+		cases.push_back(makeSampleCase<GriesingerPlateReverb>("Reverbs", "GriesingerPlateReverb",
+			[](GriesingerPlateReverb& r, const int sr) { setReverbDefaults(r, sr); },
+			[](GriesingerPlateReverb& r, const float in) { return r.process(in); }));
+
+		cases.push_back(makeSampleCase<MoorerReverb>("Reverbs", "MoorerReverb",
+			[](MoorerReverb& r, const int sr) { setReverbDefaults(r, sr); },
+			[](MoorerReverb& r, const float in) { return r.process(in); }));
+
+		addFeedbackDelayNetworkCase<16>(cases);
+		addFeedbackDelayNetworkCase<64>(cases);
+	}
+
+	//==============================================================================
+	inline void addOscillatorCases(std::vector<Case>& cases)
+	{
+		cases.push_back(makeSampleCase<SinOscillator>("Oscillators", "SinOscillator",
+			[](SinOscillator& o, const int sr) { o.init(sr); o.set(440.0f); },
+			[](SinOscillator& o, const float in) { return in + o.process(); }));
+
+		cases.push_back(makeSampleCase<SawOscillator>("Oscillators", "SawOscillator",
+			[](SawOscillator& o, const int sr) { o.init(sr); o.set(440.0f); },
+			[](SawOscillator& o, const float in) { return in + o.process(); }));
+
+		cases.push_back(makeSampleCase<SinSawOscillator>("Oscillators", "SinSawOscillator",
+			[](SinSawOscillator& o, const int sr) { o.init(sr); o.set(440.0f, 0.5f); },
+			[](SinSawOscillator& o, const float in) { return in + o.process(); }));
+	}
+
+	//==============================================================================
+	inline void addAnalysisCases(std::vector<Case>& cases)
+	{
+		cases.push_back(makeSampleCase<PitchDetection>("Analysis", "PitchDetection/FFT 4096 hop 512",
+			[](PitchDetection& p, const int sr) { p.init(sr, 12, 512); p.setType(PitchDetection::Type::FFT); p.set(40.0f, 2000.0f); },
+			[](PitchDetection& p, const float in) { p.process(in); return in + 1e-6f * p.getFrequency(); }));
+
+		cases.push_back(makeSampleCase<PitchDetection>("Analysis", "PitchDetection/YIN 2048 hop 256",
+			[](PitchDetection& p, const int sr) { p.init(sr, 11, 256); p.setType(PitchDetection::Type::YIN); p.set(40.0f, 2000.0f); },
+			[](PitchDetection& p, const float in) { p.process(in); return in + 1e-6f * p.getFrequency(); }));
+
+		cases.push_back(makeSampleCase<PitchDetection>("Analysis", "PitchDetection/McLeod 2048 hop 256",
+			[](PitchDetection& p, const int sr) { p.init(sr, 11, 256); p.setType(PitchDetection::Type::McLeod); p.set(40.0f, 2000.0f); },
+			[](PitchDetection& p, const float in) { p.process(in); return in + 1e-6f * p.getFrequency(); }));
+	}
+
+	//==============================================================================
+	inline std::vector<Case> createCases()
+	{
+		std::vector<Case> cases;
+
+		addFilterCases(cases);
+		addDynamicsCases(cases);
+		addNonLinearCases(cases);
+		addDelayAndReverbCases(cases);
+		addOscillatorCases(cases);
+		addAnalysisCases(cases);
+
+		return cases;
+	}
+}
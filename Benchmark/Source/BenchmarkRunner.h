@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define BENCHMARK_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+	#define BENCHMARK_HAS_TSC 1
+#else
+	#define BENCHMARK_HAS_TSC 0
+#endif
+
+namespace Benchmark
+{
+	//==============================================================================
+	// One processor under test. prepare() is called once per sample rate, process() once per block.
+	struct Case
+	{
+		std::string group;
+		std::string name;
+		std::function<void(const int sampleRate, const int blockSize)> prepare;
+		std::function<void(float* buffer, const int samples)> process;
+	};
+
+	//==============================================================================
+	// Holds processor instance between prepare() and process() calls
+	template <typename Processor, typename PrepareFunction, typename ProcessFunction>
+	inline Case makeCase(const char* group, const char* name, PrepareFunction prepare, ProcessFunction process)
+	{
+		auto processor = std::make_shared<std::unique_ptr<Processor>>();
+
+		Case benchmarkCase;
+		benchmarkCase.group = group;
+		benchmarkCase.name = name;
+		benchmarkCase.prepare = [processor, prepare](const int sampleRate, const int)
+		{
+			*processor = std::make_unique<Processor>();
+			prepare(**processor, sampleRate);
+		};
+		benchmarkCase.process = [processor, process](float* buffer, const int samples)
+		{
+			process(**processor, buffer, samples);
+		};
+
+		return benchmarkCase;
+	}
+
+	//==============================================================================
+	// Per sample processor: out = processor.process(in)
+	// Process function is a template argument so it gets inlined into the sample loop
+	template <typename Processor, typename PrepareFunction, typename ProcessFunction>
+	inline Case makeSampleCase(const char* group, const char* name, PrepareFunction prepare, ProcessFunction process)
+	{
+		return makeCase<Processor>(group, name, prepare, [process](Processor& processor, float* buffer, const int samples)
+		{
+			for (int sample = 0; sample < samples; sample++)
+			{
+				buffer[sample] = process(processor, buffer[sample]);
+			}
+		});
+	}
+
+	//==============================================================================
+	enum class Signal
+	{
+		Noise,
+		Sine
+	};
+
+	inline const char* getSignalName(const Signal signal)
+	{
+		return signal == Signal::Noise ? "noise" : "sine";
+	}
+
+	// Deterministic input so runs are comparable between machines and commits
+	inline void generateSignal(std::vector<float>& buffer, const Signal signal, const int sampleRate)
+	{
+		if (signal == Signal::Noise)
+		{
+			uint32_t state = 22222u;
+			for (auto& sample : buffer)
+			{
+				state = 1664525u * state + 1013904223u;
+				sample = 0.5f * (static_cast<float>(state >> 8) / 8388608.0f - 1.0f);
+			}
+		}
+		else
+		{
+			constexpr double frequency = 997.0;
+			const double phaseStep = 6.283185307179586 * frequency / static_cast<double>(sampleRate);
+			for (size_t i = 0; i < buffer.size(); i++)
+			{
+				buffer[i] = 0.5f * static_cast<float>(std::sin(phaseStep * static_cast<double>(i)));
+			}
+		}
+	}
+
+	//==============================================================================
+	inline uint64_t readCycleCounter() noexcept
+	{
+#if BENCHMARK_HAS_TSC
+		return __rdtsc();
+#else
+		return 0;
+#endif
+	}
+
+	//==============================================================================
+	struct Settings
+	{
+		std::vector<int> sampleRates = { 44100, 48000, 96000 };
+		std::vector<Signal> signals = { Signal::Noise, Signal::Sine };
+		std::string filter;
+		float seconds = 5.0f;						// Length of the measured buffer in seconds
+		int blockSize = 512;
+		int repeats = 5;
+	};
+
+	struct Result
+	{
+		std::string group;
+		std::string name;
+		const char* signal = "";
+		int sampleRate = 0;
+		int blockSize = 0;
+		double nsPerSample = 0.0;					// Median over repeats
+		double nsPerSampleMin = 0.0;
+		double cyclesPerSample = -1.0;				// Reference TSC cycles, -1 when not available
+		double realtimeFactor = 0.0;				// Audio seconds processed per wall clock second
+	};
+
+	//==============================================================================
+	class Runner
+	{
+	public:
+		Runner(const Settings& settings) : m_settings(settings) {};
+		~Runner() = default;
+
+		inline Result run(Case& benchmarkCase, const int sampleRate, const Signal signal)
+		{
+			juce::ScopedNoDenormals noDenormals;
+
+			const int samples = std::max(m_settings.blockSize, static_cast<int>(m_settings.seconds * static_cast<float>(sampleRate)));
+
+			m_source.resize(samples);
+			m_work.resize(samples);
+			generateSignal(m_source, signal, sampleRate);
+
+			benchmarkCase.prepare(sampleRate, m_settings.blockSize);
+
+			// Warm up caches, branch predictors and filter states
+			std::copy(m_source.begin(), m_source.end(), m_work.begin());
+			processBuffer(benchmarkCase, std::min(samples, sampleRate / 4));
+
+			std::vector<double> nsPerSample;
+			std::vector<double> cyclesPerSample;
+
+			for (int repeat = 0; repeat < std::max(1, m_settings.repeats); repeat++)
+			{
+				std::copy(m_source.begin(), m_source.end(), m_work.begin());
+
+				const uint64_t cyclesStart = readCycleCounter();
+				const auto timeStart = std::chrono::steady_clock::now();
+
+				processBuffer(benchmarkCase, samples);
+
+				const auto timeEnd = std::chrono::steady_clock::now();
+				const uint64_t cyclesEnd = readCycleCounter();
+
+				const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+				nsPerSample.push_back(ns / static_cast<double>(samples));
+				cyclesPerSample.push_back(static_cast<double>(cyclesEnd - cyclesStart) / static_cast<double>(samples));
+			}
+
+			Result result;
+			result.group = benchmarkCase.group;
+			result.name = benchmarkCase.name;
+			result.signal = getSignalName(signal);
+			result.sampleRate = sampleRate;
+			result.blockSize = m_settings.blockSize;
+			result.nsPerSample = median(nsPerSample);
+			result.nsPerSampleMin = *std::min_element(nsPerSample.begin(), nsPerSample.end());
+			result.cyclesPerSample = BENCHMARK_HAS_TSC ? median(cyclesPerSample) : -1.0;
+			result.realtimeFactor = result.nsPerSample > 0.0 ? 1.0e9 / (result.nsPerSample * static_cast<double>(sampleRate)) : 0.0;
+
+			return result;
+		}
+
+	private:
+		inline void processBuffer(Case& benchmarkCase, const int samples)
+		{
+			for (int sample = 0; sample < samples; sample += m_settings.blockSize)
+			{
+				const int blockSamples = std::min(m_settings.blockSize, samples - sample);
+				benchmarkCase.process(m_work.data() + sample, blockSamples);
+			}
+		}
+		inline static double median(std::vector<double> values)
+		{
+			std::sort(values.begin(), values.end());
+			const size_t middle = values.size() / 2;
+			return (values.size() % 2 != 0) ? values[middle] : 0.5 * (values[middle - 1] + values[middle]);
+		}
+
+		const Settings& m_settings;
+		std::vector<float> m_source;
+		std::vector<float> m_work;
+	};
+
+	//==============================================================================
+	inline void printCSVHeader(FILE* file)
+	{
+		std::fprintf(file, "group,name,signal,sample_rate,block_size,ns_per_sample,ns_per_sample_min,cycles_per_sample,realtime_factor\n");
+	}
+
+	inline void printCSV(FILE* file, const Result& result)
+	{
+		std::fprintf(file, "%s,%s,%s,%d,%d,%.3f,%.3f,%.2f,%.1f\n",
+					 result.group.c_str(), result.name.c_str(), result.signal, result.sampleRate, result.blockSize,
+					 result.nsPerSample, result.nsPerSampleMin, result.cyclesPerSample, result.realtimeFactor);
+	}
+
+	inline void printJSON(FILE* file, const std::vector<Result>& results)
+	{
+		std::fprintf(file, "[\n");
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const auto& result = results[i];
+			std::fprintf(file, "  { \"group\": \"%s\", \"name\": \"%s\", \"signal\": \"%s\", \"sample_rate\": %d, \"block_size\": %d, "
+							   "\"ns_per_sample\": %.3f, \"ns_per_sample_min\": %.3f, \"cycles_per_sample\": %.2f, \"realtime_factor\": %.1f }%s\n",
+						 result.group.c_str(), result.name.c_str(), result.signal, result.sampleRate, result.blockSize,
+						 result.nsPerSample, result.nsPerSampleMin, result.cyclesPerSample, result.realtimeFactor,
+						 i + 1 < results.size() ? "," : "");
+		}
+
+		std::fprintf(file, "]\n");
+	}
+}
@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+    Headless benchmark for Shared/ DSP classes.
+
+    Runs every registered processor over deterministic noise and sine buffers
+    at each requested sample rate and prints one row per measurement.
+
+    Usage:
+      Benchmark [--format csv|json] [--filter text] [--rates 44100,48000,96000]
+                [--signals noise,sine] [--seconds 5] [--block 512] [--repeats 5]
+                [--list] [--check]
+
+    --check runs correctness checks instead, exit code 1 on failure.
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCases.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+	//==============================================================================
+	std::vector<int> parseIntList(const char* text)
+	{
+		std::vector<int> values;
+		std::stringstream stream(text);
+		std::string item;
+
+		while (std::getline(stream, item, ','))
+		{
+			if (!item.empty())
+			{
+				values.push_back(std::atoi(item.c_str()));
+			}
+		}
+
+		return values;
+	}
+
+	//==============================================================================
+	std::vector<Benchmark::Signal> parseSignalList(const char* text)
+	{
+		std::vector<Benchmark::Signal> signals;
+		std::stringstream stream(text);
+		std::string item;
+
+		while (std::getline(stream, item, ','))
+		{
+			if (item == "noise")
+			{
+				signals.push_back(Benchmark::Signal::Noise);
+			}
+			else if (item == "sine")
+			{
+				signals.push_back(Benchmark::Signal::Sine);
+			}
+		}
+
+		return signals;
+	}
+
+	//==============================================================================
+	// Compares Oversampling::getLatency() with the DC group delay of the measured
+	// oversample -> downsample impulse response, sum(n * h[n]) / sum(h[n]).
+	bool checkOversamplingLatency()
+	{
+		constexpr int SAMPLES = 4 * Benchmark::OVERSAMPLING_BLOCK;
+		constexpr double TOLERANCE = 0.01;
+
+		bool passed = true;
+
+		for (const auto phase : { Oversampling::Phase::Linear, Oversampling::Phase::Minimum })
+		{
+			for (int ratio = 2; ratio <= (1 << Oversampling::MAX_STAGES); ratio *= 2)
+			{
+				Oversampling oversampling;
+				oversampling.init(48000, ratio, Benchmark::OVERSAMPLING_BLOCK, phase);
+
+				std::vector<float> buffer(SAMPLES, 0.0f);
+				buffer[0] = 1.0f;
+
+				for (int start = 0; start < SAMPLES; start += Benchmark::OVERSAMPLING_BLOCK)
+				{
+					oversampling.oversample(buffer.data() + start, Benchmark::OVERSAMPLING_BLOCK);
+					oversampling.downsample(buffer.data() + start, Benchmark::OVERSAMPLING_BLOCK);
+				}
+
+				double sum = 0.0;
+				double weightedSum = 0.0;
+				for (int sample = 0; sample < SAMPLES; sample++)
+				{
+					sum += buffer[sample];
+					weightedSum += static_cast<double>(sample) * buffer[sample];
+				}
+
+				const double measured = weightedSum / sum;
+				const double reported = oversampling.getLatency();
+				const bool ok = std::abs(measured - reported) < TOLERANCE;
+				passed = passed && ok;
+
+				std::printf("Oversampling latency %s %2dx: measured %.3f, reported %.3f, %s\n",
+							phase == Oversampling::Phase::Linear ? "linear" : "minimum", ratio, measured, reported, ok ? "OK" : "FAILED");
+			}
+		}
+
+		return passed;
+	}
+
+	//==============================================================================
+	void printUsage()
+	{
+		std::fprintf(stderr, "Usage: Benchmark [--format csv|json] [--filter text] [--rates 44100,48000,96000]\n"
+							 "                 [--signals noise,sine] [--seconds 5] [--block 512] [--repeats 5] [--list] [--check]\n");
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	Benchmark::Settings settings;
+	bool json = false;
+	bool listOnly = false;
+	bool check = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* argument = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+		if (std::strcmp(argument, "--list") == 0)
+		{
+			listOnly = true;
+		}
+		else if (std::strcmp(argument, "--check") == 0)
+		{
+			check = true;
+		}
+		else if (std::strcmp(argument, "--help") == 0 || std::strcmp(argument, "-h") == 0)
+		{
+			printUsage();
+			return 0;
+		}
+		else if (value == nullptr)
+		{
+			printUsage();
+			return 1;
+		}
+		else
+		{
+			if (std::strcmp(argument, "--format") == 0)
+			{
+				json = std::strcmp(value, "json") == 0;
+			}
+			else if (std::strcmp(argument, "--filter") == 0)
+			{
+				settings.filter = value;
+			}
+			else if (std::strcmp(argument, "--rates") == 0)
+			{
+				settings.sampleRates = parseIntList(value);
+			}
+			else if (std::strcmp(argument, "--signals") == 0)
+			{
+				settings.signals = parseSignalList(value);
+			}
+			else if (std::strcmp(argument, "--seconds") == 0)
+			{
+				settings.seconds = static_cast<float>(std::atof(value));
+			}
+			else if (std::strcmp(argument, "--block") == 0)
+			{
+				settings.blockSize = std::max(1, std::atoi(value));
+			}
+			else if (std::strcmp(argument, "--repeats") == 0)
+			{
+				settings.repeats = std::max(1, std::atoi(value));
+			}
+			else
+			{
+				printUsage();
+				return 1;
+			}
+
+			i++;
+		}
+	}
+
+	if (check)
+	{
+		return checkOversamplingLatency() ? 0 : 1;
+	}
+
+	auto cases = Benchmark::createCases();
+
+	if (listOnly)
+	{
+		for (const auto& benchmarkCase : cases)
+		{
+			std::printf("%s,%s\n", benchmarkCase.group.c_str(), benchmarkCase.name.c_str());
+		}
+
+		return 0;
+	}
+
+	Benchmark::Runner runner(settings);
+	std::vector<Benchmark::Result> results;
+
+	if (!json)
+	{
+		Benchmark::printCSVHeader(stdout);
+	}
+
+	for (auto& benchmarkCase : cases)
+	{
+		const std::string fullName = benchmarkCase.group + "/" + benchmarkCase.name;
+		if (!settings.filter.empty() && fullName.find(settings.filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		for (const int sampleRate : settings.sampleRates)
+		{
+			for (const auto signal : settings.signals)
+			{
+				const auto result = runner.run(benchmarkCase, sampleRate, signal);
+
+				if (json)
+				{
+					results.push_back(result);
+				}
+				else
+				{
+					Benchmark::printCSV(stdout, result);
+					std::fflush(stdout);
+				}
+			}
+		}
+	}
+
+	if (json)
+	{
+		Benchmark::printJSON(stdout, results);
+	}
+
+	return 0;
+}
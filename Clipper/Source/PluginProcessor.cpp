@@ -108,16 +108,12 @@ void ClipperAudioProcessor::changeProgramName (int index, const juce::String& ne
 void ClipperAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
 	// Initialize  oversampling
-	oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
-		getTotalNumOutputChannels(),					// number of channels
-		OVERSAMPLING_FACTOR,							// oversampling factor. E.g.2^4 = 16x
-		juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
-		true);											// use interpolation for better quality
-
-	oversampler->reset();
-	oversampler->initProcessing(samplesPerBlock);
+	for (int channel = 0; channel < N_CHANNELS; channel++)
+	{
+		m_oversampling[channel].init((int)sampleRate, OVERSAMPLING_MULTIPLIER, samplesPerBlock, Oversampling::Phase::Minimum);
+	}
 
-	setLatencySamples((int)oversampler->getLatencyInSamples());
+	setLatencySamples(m_oversampling[0].getLatencyInSamples());
 }
 
 void ClipperAudioProcessor::releaseResources()
@@ -175,18 +171,28 @@ void ClipperAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce
 
 	if (oversample)
 	{
-		// Upsample
-		juce::dsp::AudioBlock<float> block(buffer);
-		auto oversampledBlock = oversampler->processSamplesUp(block);
-
 		for (int channel = 0; channel < channels; channel++)
 		{
-			const Clippers::Params params{ threshold, wet, oversampledBlock.getChannelPointer(channel), oversampledBlock.getNumSamples() };
-			clip(params, type, channel, (int)getSampleRate() * OVERSAMPLING_MULTIPLIER);
-		}
+			auto& oversampling = m_oversampling[channel];
+			auto* channelBuffer = buffer.getWritePointer(channel);
+
+			// Host can send larger block than announced, process in chunks
+			const int maxSamples = oversampling.getMaxSamples();
 
-		// Downsample
-		oversampler->processSamplesDown(block);
+			for (int start = 0; start < samples; start += maxSamples)
+			{
+				const int chunk = std::min(maxSamples, samples - start);
+
+				// Upsample
+				oversampling.oversample(channelBuffer + start, chunk);
+
+				const Clippers::Params params{ threshold, wet, oversampling.getOversampeBuffer(), (unsigned int)oversampling.getOversampeBufferSize() };
+				clip(params, type, channel, (int)getSampleRate() * OVERSAMPLING_MULTIPLIER);
+
+				// Downsample
+				oversampling.downsample(channelBuffer + start, chunk);
+			}
+		}
 
 		// Post clip
 		if (postClip)
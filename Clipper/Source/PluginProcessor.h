@@ -137,7 +137,7 @@ private:
 	}
 
 	//==============================================================================	
-	std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+	Oversampling m_oversampling[N_CHANNELS];
 	
 	SlopeClipper m_slopeClipper[N_CHANNELS];
 
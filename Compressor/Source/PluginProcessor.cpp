@@ -20,6 +20,52 @@
 			channelBuffer[sample] = dry * in + wet * out; \
 		} \
 
+//==============================================================================
+template <CompressorDetector Detector, CompressorEnvelope Envelope>
+static void processCompressor(Compressor<>& compressor, float* channelBuffer, const int samples, const float gain, const float dry, const float wet)
+{
+	for (int sample = 0; sample < samples; sample++)
+	{
+		const float in = channelBuffer[sample];
+		const float out = compressor.processHardKnee<Detector, Envelope>(in * gain);
+		channelBuffer[sample] = dry * in + wet * out;
+	}
+}
+
+template <CompressorDetector Detector>
+static void processCompressor(Compressor<>& compressor, const CompressorEnvelope envelope, float* channelBuffer, const int samples, const float gain, const float dry, const float wet)
+{
+	switch (envelope)
+	{
+	case CompressorEnvelope::Lin:
+		processCompressor<Detector, CompressorEnvelope::Lin>(compressor, channelBuffer, samples, gain, dry, wet);
+		break;
+	case CompressorEnvelope::Log:
+		processCompressor<Detector, CompressorEnvelope::Log>(compressor, channelBuffer, samples, gain, dry, wet);
+		break;
+	default:
+		processCompressor<Detector, CompressorEnvelope::Blend>(compressor, channelBuffer, samples, gain, dry, wet);
+		break;
+	}
+}
+
+// Dispatches to instantiation specialized for detector and envelope domain
+static void processCompressor(Compressor<>& compressor, const CompressorDetector detector, const CompressorEnvelope envelope, float* channelBuffer, const int samples, const float gain, const float dry, const float wet)
+{
+	switch (detector)
+	{
+	case CompressorDetector::Peak:
+		processCompressor<CompressorDetector::Peak>(compressor, envelope, channelBuffer, samples, gain, dry, wet);
+		break;
+	case CompressorDetector::RMS:
+		processCompressor<CompressorDetector::RMS>(compressor, envelope, channelBuffer, samples, gain, dry, wet);
+		break;
+	default:
+		processCompressor<CompressorDetector::Blend>(compressor, envelope, channelBuffer, samples, gain, dry, wet);
+		break;
+	}
+}
+
 //==============================================================================
 
 const std::string CompressorAudioProcessor::paramsNames[] = { "Type", "Gain", "Attack", "Release", "Ratio", "Peak/RMS", "Log/Lin", "Mix", "Volume" };
@@ -175,6 +221,8 @@ void CompressorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
 	const auto logRatio = 1.0f - (0.01f * linParameter->load());
 	const auto mix = 0.01f * mixParameter->load();
 	const auto volume = juce::Decibels::decibelsToGain(volumeParameter->load());
+	const auto detector = getCompressorDetector(peakRatio);
+	const auto envelope = getCompressorEnvelope(logRatio);
 
 	// Mics constants
 	const auto channels = getTotalNumOutputChannels();
@@ -189,7 +237,10 @@ void CompressorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
 
 		if (type == 1)
 		{
-			PROCESS_COMPRESSOR(m_compressor)
+			auto& compressor = m_compressor[channel];
+			compressor.set(-20.0f, ratio, 0.0f, attack, release, peakRatio, logRatio);
+			compressor.setMode(detector, envelope);
+			processCompressor(compressor, detector, envelope, channelBuffer, samples, gain, dry, wet);
 		}
 		else if (type == 2)
 		{
@@ -219,11 +219,19 @@ void EarlyRefections1AudioProcessor::processBlock (juce::AudioBuffer<float>& buf
 
 		// Channel pointer
 		auto* channelBuffer = buffer.getWritePointer(channel);
+		float wetBuffer[EarlyReflections::BLOCK_SIZE];
 
-		for (unsigned int sample = 0u; sample < samples; sample++)
+		for (int start = 0; start < samples; start += EarlyReflections::BLOCK_SIZE)
 		{
-			float& in = channelBuffer[sample];
-			in = dry * in + wet * earlyReflections.process(in);
+			const int count = std::min(EarlyReflections::BLOCK_SIZE, samples - start);
+			float* block = channelBuffer + start;
+
+			earlyReflections.processBlock(block, wetBuffer, count);
+
+			for (int sample = 0; sample < count; sample++)
+			{
+				block[sample] = dry * block[sample] + wet * wetBuffer[sample];
+			}
 		}
 	}
 }
@@ -45,25 +45,7 @@ FDNReverbAudioProcessor::FDNReverbAudioProcessor()
                        )
 #endif
 {
-	// Early reflections
-	LParameter = apvts.getRawParameterValue(paramsNames[0]);
-	WParameter = apvts.getRawParameterValue(paramsNames[1]);
-	HParameter = apvts.getRawParameterValue(paramsNames[2]);
-	ReflectionsParameter = apvts.getRawParameterValue(paramsNames[3]);
-	ERDampingParameter = apvts.getRawParameterValue(paramsNames[4]);
-	ERWidthParameter = apvts.getRawParameterValue(paramsNames[5]);
-	// Late reflections
-	LRPredelayParameter = apvts.getRawParameterValue(paramsNames[6]);
-	timeParameter = apvts.getRawParameterValue(paramsNames[7]);
-	sizeParameter = apvts.getRawParameterValue(paramsNames[8]);
-	colorParameter = apvts.getRawParameterValue(paramsNames[9]);
-	LRDampingParameter = apvts.getRawParameterValue(paramsNames[10]);
-	LRWidthParameter = apvts.getRawParameterValue(paramsNames[11]);
-	// Mix
-	ERVolumeParameter = apvts.getRawParameterValue(paramsNames[12]);
-	LRVolumeParameter = apvts.getRawParameterValue(paramsNames[13]);
-	mixParameter = apvts.getRawParameterValue(paramsNames[14]);
-	volumeParameter = apvts.getRawParameterValue(paramsNames[15]);
+	m_parameters.init(apvts, paramsNames);
 }
 
 FDNReverbAudioProcessor::~FDNReverbAudioProcessor()
@@ -154,17 +136,40 @@ void FDNReverbAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBl
 		m_highPass[channel].init(sr);
 
 		// Late reflections
+		int maximumSizes[DELAY_LINES_COUNT];
+		for (int delayLine = 0; delayLine < DELAY_LINES_COUNT; delayLine++)
+		{
+			maximumSizes[delayLine] = (int)(maximumLRSize * LATE_REFLECTION_DELAY_TIME_NORMALIZED[delayLine]);
+		}
+
+		auto& lateReflections = m_lateReflections[channel];
+		lateReflections.init(sr, maximumSizes);
+
 		for (int delayLine = 0; delayLine < DELAY_LINES_COUNT; delayLine++)
 		{
-			m_bufferLR[channel][delayLine].init((int)(maximumLRSize * LATE_REFLECTION_DELAY_TIME_NORMALIZED[delayLine]));
-			m_filterLR[channel][delayLine].init(sr);
+			constexpr auto a = 10.0f;
+			lateReflections.setInputGain(delayLine, a / (getDelayLineDistance(delayLine) + a));
+		}
+
+		// Mix
+		for (auto& gainSmoother : m_gainSmoother[channel])
+		{
+			gainSmoother.init(sr);
+			gainSmoother.set(GAIN_SMOOTHING_FREQUENCY);
 		}
 	}
+
+	// Everything is rebuilt for the new sample rate
+	m_parameters.invalidate();
 }
 
 void FDNReverbAudioProcessor::releaseResources()
 {
-	
+	for (int channel = 0; channel < 2; channel++)
+	{
+		m_predelay[channel].release();
+		m_lateReflections[channel].release();
+	}
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -195,91 +200,62 @@ bool FDNReverbAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts
 
 void FDNReverbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-	// Get params
-	Params params
-	(
-		// Early reflections
-		LParameter->load(),
-		WParameter->load(),
-		HParameter->load(),
-		ReflectionsParameter->load(),
-		ERDampingParameter->load(),
-		ERWidthParameter->load(),
-		// Late reflections
-		LRPredelayParameter->load(),
-		timeParameter->load(),
-		sizeParameter->load(),
-		LRDampingParameter->load(),
-		colorParameter->load(),
-		LRWidthParameter->load(),
-		// Mix
-		juce::Decibels::decibelsToGain(ERVolumeParameter->load()),
-		juce::Decibels::decibelsToGain(LRVolumeParameter->load()),
-		mixParameter->load(),
-		juce::Decibels::decibelsToGain(volumeParameter->load())
-	);
-
-	// TODO: Do not update if params did not change
-	OnParamsChanged(params);
+	updateParameters();
 
 	// Mics constants
-	const auto mixInverse = 1.0f - params.mix;
 	const auto channels = getTotalNumOutputChannels();
 	const auto samples = buffer.getNumSamples();
-	const auto feedback = fminf(0.97f, m_feedback);
-	const auto shelfFilterGain = params.color * 4.5f;
+
+	const auto volume = juce::Decibels::decibelsToGain(m_parameters.get(Parameters::Volume));
+	const auto mix = 0.01f * m_parameters.get(Parameters::Mix);
+	const float gains[3] = { volume * (1.0f - mix),
+							 volume * mix * juce::Decibels::decibelsToGain(m_parameters.get(Parameters::ERVolume)),
+							 volume * mix * juce::Decibels::decibelsToGain(m_parameters.get(Parameters::LRVolume)) };
 
 	// Process buffer
 	for (int channel = 0; channel < channels; ++channel)
 	{
 		// Channel pointer
 		auto* channelBuffer = buffer.getWritePointer(channel);
-		auto& bufferLR = m_bufferLR[channel];
-		auto& filterLF = m_filterLR[channel];
+		auto& lateReflections = m_lateReflections[channel];
 		auto& lowShelf = m_lowShelf[channel];
 		auto& highShelf = m_highShelf[channel];
 		auto& highPass = m_highPass[channel];
-		auto& gainsLR = m_gainsLR[channel];
 		auto& earlyReflections = m_earlyReflections[channel];
 		auto& predelay = m_predelay[channel];
+		auto& gainSmoother = m_gainSmoother[channel];
 
-		lowShelf.setLowShelf(660.0f, 0.4f, -shelfFilterGain);
-		highShelf.setHighShelf(660.0f, 0.4f, shelfFilterGain);
-		highPass.setHighPass(40.0f * (2.0f + params.color), 0.6f);
+		constexpr int blockSize = 64;
+		float er[blockSize];
+		float lr[blockSize];
 
-		for (int sample = 0; sample < samples; sample++)
+		for (int start = 0; start < samples; start += blockSize)
 		{
-			const float in = channelBuffer[sample];
+			const int count = std::min(blockSize, samples - start);
+			float* block = channelBuffer + start;
 
 			// Early reflections
-			float er = earlyReflections.process(in);
+			earlyReflections.process(block, er, count);
 
-			// Late reflections
-			// Add color
-			predelay.writeSample(in);
-			const float inColorDelayed = highPass.processDF1(lowShelf.processDF1(highShelf.processDF1(predelay.read())));
-
-			float lr = 0.0f;
-			for (int i = 0; i < DELAY_LINES_COUNT; i++)
+			for (int sample = 0; sample < count; sample++)
 			{
-				m_tmp[i] = bufferLR[i].read();
-
-				// Filter
-				m_tmp[i] = filterLF[i].process(m_tmp[i]);
+				const float in = block[sample];
 
-				lr += m_tmp[i];
+				// Late reflections
+				// Add color
+				predelay.write(in);
+				lr[sample] = highPass.processDF1(lowShelf.processDF1(highShelf.processDF1(predelay.read())));
 			}
 
-			// FWHT
-			FWHT(m_tmp);
+			lateReflections.process(lr, lr, count);
 
-			// Writte sample
-			for (int i = 0; i < DELAY_LINES_COUNT; i++)
+			for (int sample = 0; sample < count; sample++)
 			{
-				bufferLR[i].writeSample(gainsLR[i] * inColorDelayed + feedback * m_tmp[i]);
+				const float in = block[sample];
+				block[sample] = gainSmoother[0].process(gains[0]) * in +
+								gainSmoother[1].process(gains[1]) * er[sample] +
+								gainSmoother[2].process(gains[2]) * lr[sample];
 			}
-			
-			channelBuffer[sample] = params.volume * (mixInverse * in + params.mix * (params.ERvolume * er + params.LRvolume * lr));
 		}
 	}
 }
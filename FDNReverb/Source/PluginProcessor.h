@@ -4,7 +4,10 @@
 #include "../../../zazzVSTPlugins/Shared/Utilities/CircularBuffers.h"
 #include "../../../zazzVSTPlugins/Shared/Utilities/Math3D.h"
 #include "../../../zazzVSTPlugins/Shared/Reverbs/EarlyReflections.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/FibonacciSphereEarlyReflections.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/FeedbackDelayNetwork.h"
 #include "../../../zazzVSTPlugins/Shared/Filters/OnePoleFilters.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/ParameterSnapshot.h"
 
 #include <vector>
 #include <cmath>
@@ -24,6 +27,27 @@ public:
     FDNReverbAudioProcessor();
     ~FDNReverbAudioProcessor() override;
 
+	enum Parameters
+	{
+		Length,
+		Width,
+		Height,
+		Echoes,
+		ERDamping,
+		ERWidth,
+		Predelay,
+		Time,
+		Size,
+		Color,
+		LRDamping,
+		LRWidth,
+		ERVolume,
+		LRVolume,
+		Mix,
+		Volume,
+		COUNT
+	};
+
 	static const std::string paramsNames[];
 	static const std::string paramsUnitNames[];
 	static const float LATE_REFLECTION_DELAY_TIME_NORMALIZED[];
@@ -33,6 +57,7 @@ public:
 	static const int DELAY_LINES_COUNT = 16;
 	static const int MAXIMUM_REFLECTIONS_COUNT = 32;
 	static constexpr float MAXIMUM_PREDELAY_MS = 50;
+	static constexpr float GAIN_SMOOTHING_FREQUENCY = 10.0f;
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
@@ -90,173 +115,132 @@ private:
 		}
 	}
 
-	//==============================================================================
-	// Input size must be a power of 2.
-	void FWHT(float (&data)[DELAY_LINES_COUNT])
-	{
-		int h = 1;
-
-		// Iterative Fast Walsh-Hadamard Transform
-		while (h < DELAY_LINES_COUNT)
-		{
-			for (int i = 0; i < DELAY_LINES_COUNT; i += h * 2)
-			{
-				for (int j = i; j < i + h; ++j)
-				{
-					float x = data[j];
-					float y = data[j + h];
-					data[j] = x + y;
-					data[j + h] = x - y;
-				}
-			}
-
-			// Normalize by sqrt(2) at each step
-			for (int i = 0; i < DELAY_LINES_COUNT; ++i)
-			{
-				data[i] *= 0.707f;
-			}
-
-			h *= 2;
-		}
-	}
-	
-	struct Params
-	{
-		// Default constructor
-		Params()
-			: L(0.0f), W(0.0f), H(0.0f),
-			reflections(0.0f), ERDamping(0.0f), ERWidth(0.0f),
-			LRPredelay(0.0f), time(0.0f), size(0.0f),
-			LRDamping(0.0f), color(0.0f), LRWidth(0.0f),
-			ERvolume(0.0f), LRvolume(0.0f), mix(0.0f), volume(0.0f)
-		{}
-
-		// Parameterized constructor
-		Params(float l, float w, float h,
-			float reflections, float erDamping, float erWidth,
-			float lrPredelay, float time, float size,
-			float lrDamping, float color, float lrWidth,
-			float erVolume, float lrVolume, float mix, float volume)
-			: L(l), W(w), H(h),
-			reflections(reflections), ERDamping(0.01f * erDamping), ERWidth(0.01f * erWidth),
-			LRPredelay(lrPredelay), time(time), size(size),
-			LRDamping(0.01f * lrDamping), color(color), LRWidth(0.01f * lrWidth),
-			ERvolume(erVolume), LRvolume(lrVolume), mix(0.01f * mix), volume(volume) {}
-
-		float L, W, H;         // Dimensions
-		float reflections;
-		float ERDamping;
-		float ERWidth;
-		float LRPredelay;
-		float time;            // Reverb time parameter [s]
-		float size;                 
-		float LRDamping;       // Damping parameter
-		float color;           // Color parameter
-		float LRWidth;          // Width parameter
-		float ERvolume;
-		float LRvolume;
-		float mix;             // Mix parameter
-		float volume;          // Volume parameter
-	};
-
 	FibonacciSphereEarlyReflections m_earlyReflections[2];
 
-	CircularBuffer m_bufferLR[2][DELAY_LINES_COUNT];
+	FeedbackDelayNetwork<DELAY_LINES_COUNT> m_lateReflections[2];
 	CircularBuffer m_predelay[2];
-	OnePoleLowPassFilter m_filterLR[2][DELAY_LINES_COUNT];
 	BiquadFilter m_highPass[2];
 	BiquadFilter m_lowShelf[2];
 	BiquadFilter m_highShelf[2];
 
-	float m_gainsLR[2][DELAY_LINES_COUNT];
-	float m_tmp[DELAY_LINES_COUNT];
-	
-	Params m_Params;
-
-	// Early reflections
-	std::atomic<float>* LParameter = nullptr;
-	std::atomic<float>* WParameter = nullptr;
-	std::atomic<float>* HParameter = nullptr;
-	std::atomic<float>* ReflectionsParameter = nullptr;
-	std::atomic<float>* ERDampingParameter = nullptr;
-	std::atomic<float>* ERWidthParameter = nullptr;
-		
-	// Late reflections
-	std::atomic<float>* LRPredelayParameter = nullptr;
-	std::atomic<float>* timeParameter = nullptr;
-	std::atomic<float>* sizeParameter = nullptr;
-	std::atomic<float>* LRDampingParameter = nullptr;
-	std::atomic<float>* colorParameter = nullptr;
-	std::atomic<float>* LRWidthParameter = nullptr;
-	
-	// Mix
-	std::atomic<float>* ERVolumeParameter = nullptr;
-	std::atomic<float>* LRVolumeParameter = nullptr;
-	std::atomic<float>* mixParameter = nullptr;
-	std::atomic<float>* volumeParameter = nullptr;
-
-	float m_feedback;
+	// Dry, early and late reflections gains
+	OnePoleLowPassFilter m_gainSmoother[2][3];
+
+	ParameterSnapshot<Parameters::COUNT> m_parameters;
 
 	//==============================================================================
-	void OnParamsChanged(Params& params)
+	// Rebuilds only what depends on parameters changed since the last block
+	void updateParameters()
 	{
+		if (!m_parameters.update())
+		{
+			return;
+		}
+
 		const float sampleRate = (float)getSampleRate();
-		const float maximumLRSize = MAXIMUM_DELAY_TIME * sampleRate;
-		const float LRWidthFactor = 1.0f - (0.05f * params.LRWidth);
-		const float LRTimeFactor = 0.4f + 0.6f * params.size;
+		const float size = m_parameters.get(Parameters::Size);
+		const float LRTimeFactor = 0.4f + 0.6f * size;
 
-		const float sampleRateHalf = 0.5f * sampleRate;
-		float maximumFilterFrequency = (sampleRateHalf < 15000) ? sampleRateHalf : 15000.0f;
-		maximumFilterFrequency = remap(params.LRDamping, 0.0f, 1.0f, maximumFilterFrequency, 1000.0f);
+		// Early reflections tap tables
+		if (m_parameters.hasChanged({ Parameters::Length, Parameters::Width, Parameters::Height, Parameters::Echoes, Parameters::ERDamping, Parameters::ERWidth }))
+		{
+			const float width = m_parameters.get(Parameters::Width);
 
-		// Calculate listener position for left and right channels
-		Point3D listenerPosition[2];
+			// Calculate listener position for left and right channels
+			Point3D listenerPosition[2];
 
-		const float offsetY = 0.5f * params.W * params.ERWidth;
+			const float offsetY = 0.5f * width * 0.01f * m_parameters.get(Parameters::ERWidth);
 
-		listenerPosition[0].x = 0.5f;
-		listenerPosition[0].y = 0.5f - offsetY;
-		listenerPosition[0].z = 0.5f;
+			listenerPosition[0].x = 0.5f;
+			listenerPosition[0].y = 0.5f - offsetY;
+			listenerPosition[0].z = 0.5f;
 
-		listenerPosition[1].x = 0.5f;
-		listenerPosition[1].y = 0.5f + offsetY;
-		listenerPosition[1].z = 0.5f;
+			listenerPosition[1].x = 0.5f;
+			listenerPosition[1].y = 0.5f + offsetY;
+			listenerPosition[1].z = 0.5f;
 
-		for (int channel = 0; channel < 2; channel++)
-		{
-			Point3D listener;
+			for (int channel = 0; channel < 2; channel++)
+			{
+				m_earlyReflections[channel].set(m_parameters.get(Parameters::Length), width, m_parameters.get(Parameters::Height),
+												0.01f * m_parameters.get(Parameters::ERDamping), listenerPosition[channel], (int)m_parameters.get(Parameters::Echoes));
+			}
+		}
 
-			m_earlyReflections[channel].set(params.L, params.W, params.H, params.ERDamping, listenerPosition[channel], (int)params.reflections);
+		// Late reflections predelay
+		if (m_parameters.hasChanged(Parameters::Predelay))
+		{
+			for (auto& predelay : m_predelay)
+			{
+				predelay.set((int)(sampleRate * m_parameters.get(Parameters::Predelay) * 0.001f));
+			}
+		}
 
-			m_predelay[channel].setSize((int)((float)sampleRate * params.LRPredelay * 0.001f));
+		// Late reflections delay lines
+		if (m_parameters.hasChanged({ Parameters::Size, Parameters::LRWidth }))
+		{
+			const float maximumLRSize = MAXIMUM_DELAY_TIME * sampleRate;
+			const float LRWidthFactor = 1.0f - (0.05f * 0.01f * m_parameters.get(Parameters::LRWidth));
 
 			for (int delayLine = 0; delayLine < DELAY_LINES_COUNT; delayLine++)
 			{
-				// Late reflections
-				// Gain
-				constexpr auto a = 10.0f;
-				const float timeLR = MAXIMUM_DELAY_TIME * LATE_REFLECTION_DELAY_TIME_NORMALIZED[delayLine];
-				const float distanceLR = timeLR * SPEED_OF_SOUND;
-				m_gainsLR[channel][delayLine] = a / (distanceLR + a);
-				
+				const float delayLineSize = LRTimeFactor * maximumLRSize * LATE_REFLECTION_DELAY_TIME_NORMALIZED[delayLine];
+
 				//Width
-				if (channel == 0)
-				{
-					m_bufferLR[channel][delayLine].setSize((int)(LRTimeFactor * maximumLRSize * LATE_REFLECTION_DELAY_TIME_NORMALIZED[delayLine]));
-				}
-				else if (channel == 1)
+				m_lateReflections[0].setSize(delayLine, (int)delayLineSize);
+				m_lateReflections[1].setSize(delayLine, (int)(LRWidthFactor * delayLineSize));
+			}
+		}
+
+		// Late reflections damping
+		if (m_parameters.hasChanged(Parameters::LRDamping))
+		{
+			const float sampleRateHalf = 0.5f * sampleRate;
+			float maximumFilterFrequency = (sampleRateHalf < 15000) ? sampleRateHalf : 15000.0f;
+			maximumFilterFrequency = remap(0.01f * m_parameters.get(Parameters::LRDamping), 0.0f, 1.0f, maximumFilterFrequency, 1000.0f);
+
+			for (int delayLine = 0; delayLine < DELAY_LINES_COUNT; delayLine++)
+			{
+				const float distanceLR = getDelayLineDistance(delayLine);
+				const auto frequency = remap(distanceLR, 2.0f, 50.0f, maximumFilterFrequency, 500.0f);
+
+				for (auto& lateReflections : m_lateReflections)
 				{
-					m_bufferLR[channel][delayLine].setSize((int)(LRWidthFactor * LRTimeFactor * maximumLRSize * LATE_REFLECTION_DELAY_TIME_NORMALIZED[delayLine]));
+					lateReflections.setDampingFrequency(delayLine, frequency);
 				}
-				
-				// Damping filter
-				const auto frequency = remap(distanceLR, 2.0f, 50.0f, maximumFilterFrequency, 500.0f);
-				m_filterLR[channel][delayLine].set(frequency);
 			}
 		}
 
-		const float averageDelayTime = LRTimeFactor * AVERAGE_DELAY_TIME;
-		m_feedback = std::expf((-6.9078f * averageDelayTime * MAXIMUM_DELAY_TIME) / params.time);
+		// Late reflections feedback
+		if (m_parameters.hasChanged({ Parameters::Time, Parameters::Size }))
+		{
+			const float averageDelayTime = LRTimeFactor * AVERAGE_DELAY_TIME;
+			const float feedback = std::expf((-6.9078f * averageDelayTime * MAXIMUM_DELAY_TIME) / m_parameters.get(Parameters::Time));
+
+			for (auto& lateReflections : m_lateReflections)
+			{
+				lateReflections.setFeedback(fminf(0.97f, feedback));
+			}
+		}
+
+		// Color filters
+		if (m_parameters.hasChanged(Parameters::Color))
+		{
+			const float color = m_parameters.get(Parameters::Color);
+			const auto shelfFilterGain = color * 4.5f;
+
+			for (int channel = 0; channel < 2; channel++)
+			{
+				m_lowShelf[channel].setLowShelf(660.0f, 0.4f, -shelfFilterGain);
+				m_highShelf[channel].setHighShelf(660.0f, 0.4f, shelfFilterGain);
+				m_highPass[channel].setHighPass(40.0f * (2.0f + color), 0.6f);
+			}
+		}
+	}
+
+	float getDelayLineDistance(const int delayLine) const
+	{
+		const float timeLR = MAXIMUM_DELAY_TIME * LATE_REFLECTION_DELAY_TIME_NORMALIZED[delayLine];
+		return timeLR * SPEED_OF_SOUND;
 	}
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FDNReverbAudioProcessor)
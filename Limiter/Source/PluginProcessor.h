@@ -113,7 +113,7 @@ private:
 	//==============================================================================
 	std::array<Limiter, N_CHANNELS> m_dirtyLimiter;
 	std::array<Limiter2, N_CHANNELS> m_agressiveLimiter;
-	std::array<Limiter3, N_CHANNELS> m_cleanLimiter;
+	std::array<Limiter3<>, N_CHANNELS> m_cleanLimiter;
 	std::array<CircularBuffer, N_CHANNELS> m_circularBuffer;
 	std::array<InterSamplePeak, N_CHANNELS> m_interSamplePeak;
 	std::array<AdaptiveReleaseTime, N_CHANNELS> m_adaptiveReleaseTime;
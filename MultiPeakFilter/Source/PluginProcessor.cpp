@@ -124,12 +124,10 @@ void MultiPeakFilterAudioProcessor::prepareToPlay (double sampleRate, int sample
 {
 	const int sr = (int)sampleRate;
 
-	for (int channel = 0; channel < N_CHANNELS; channel++)
+	for (int filter = 0; filter < COUNT_MAX; filter++)
 	{
-		for (int filter = 0; filter < COUNT_MAX; filter++)
-		{
-			m_filter[channel][filter].init(sr);
-		}
+		m_filter[filter].init(sr);
+		m_filter[filter].reset();
 	}
 
 	// Filters for auuto gain init
@@ -138,29 +136,19 @@ void MultiPeakFilterAudioProcessor::prepareToPlay (double sampleRate, int sample
 		m_filterAutoGain[filter].init(sr);
 	}
 
-	m_frequencySmoother[0].init(sr);
-	m_frequencySmoother[1].init(sr);
-	m_qSmoother[0].init(sr);
-	m_qSmoother[1].init(sr);
-	m_gainSmoother[0].init(sr);
-	m_gainSmoother[1].init(sr);
-	m_volumeSmoother[0].init(sr);
-	m_volumeSmoother[1].init(sr);
+	m_frequencySmoother.init(sr);
+	m_qSmoother.init(sr);
+	m_gainSmoother.init(sr);
+	m_volumeSmoother.init(sr);
 
 	constexpr float frequency = 2.0f;
 
-	m_frequencySmoother[0].set(frequency);
-	m_frequencySmoother[1].set(frequency);
-	m_qSmoother[0].set(frequency);
-	m_qSmoother[1].set(frequency);
-	m_gainSmoother[0].set(frequency);
-	m_gainSmoother[1].set(frequency);
-	m_stepSmoother[0].set(frequency);
-	m_stepSmoother[1].set(frequency);
-	m_slopeSmoother[0].set(frequency);
-	m_slopeSmoother[1].set(frequency);
-	m_volumeSmoother[0].set(frequency);
-	m_volumeSmoother[1].set(frequency);
+	m_frequencySmoother.set(frequency);
+	m_qSmoother.set(frequency);
+	m_gainSmoother.set(frequency);
+	m_stepSmoother.set(frequency);
+	m_slopeSmoother.set(frequency);
+	m_volumeSmoother.set(frequency);
 
 	// Create noise and get RMS
 	LinearCongruentialRandom01 random01;
@@ -300,53 +288,55 @@ void MultiPeakFilterAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
 		gain *= autoGain;
 	}
 	
-	for (int channel = 0; channel < channels; channel++)
+	// Channels are lanes of one filter per band, they share parameters, smoothers and coefficients
+	const int lanes = std::min(channels, static_cast<int>(MultiLaneFilter::LANES));
+
+	float* channelBuffers[MultiLaneFilter::LANES] = {};
+	for (int channel = 0; channel < lanes; channel++)
 	{
-		// Channel pointer
-		auto* channelBuffer = buffer.getWritePointer(channel);
+		channelBuffers[channel] = buffer.getWritePointer(channel);
+	}
 
-		auto& frequencySmoother = m_frequencySmoother[channel];
-		auto& qSmoother = m_qSmoother[channel];
-		auto& gainSmoother = m_gainSmoother[channel];
-		auto& stepSmoother = m_stepSmoother[channel];
-		auto& slopeSmoother = m_slopeSmoother[channel];
-		auto& volumeSmoother = m_volumeSmoother[channel];
+	alignas(32) float frame[MultiLaneFilter::LANES] = {};
 
-		for (int sample = 0; sample < samples; sample++)
+	for (int sample = 0; sample < samples; sample++)
+	{
+		// Read
+		for (int channel = 0; channel < lanes; channel++)
 		{
-			// Read
-			float out = channelBuffer[sample];
+			frame[channel] = channelBuffers[channel][sample];
+		}
 
-			// Set filter
-			const auto frequencySmooth = frequencySmoother.process(frequency);
-			const auto qSmooth = qSmoother.process(q);
-			const auto gainSmooth = gainSmoother.process(filterGain);
-			const auto stepSmooth = stepSmoother.process(step);
-			const auto slopeSmooth = slopeSmoother.process(slope);
-			const auto volumeSmooth = volumeSmoother.process(gain);
+		// Set filter
+		const auto frequencySmooth = m_frequencySmoother.process(frequency);
+		const auto qSmooth = m_qSmoother.process(q);
+		const auto gainSmooth = m_gainSmoother.process(filterGain);
+		const auto stepSmooth = m_stepSmoother.process(step);
+		const auto slopeSmooth = m_slopeSmoother.process(slope);
+		const auto volumeSmooth = m_volumeSmoother.process(gain);
 
-			const auto gainStep = (1.0f - slopeSmooth) * (gainSmooth / (float)countLimited);
+		const auto gainStep = (1.0f - slopeSmooth) * (gainSmooth / (float)countLimited);
 
-			// Set filters
-			for (int i = 0; i <= countLimited; i++)
-			{
-				const float f = Math::shiftFrequency(frequencySmooth, i * stepSmooth);
-				const float g = gainSmooth + i * gainStep;
+		// Set filters
+		for (int i = 0; i <= countLimited; i++)
+		{
+			const float f = Math::shiftFrequency(frequencySmooth, i * stepSmooth);
+			const float g = gainSmooth + i * gainStep;
 
-				m_filter[channel][i].setPeak(f, qSmooth, g);
-				if (channel == 0)
-				{
-					m_filterAutoGain[i].setPeak(f, qSmooth, g);
-				}
+			// Coefficients are calculated once for all channels and auto gain
+			m_filterAutoGain[i].setPeak(f, qSmooth, g);
+			m_filter[i].setCoefficients(m_filterAutoGain[i].getCoefficients());
 
-				// Process
-				out = m_filter[channel][i].processDF2T(out);
-			}
-		
-			//Out
-			channelBuffer[sample] = volumeSmooth * out;
+			// Process
+			m_filter[i].process(frame);
 		}
-	}	
+
+		//Out
+		for (int channel = 0; channel < lanes; channel++)
+		{
+			channelBuffers[channel][sample] = volumeSmooth * frame[channel];
+		}
+	}
 }
 
 //==============================================================================
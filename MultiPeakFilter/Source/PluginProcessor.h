@@ -22,6 +22,7 @@
 #include <JuceHeader.h>
 
 #include "../../../zazzVSTPlugins/Shared/Filters/BiquadFilters.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/MultiLaneBiquadFilter.h"
 #include "../../../zazzVSTPlugins/Shared/Filters/OnePoleFilters.h"
 
 //==============================================================================
@@ -85,16 +86,19 @@ private:
 	//==============================================================================
 	float m_noise[NOISE_LENGTH] = {};
 	
-	BiquadFilter m_filter[N_CHANNELS][COUNT_MAX];
+	// One lane per channel
+	using MultiLaneFilter = MultiLaneBiquadFilter<4>;
+
+	MultiLaneFilter m_filter[COUNT_MAX];
 	BiquadFilter m_filterAutoGain[COUNT_MAX];
 
-	// Smoothers
-	OnePoleLowPassFilter m_frequencySmoother[N_CHANNELS];
-	OnePoleLowPassFilter m_qSmoother[N_CHANNELS];
-	OnePoleLowPassFilter m_gainSmoother[N_CHANNELS];
-	OnePoleLowPassFilter m_stepSmoother[N_CHANNELS];
-	OnePoleLowPassFilter m_slopeSmoother[N_CHANNELS];
-	OnePoleLowPassFilter m_volumeSmoother[N_CHANNELS];
+	// Smoothers, shared by all channels
+	OnePoleLowPassFilter m_frequencySmoother;
+	OnePoleLowPassFilter m_qSmoother;
+	OnePoleLowPassFilter m_gainSmoother;
+	OnePoleLowPassFilter m_stepSmoother;
+	OnePoleLowPassFilter m_slopeSmoother;
+	OnePoleLowPassFilter m_volumeSmoother;
 
 	//float m_noiseRMS = 0.0f;
 	float m_noisePeak = 0.0f;
@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+    Headless batch renderer for Shared/ DSP classes.
+
+    Streams every input file through named processor in fixed size blocks
+    and writes WAV file. Files are rendered in parallel, one per core.
+
+    Preset is JSON object, parameters are read from its "parameters" member
+    or from the object itself, e.g.
+      { "processor": "Compressor", "parameters": { "threshold": -24, "ratio": 4 } }
+
+    Usage:
+      OfflineRender [--processor name] [--preset preset.json] [--output directory]
+                    [--suffix _render] [--block 512] [--threads 0] [--tail 0]
+                    [--bits 24] [--list] input.wav ...
+
+  ==============================================================================
+*/
+
+#include "Renderer.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+	//==============================================================================
+	void printUsage()
+	{
+		std::fprintf(stderr, "Usage: OfflineRender [--processor name] [--preset preset.json] [--output directory]\n"
+							 "                     [--suffix _render] [--block 512] [--threads 0] [--tail 0]\n"
+							 "                     [--bits 24] [--list] input.wav ...\n");
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	OfflineRender::Settings settings;
+	std::string processorName;
+	juce::File presetFile;
+	std::vector<juce::File> files;
+	bool listOnly = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* argument = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+		if (std::strcmp(argument, "--list") == 0)
+		{
+			listOnly = true;
+		}
+		else if (std::strcmp(argument, "--help") == 0 || std::strcmp(argument, "-h") == 0)
+		{
+			printUsage();
+			return 0;
+		}
+		else if (std::strncmp(argument, "--", 2) != 0)
+		{
+			files.push_back(juce::File::getCurrentWorkingDirectory().getChildFile(argument));
+		}
+		else if (value == nullptr)
+		{
+			printUsage();
+			return 1;
+		}
+		else
+		{
+			if (std::strcmp(argument, "--processor") == 0)
+			{
+				processorName = value;
+			}
+			else if (std::strcmp(argument, "--preset") == 0)
+			{
+				presetFile = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+			}
+			else if (std::strcmp(argument, "--output") == 0)
+			{
+				settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+			}
+			else if (std::strcmp(argument, "--suffix") == 0)
+			{
+				settings.suffix = value;
+			}
+			else if (std::strcmp(argument, "--block") == 0)
+			{
+				settings.blockSize = std::max(1, std::atoi(value));
+			}
+			else if (std::strcmp(argument, "--threads") == 0)
+			{
+				settings.threads = std::max(0, std::atoi(value));
+			}
+			else if (std::strcmp(argument, "--tail") == 0)
+			{
+				settings.tailSeconds = std::max(0.0f, static_cast<float>(std::atof(value)));
+			}
+			else if (std::strcmp(argument, "--bits") == 0)
+			{
+				settings.bitsPerSample = std::atoi(value);
+			}
+			else
+			{
+				printUsage();
+				return 1;
+			}
+
+			i++;
+		}
+	}
+
+	const auto processors = OfflineRender::createProcessors();
+
+	if (listOnly)
+	{
+		for (const auto& processor : processors)
+		{
+			std::printf("%s: %s\n", processor.name.c_str(), processor.parameters.c_str());
+		}
+
+		return 0;
+	}
+
+	// Preset
+	juce::var preset;
+	if (presetFile != juce::File())
+	{
+		const auto result = juce::JSON::parse(presetFile.loadFileAsString(), preset);
+		if (result.failed() || !preset.isObject())
+		{
+			std::fprintf(stderr, "%s: invalid preset %s\n", presetFile.getFullPathName().toRawUTF8(), result.getErrorMessage().toRawUTF8());
+			return 1;
+		}
+
+		if (processorName.empty())
+		{
+			processorName = preset["processor"].toString().toStdString();
+		}
+
+		settings.parameters = preset.hasProperty("parameters") ? preset["parameters"] : preset;
+	}
+
+	const auto* processor = OfflineRender::findProcessor(processors, processorName);
+	if (processor == nullptr)
+	{
+		std::fprintf(stderr, "Unknown processor '%s', use --list\n", processorName.c_str());
+		return 1;
+	}
+
+	if (files.empty())
+	{
+		printUsage();
+		return 1;
+	}
+
+	if (settings.outputDirectory != juce::File() && settings.outputDirectory.createDirectory().failed())
+	{
+		std::fprintf(stderr, "Can not create %s\n", settings.outputDirectory.getFullPathName().toRawUTF8());
+		return 1;
+	}
+
+	juce::String error;
+	if (OfflineRender::findOutputCollision(files, settings, error))
+	{
+		std::fprintf(stderr, "%s\n", error.toRawUTF8());
+		return 1;
+	}
+
+	const int failed = OfflineRender::renderFiles(files, *processor, settings);
+
+	return failed == 0 ? 0 : 1;
+}
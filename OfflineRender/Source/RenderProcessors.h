@@ -0,0 +1,409 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../../../zazzVSTPlugins/Shared/Utilities/Platform.h"
+
+#include <JuceHeader.h>
+
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../../zazzVSTPlugins/Shared/Utilities/Math.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/Compressors.h"
+#include "../../../zazzVSTPlugins/Shared/NonLinearFilters/Clippers.h"
+#include "../../../zazzVSTPlugins/Shared/Filters/SpectrumMatch.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/SmallRoomReverb.h"
+
+namespace OfflineRender
+{
+	//==============================================================================
+	// One instance renders one file. prepare() is called once before the first block,
+	// process() gets every block with the same number of samples.
+	class Processor
+	{
+	public:
+		virtual ~Processor() = default;
+
+		virtual void prepare(const int sampleRate, const int channels, const int blockSize) = 0;
+		virtual void process(juce::AudioBuffer<float>& buffer, const int samples) = 0;
+	};
+
+	//==============================================================================
+	// Parameters are read from preset "parameters" object, or from preset itself if it has none.
+	// Missing parameters use plugin default values.
+	struct ProcessorInfo
+	{
+		std::string name;
+		std::string parameters;
+		std::function<std::unique_ptr<Processor>(const juce::var& parameters)> create;
+	};
+
+	//==============================================================================
+	inline float getParameter(const juce::var& parameters, const char* name, const float defaultValue)
+	{
+		const juce::var& value = parameters[name];
+		return value.isVoid() ? defaultValue : static_cast<float>(value);
+	}
+
+	inline juce::String getParameter(const juce::var& parameters, const char* name, const char* defaultValue)
+	{
+		const juce::var& value = parameters[name];
+		return value.isVoid() ? juce::String(defaultValue) : value.toString();
+	}
+
+	//==============================================================================
+	// Output = dry * in + wet * processed, then volume
+	inline void applyMixAndVolume(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& dryBuffer, const int samples, const float wet, const float volume)
+	{
+		const float dry = 1.0f - wet;
+
+		for (int channel = 0; channel < buffer.getNumChannels(); channel++)
+		{
+			auto* channelBuffer = buffer.getWritePointer(channel);
+			const auto* dryChannelBuffer = dryBuffer.getReadPointer(channel);
+
+			for (int sample = 0; sample < samples; sample++)
+			{
+				channelBuffer[sample] = volume * (dry * dryChannelBuffer[sample] + wet * channelBuffer[sample]);
+			}
+		}
+	}
+
+	//==============================================================================
+	class SmallRoomReverbProcessor : public Processor
+	{
+	public:
+		explicit SmallRoomReverbProcessor(const juce::var& parameters)
+		{
+			m_earlyReflectionsPredelay	= getParameter(parameters, "earlyReflectionsPredelay", 5.0f);
+			m_earlyReflectionsSize		= getParameter(parameters, "earlyReflectionsSize", 0.5f);
+			m_earlyReflectionsDamping	= getParameter(parameters, "earlyReflectionsDamping", 0.5f);
+			m_earlyReflectionsWidth		= getParameter(parameters, "earlyReflectionsWidth", 0.5f);
+			m_earlyReflectionsGain		= juce::Decibels::decibelsToGain(getParameter(parameters, "earlyReflectionsGain", 0.0f));
+			m_lateReflectionsPredelay	= getParameter(parameters, "lateReflectionsPredelay", 20.0f);
+			m_lateReflectionsSize		= getParameter(parameters, "lateReflectionsSize", 0.5f);
+			m_lateReflectionsDamping	= getParameter(parameters, "lateReflectionsDamping", 0.5f);
+			m_lateReflectionsWidth		= getParameter(parameters, "lateReflectionsWidth", 0.5f);
+			m_lateReflectionsGain		= juce::Decibels::decibelsToGain(getParameter(parameters, "lateReflectionsGain", 0.0f));
+			m_wet						= 0.01f * getParameter(parameters, "mix", 50.0f);
+			m_volume					= juce::Decibels::decibelsToGain(getParameter(parameters, "volume", 0.0f));
+		};
+
+		void prepare(const int sampleRate, const int channels, const int blockSize) override
+		{
+			// Channel selects reverb decorrelation, only 5 variations exist
+			constexpr int VARIATIONS = (int)std::size(SmallRoomReverb::ALLPASS_DELAY_WIDTH);
+
+			m_reverb = std::make_unique<SmallRoomReverb[]>(channels);
+			for (int channel = 0; channel < channels; channel++)
+			{
+				m_reverb[channel].init(sampleRate, channel % VARIATIONS);
+				m_reverb[channel].set(m_earlyReflectionsPredelay, m_earlyReflectionsSize, m_earlyReflectionsDamping, m_earlyReflectionsWidth, m_earlyReflectionsGain,
+									  m_lateReflectionsPredelay, m_lateReflectionsSize, m_lateReflectionsDamping, m_lateReflectionsWidth, m_lateReflectionsGain);
+			}
+
+			m_dryBuffer.setSize(channels, blockSize);
+		};
+
+		void process(juce::AudioBuffer<float>& buffer, const int samples) override
+		{
+			m_dryBuffer.makeCopyOf(buffer, true);
+
+			for (int channel = 0; channel < buffer.getNumChannels(); channel++)
+			{
+				auto& reverb = m_reverb[channel];
+				auto* channelBuffer = buffer.getWritePointer(channel);
+
+				for (int sample = 0; sample < samples; sample++)
+				{
+					channelBuffer[sample] = reverb.process(channelBuffer[sample]);
+				}
+			}
+
+			applyMixAndVolume(buffer, m_dryBuffer, samples, m_wet, m_volume);
+		};
+
+	private:
+		std::unique_ptr<SmallRoomReverb[]> m_reverb;
+		juce::AudioBuffer<float> m_dryBuffer;
+		float m_earlyReflectionsPredelay = 0.0f;
+		float m_earlyReflectionsSize = 0.0f;
+		float m_earlyReflectionsDamping = 0.0f;
+		float m_earlyReflectionsWidth = 0.0f;
+		float m_earlyReflectionsGain = 0.0f;
+		float m_lateReflectionsPredelay = 0.0f;
+		float m_lateReflectionsSize = 0.0f;
+		float m_lateReflectionsDamping = 0.0f;
+		float m_lateReflectionsWidth = 0.0f;
+		float m_lateReflectionsGain = 0.0f;
+		float m_wet = 0.0f;
+		float m_volume = 1.0f;
+	};
+
+	//==============================================================================
+	// Hard knee compressor, same parameters as Compressor plugin type 1
+	class CompressorProcessor : public Processor
+	{
+	public:
+		explicit CompressorProcessor(const juce::var& parameters)
+		{
+			m_threshold	= getParameter(parameters, "threshold", -20.0f);
+			m_gain		= juce::Decibels::decibelsToGain(getParameter(parameters, "gain", 0.0f));
+			m_attack	= getParameter(parameters, "attack", 2.0f);
+			m_release	= getParameter(parameters, "release", 100.0f);
+			m_ratio		= getParameter(parameters, "ratio", 4.0f);
+			m_peakRatio	= 0.01f * getParameter(parameters, "peak", 100.0f);
+			m_logRatio	= 0.01f * getParameter(parameters, "log", 100.0f);
+			m_wet		= 0.01f * getParameter(parameters, "mix", 100.0f);
+			m_volume	= juce::Decibels::decibelsToGain(getParameter(parameters, "volume", 0.0f));
+		};
+
+		void prepare(const int sampleRate, const int channels, const int blockSize) override
+		{
+			m_compressor = std::make_unique<Compressor<>[]>(channels);
+			for (int channel = 0; channel < channels; channel++)
+			{
+				m_compressor[channel].init(sampleRate);
+				m_compressor[channel].set(m_threshold, m_ratio, 0.0f, m_attack, m_release, m_peakRatio, m_logRatio);
+			}
+
+			m_dryBuffer.setSize(channels, blockSize);
+		};
+
+		void process(juce::AudioBuffer<float>& buffer, const int samples) override
+		{
+			const auto detector = getCompressorDetector(m_peakRatio);
+			const auto envelope = getCompressorEnvelope(m_logRatio);
+
+			m_dryBuffer.makeCopyOf(buffer, true);
+
+			for (int channel = 0; channel < buffer.getNumChannels(); channel++)
+			{
+				auto& compressor = m_compressor[channel];
+				auto* channelBuffer = buffer.getWritePointer(channel);
+
+				if (detector == CompressorDetector::Peak && envelope == CompressorEnvelope::Log)
+				{
+					processChannel<CompressorDetector::Peak, CompressorEnvelope::Log>(compressor, channelBuffer, samples);
+				}
+				else if (detector == CompressorDetector::Peak && envelope == CompressorEnvelope::Lin)
+				{
+					processChannel<CompressorDetector::Peak, CompressorEnvelope::Lin>(compressor, channelBuffer, samples);
+				}
+				else if (detector == CompressorDetector::RMS && envelope == CompressorEnvelope::Log)
+				{
+					processChannel<CompressorDetector::RMS, CompressorEnvelope::Log>(compressor, channelBuffer, samples);
+				}
+				else if (detector == CompressorDetector::RMS && envelope == CompressorEnvelope::Lin)
+				{
+					processChannel<CompressorDetector::RMS, CompressorEnvelope::Lin>(compressor, channelBuffer, samples);
+				}
+				else
+				{
+					processChannel<CompressorDetector::Blend, CompressorEnvelope::Blend>(compressor, channelBuffer, samples);
+				}
+			}
+
+			applyMixAndVolume(buffer, m_dryBuffer, samples, m_wet, m_volume);
+		};
+
+	private:
+		template <CompressorDetector Detector, CompressorEnvelope Envelope>
+		inline void processChannel(Compressor<>& compressor, float* channelBuffer, const int samples)
+		{
+			for (int sample = 0; sample < samples; sample++)
+			{
+				channelBuffer[sample] = compressor.processHardKnee<Detector, Envelope>(m_gain * channelBuffer[sample]);
+			}
+		};
+
+		std::unique_ptr<Compressor<>[]> m_compressor;
+		juce::AudioBuffer<float> m_dryBuffer;
+		float m_threshold = 0.0f;
+		float m_gain = 1.0f;
+		float m_attack = 0.0f;
+		float m_release = 0.0f;
+		float m_ratio = 1.0f;
+		float m_peakRatio = 1.0f;
+		float m_logRatio = 1.0f;
+		float m_wet = 1.0f;
+		float m_volume = 1.0f;
+	};
+
+	//==============================================================================
+	// Gains are target band levels in dB, detection is "TimeDomain" or "FrequencyDomain"
+	class SpectrumMatchProcessor : public Processor
+	{
+	public:
+		explicit SpectrumMatchProcessor(const juce::var& parameters)
+		{
+			const auto* gains = parameters["gains"].getArray();
+			const auto* mutes = parameters["mutes"].getArray();
+
+			m_params.m_attackTimeMS = getParameter(parameters, "attack", 100.0f);
+			m_params.m_releaseTimeMS = getParameter(parameters, "release", 500.0f);
+
+			for (int band = 0; band < SpectrumMatch::BANDS_COUNT; band++)
+			{
+				m_params.m_gains[band] = (gains != nullptr && band < gains->size()) ? static_cast<float>((*gains)[band]) : -18.0f;
+				m_params.m_mute[band] = (mutes != nullptr && band < mutes->size()) ? static_cast<bool>((*mutes)[band]) : false;
+			}
+
+			const bool frequencyDomain = getParameter(parameters, "detection", "TimeDomain") == "FrequencyDomain";
+			m_params.m_detectionType = frequencyDomain ? SpectrumMatch::FrequencyDomain : SpectrumMatch::TimeDomain;
+
+			m_wet = 0.01f * getParameter(parameters, "mix", 100.0f);
+			m_volume = juce::Decibels::decibelsToGain(getParameter(parameters, "volume", 0.0f));
+		};
+
+		void prepare(const int sampleRate, const int channels, const int blockSize) override
+		{
+			m_spectrumMatch = std::make_unique<SpectrumMatch[]>(channels);
+			for (int channel = 0; channel < channels; channel++)
+			{
+				m_spectrumMatch[channel].init(sampleRate);
+				m_spectrumMatch[channel].set(m_params);
+			}
+
+			m_dryBuffer.setSize(channels, blockSize);
+		};
+
+		void process(juce::AudioBuffer<float>& buffer, const int samples) override
+		{
+			m_dryBuffer.makeCopyOf(buffer, true);
+
+			for (int channel = 0; channel < buffer.getNumChannels(); channel++)
+			{
+				auto& spectrumMatch = m_spectrumMatch[channel];
+				auto* channelBuffer = buffer.getWritePointer(channel);
+
+				for (int sample = 0; sample < samples; sample++)
+				{
+					channelBuffer[sample] = spectrumMatch.process(channelBuffer[sample]);
+				}
+			}
+
+			applyMixAndVolume(buffer, m_dryBuffer, samples, m_wet, m_volume);
+		};
+
+	private:
+		std::unique_ptr<SpectrumMatch[]> m_spectrumMatch;
+		juce::AudioBuffer<float> m_dryBuffer;
+		SpectrumMatch::Params m_params{};
+		float m_wet = 1.0f;
+		float m_volume = 1.0f;
+	};
+
+	//==============================================================================
+	// Stateless block clippers, type is "Hard", "Soft", "HalfWave", "ABS" or "Crisp"
+	class ClippersProcessor : public Processor
+	{
+	public:
+		explicit ClippersProcessor(const juce::var& parameters)
+		{
+			const auto type = getParameter(parameters, "type", "Hard");
+
+			if (type == "Soft")
+			{
+				m_block = Clippers::SoftBlock;
+			}
+			else if (type == "HalfWave")
+			{
+				m_block = Clippers::HalfWaveBlock;
+			}
+			else if (type == "ABS")
+			{
+				m_block = Clippers::ABSBlock;
+			}
+			else if (type == "Crisp")
+			{
+				m_block = Clippers::CrispBlock;
+			}
+			else
+			{
+				m_block = Clippers::HardBlock;
+			}
+
+			m_threshold = juce::Decibels::decibelsToGain(getParameter(parameters, "threshold", 0.0f));
+			m_wet = 0.01f * getParameter(parameters, "mix", 100.0f);
+			m_volume = juce::Decibels::decibelsToGain(getParameter(parameters, "volume", 0.0f));
+		};
+
+		void prepare(const int, const int, const int) override
+		{
+		};
+
+		void process(juce::AudioBuffer<float>& buffer, const int samples) override
+		{
+			for (int channel = 0; channel < buffer.getNumChannels(); channel++)
+			{
+				const Clippers::Params params{ m_threshold, m_wet, buffer.getWritePointer(channel), (unsigned int)samples };
+				m_block(params);
+			}
+
+			buffer.applyGain(0, samples, m_volume);
+		};
+
+	private:
+		void (*m_block)(const Clippers::Params&) = Clippers::HardBlock;
+		float m_threshold = 1.0f;
+		float m_wet = 1.0f;
+		float m_volume = 1.0f;
+	};
+
+	//==============================================================================
+	template <typename Type>
+	inline ProcessorInfo makeProcessorInfo(const char* name, const char* parameters)
+	{
+		return { name, parameters, [](const juce::var& preset) -> std::unique_ptr<Processor> { return std::make_unique<Type>(preset); } };
+	}
+
+	inline std::vector<ProcessorInfo> createProcessors()
+	{
+		std::vector<ProcessorInfo> processors;
+
+		processors.push_back(makeProcessorInfo<SmallRoomReverbProcessor>("SmallRoomReverb",
+			"earlyReflections{Predelay,Size,Damping,Width,Gain}, lateReflections{Predelay,Size,Damping,Width,Gain}, mix, volume"));
+		processors.push_back(makeProcessorInfo<CompressorProcessor>("Compressor",
+			"threshold, gain, attack, release, ratio, peak, log, mix, volume"));
+		processors.push_back(makeProcessorInfo<SpectrumMatchProcessor>("SpectrumMatch",
+			"attack, release, gains[6], mutes[6], detection, mix, volume"));
+		processors.push_back(makeProcessorInfo<ClippersProcessor>("Clippers",
+			"type, threshold, mix, volume"));
+
+		return processors;
+	}
+
+	inline const ProcessorInfo* findProcessor(const std::vector<ProcessorInfo>& processors, const std::string& name)
+	{
+		for (const auto& processor : processors)
+		{
+			if (processor.name == name)
+			{
+				return &processor;
+			}
+		}
+
+		return nullptr;
+	}
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "RenderProcessors.h"
+
+namespace OfflineRender
+{
+	//==============================================================================
+	struct Settings
+	{
+		juce::var parameters;
+		juce::File outputDirectory;				// Empty = next to input file
+		std::string suffix = "_render";
+		int blockSize = 512;
+		int threads = 0;						// 0 = all cores
+		float tailSeconds = 0.0f;				// Silence processed after input end, for reverb tails
+		int bitsPerSample = 0;					// 0 = same as input
+	};
+
+	//==============================================================================
+	// Block size is rounded up to multiple of 4, SIMD block processors use aligned loads
+	inline int getBlockSize(const int blockSize)
+	{
+		return (std::max(4, blockSize) + 3) & ~3;
+	}
+
+	inline int getThreadsCount(const int threads, const int files)
+	{
+		const int available = threads > 0 ? threads : std::max(1, (int)std::thread::hardware_concurrency());
+		return std::max(1, std::min(available, files));
+	}
+
+	inline juce::File getOutputFile(const juce::File& input, const Settings& settings)
+	{
+		if (settings.outputDirectory != juce::File())
+		{
+			return settings.outputDirectory.getChildFile(input.getFileNameWithoutExtension() + ".wav");
+		}
+
+		return input.getSiblingFile(input.getFileNameWithoutExtension() + juce::String(settings.suffix) + ".wav");
+	}
+
+	// Inputs with the same file name map to the same file in the output directory,
+	// these have to be found before rendering starts, workers would overwrite each other
+	inline bool findOutputCollision(const std::vector<juce::File>& files, const Settings& settings, juce::String& error)
+	{
+		std::vector<std::pair<juce::File, int>> outputs;
+		outputs.reserve(files.size());
+
+		for (int i = 0; i < (int)files.size(); i++)
+		{
+			outputs.push_back({ getOutputFile(files[i], settings), i });
+		}
+
+		std::sort(outputs.begin(), outputs.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		for (size_t i = 1; i < outputs.size(); i++)
+		{
+			if (outputs[i].first == outputs[i - 1].first)
+			{
+				error = files[outputs[i - 1].second].getFullPathName() + " and " + files[outputs[i].second].getFullPathName() +
+						" would both be rendered to " + outputs[i].first.getFullPathName();
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	//==============================================================================
+	// Streams input through processor in fixed size blocks, only one block is held in memory.
+	// Last block is zero padded and processed whole, only valid samples are written.
+	// Output of a failed render is deleted.
+	inline bool renderFile(const juce::File& input, const juce::File& output, const ProcessorInfo& processorInfo, const Settings& settings, juce::String& error)
+	{
+		if (output == input)
+		{
+			error = "output would overwrite input";
+			return false;
+		}
+
+		juce::AudioFormatManager formatManager;
+		formatManager.registerBasicFormats();
+
+		std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(input));
+		if (reader == nullptr)
+		{
+			error = "can not read file";
+			return false;
+		}
+
+		const int channels = (int)reader->numChannels;
+		const int sampleRate = (int)reader->sampleRate;
+		const int bitsPerSample = settings.bitsPerSample > 0 ? settings.bitsPerSample : (int)reader->bitsPerSample;
+		const int blockSize = getBlockSize(settings.blockSize);
+		const juce::int64 inputLength = reader->lengthInSamples;
+		const juce::int64 outputLength = inputLength + (juce::int64)(settings.tailSeconds * (float)sampleRate);
+
+		output.deleteFile();
+		std::unique_ptr<juce::FileOutputStream> stream(output.createOutputStream());
+		if (stream == nullptr || stream->failedToOpen())
+		{
+			error = "can not create " + output.getFullPathName();
+			return false;
+		}
+
+		juce::WavAudioFormat wavFormat;
+		std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(), reader->sampleRate, (unsigned int)channels, bitsPerSample, {}, 0));
+		if (writer == nullptr)
+		{
+			stream.reset();
+			output.deleteFile();
+			error = "unsupported output format";
+			return false;
+		}
+
+		// Writer owns stream now
+		stream.release();
+
+		// Close the file before deleting it
+		auto fail = [&](const juce::String& message)
+		{
+			writer.reset();
+			output.deleteFile();
+			error = message;
+			return false;
+		};
+
+		auto processor = processorInfo.create(settings.parameters);
+		processor->prepare(sampleRate, channels, blockSize);
+
+		juce::AudioBuffer<float> buffer(channels, blockSize);
+
+		for (juce::int64 position = 0; position < outputLength; position += blockSize)
+		{
+			const int samples = (int)std::min((juce::int64)blockSize, outputLength - position);
+
+			// Reader fills samples past input end with zeros
+			if (position < inputLength)
+			{
+				if (!reader->read(&buffer, 0, blockSize, position, true, true))
+				{
+					return fail("read failed");
+				}
+			}
+			else
+			{
+				buffer.clear();
+			}
+
+			processor->process(buffer, blockSize);
+
+			if (!writer->writeFromAudioSampleBuffer(buffer, 0, samples))
+			{
+				return fail("write failed");
+			}
+		}
+
+		return true;
+	}
+
+	//==============================================================================
+	// Files are taken from shared index, so long files do not hold back a whole range of short ones.
+	// Every file gets its own processor instance. Returns number of failed files.
+	inline int renderFiles(const std::vector<juce::File>& files, const ProcessorInfo& processorInfo, const Settings& settings)
+	{
+		const int filesCount = (int)files.size();
+		const int threadsCount = getThreadsCount(settings.threads, filesCount);
+
+		std::atomic<int> next{ 0 };
+		std::atomic<int> failed{ 0 };
+		std::mutex printMutex;
+
+		auto worker = [&]()
+		{
+			for (int i = next.fetch_add(1); i < filesCount; i = next.fetch_add(1))
+			{
+				const auto& input = files[i];
+				const auto output = getOutputFile(input, settings);
+
+				const auto start = juce::Time::getMillisecondCounterHiRes();
+
+				juce::String error;
+				const bool success = renderFile(input, output, processorInfo, settings, error);
+
+				const auto time = 0.001 * (juce::Time::getMillisecondCounterHiRes() - start);
+
+				std::lock_guard<std::mutex> lock(printMutex);
+				if (success)
+				{
+					std::printf("%s -> %s (%.2f s)\n", input.getFullPathName().toRawUTF8(), output.getFullPathName().toRawUTF8(), time);
+				}
+				else
+				{
+					std::fprintf(stderr, "%s: %s\n", input.getFullPathName().toRawUTF8(), error.toRawUTF8());
+					failed++;
+				}
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (int thread = 1; thread < threadsCount; thread++)
+		{
+			threads.emplace_back(worker);
+		}
+
+		// Calling thread works too
+		worker();
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		return failed.load();
+	}
+}
@@ -126,8 +126,9 @@ void PitchTrackingEQAudioProcessor::prepareToPlay (double sampleRate, int sample
 {
 	const int sr = (int)sampleRate;
 
-	m_pitchDetection[0].init(sr);
-	m_pitchDetection[1].init(sr);
+	// Overlapped analysis, frequency is updated every hop
+	m_pitchDetection[0].init(sr, PitchDetection::FFT_ORDER, PITCH_DETECTION_HOP_SIZE);
+	m_pitchDetection[1].init(sr, PitchDetection::FFT_ORDER, PITCH_DETECTION_HOP_SIZE);
 	
 	m_smoother[0].init(sr);
 	m_smoother[1].init(sr);
@@ -41,6 +41,7 @@ public:
 	static const std::string labelNames[];
 	static const std::string paramsUnitNames[];
     static const int N_CHANNELS = 2;
+    static const int PITCH_DETECTION_HOP_SIZE = 512;
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
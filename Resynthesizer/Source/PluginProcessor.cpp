@@ -131,9 +131,12 @@ void ResynthesizerAudioProcessor::prepareToPlay (double sampleRate, int samplesP
 	
 	for (auto& noiseFilter : m_noiseFilters)
 	{
+		noiseFilter.release();
 		noiseFilter.init(sr);
 	}
 
+	m_controlBlockCounter = 0;
+
 	m_smoother.init(sr);
 	m_smoother.set(2.0f);
 }
@@ -282,21 +285,33 @@ void ResynthesizerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
 			// Channel pointer
 			auto* channelBuffer = buffer.getWritePointer(channel);
 
+			// Volumes are constant for the whole block
+			std::array<float, N_OSCILATORS> gains;
+			for (int i = 0; i < N_OSCILATORS; i++)
+			{
+				gains[i] = juce::Decibels::decibelsToGain(36.0f + parametersValues[volumeIdx + i]);
+			}
+
 			for (int sample = 0; sample < samples; sample++)
 			{
-				// Set filters
 				const float factorSmooth = m_smoother.process(parametersValues[Parameters::Factor]);
 
-				for (int i = 0; i < N_OSCILATORS; i++)
+				// Set filters once per control block, coefficients are ramped in between
+				if (m_controlBlockCounter == 0)
 				{
-					const float frequencyClamped = Math::clamp(factorSmooth * parametersValues[frequencyIdx + i], 20.0f, 16000.0f);
-					m_noiseFilters[i].setBandPassPeakGain(frequencyClamped, q);
+					for (int i = 0; i < N_OSCILATORS; i++)
+					{
+						const float frequencyClamped = Math::clamp(factorSmooth * parametersValues[frequencyIdx + i], 20.0f, 16000.0f);
+						m_noiseFilters[i].setSmoothed(BiquadFilter::Type::BandPassPeakGain, frequencyClamped, q, 0.0f, CONTROL_BLOCK_SIZE);
+					}
 				}
 
+				m_controlBlockCounter = (m_controlBlockCounter + 1) % CONTROL_BLOCK_SIZE;
+
 				float out = 0.0f;
 				for (int i = 0; i < N_OSCILATORS; i++)
 				{
-					out += juce::Decibels::decibelsToGain(36.0f + parametersValues[volumeIdx + i]) * m_noiseFilters[i].processDF1(m_noiseGenerators[0].process());
+					out += gains[i] * m_noiseFilters[i].processSmoothedDF1(m_noiseGenerators[0].process());
 				}
 
 				//Out
@@ -71,6 +71,7 @@ public:
 	static const std::string paramsUnitNames[];
     static const int N_CHANNELS = 2;
     static const int N_OSCILATORS = 8;
+	static const int CONTROL_BLOCK_SIZE = 32;
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
@@ -124,6 +125,7 @@ private:
 	std::vector<PitchDetectionMulti::Spectrum> m_spectrum;
 	juce::AudioParameterBool* m_learnButton;
 	bool m_learnButtonLast{ false };
+	int m_controlBlockCounter{ 0 };
 
 	OnePoleLowPassFilter m_smoother;
 
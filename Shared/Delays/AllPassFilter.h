@@ -36,12 +36,12 @@ public:
 
 	inline void set(const int size, const float feedback = 0.5f) noexcept
 	{
-		__super::set(size);
+		CircularBuffer::set(size);
 		m_feedback = feedback;
 	};
 	inline void setSize(const int size) noexcept
 	{
-		__super::set(size);
+		CircularBuffer::set(size);
 	};
 	inline void setFeedback(const float feedback) noexcept
 	{
@@ -49,7 +49,7 @@ public:
 	};
 	inline void release() noexcept
 	{
-		__super::release();
+		CircularBuffer::release();
 		
 		m_feedback = 0.5f;
 	}
@@ -57,12 +57,12 @@ public:
 
 	inline void init(const int size, const int sampleRate)
 	{
-		__super::init(size);
+		CombFilter::init(size);
 		m_filter.init(sampleRate);
 	};
 	inline void set(const int size, const float feedback, const float frequency)
 	{
-		__super::set(size, feedback);
+		CombFilter::set(size, feedback);
 		m_filter.set(frequency);
 	};
 	inline void setFrequency(const float frequency)
@@ -81,7 +81,7 @@ public:
 	};
 	inline void release()
 	{
-		__super::release();
+		CombFilter::release();
 		m_filter.release();
 	};
 
@@ -25,7 +25,7 @@ public:
 		m_postFilter.setBandPassPeakGain(frequency, 1.0f);
 
 		// Not sure this works correctly
-		m_decayFactor = std::expf(-6.9078f / (frequency * lenghtSeconds));
+		m_decayFactor = std::exp(-6.9078f / (frequency * lenghtSeconds));
 	};
 	inline float process(const float in)
 	{
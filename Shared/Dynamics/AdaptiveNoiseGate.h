@@ -41,7 +41,7 @@ public:
 	}
 	inline float process(float in)
 	{
-		const float envelopeIn = std::fabsf(in);
+		const float envelopeIn = std::fabs(in);
 		// Add 1e-6 to avoid division by 0. Envelope output is alway > 0
 		const float envelopeSlow = m_envelopeFollowerSlow.process(envelopeIn);
 		const float envelopeFast = m_envelopeFollowerFast.process(envelopeIn);
@@ -1,11 +1,14 @@
 #pragma once
 
+// Compiled on its own by the command line tools, no-op on MSVC
+#include "../Utilities/Platform.h"
 #include "Compressors.h"
 
 #include <JuceHeader.h>
 
 //==============================================================================
-float Compressor::processHardKneeLinPeak(float in)
+template <typename Conversion>
+float Compressor<Conversion>::processHardKneeLinPeak(float in)
 {	
 	// Smooth
 	const float smooth = m_envelopeFollowerLin.process(in);
@@ -17,13 +20,14 @@ float Compressor::processHardKneeLinPeak(float in)
 	}
 
 	//Get gain reduction, positive values
-	const float attenuatedB = (juce::Decibels::gainToDecibels(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+	const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
-float Compressor::processHardKneeLinRMS(float in)
+template <typename Conversion>
+float Compressor<Conversion>::processHardKneeLinRMS(float in)
 {	
 	// Get RMS
 	const float rms = RMS_FACTOR * m_RMS.process(in);
@@ -38,16 +42,17 @@ float Compressor::processHardKneeLinRMS(float in)
 	}
 
 	//Get gain reduction, positive values
-	const float attenuatedB = (juce::Decibels::gainToDecibels(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+	const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
-float Compressor::processHardKneeLogPeak(float in)
+template <typename Conversion>
+float Compressor<Conversion>::processHardKneeLogPeak(float in)
 {
 	// Convert input from gain to dB
-	const float indB = juce::Decibels::gainToDecibels(fabsf(in));
+	const float indB = Conversion::gainTodB(fabsf(in));
 
 	//Get gain reduction, positive values
 	const float attenuatedB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
@@ -56,16 +61,17 @@ float Compressor::processHardKneeLogPeak(float in)
 	const float attenuateSmoothdB = -m_envelopeFollowerLog.process(attenuatedB);
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuateSmoothdB);
+	return in * Conversion::dBToGain(attenuateSmoothdB);
 }
 
-float Compressor::processHardKneeLogRMS(float in)
+template <typename Conversion>
+float Compressor<Conversion>::processHardKneeLogRMS(float in)
 {
 	// Get RMS
 	const float rms = RMS_FACTOR * m_RMS.process(in);
 
 	// Convert input from gain to dB
-	const float indB = juce::Decibels::gainToDecibels(rms);
+	const float indB = Conversion::gainTodB(rms);
 
 	//Get gain reduction, positive values
 	const float attenuatedB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
@@ -74,10 +80,11 @@ float Compressor::processHardKneeLogRMS(float in)
 	const float attenuateSmoothdB = -m_envelopeFollowerLog.process(attenuatedB);
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuateSmoothdB);
+	return in * Conversion::dBToGain(attenuateSmoothdB);
 }
 
-float Compressor::processSoftKneeLinPeak(float in)
+template <typename Conversion>
+float Compressor<Conversion>::processSoftKneeLinPeak(float in)
 {
 	// Smooth
 	const float smooth = m_envelopeFollowerLin.process(in);
@@ -89,7 +96,7 @@ float Compressor::processSoftKneeLinPeak(float in)
 	}
 
 	// Convert input from gain to dB
-	const float smoothdB = Math::gainTodB(smooth);
+	const float smoothdB = Conversion::gainTodB(smooth);
 
 	//Get gain reduction, positive values
 	float attenuatedB = 0.0f;
@@ -105,11 +112,12 @@ float Compressor::processSoftKneeLinPeak(float in)
 	}
 
 	// Apply gain reduction
-	return in * Math::dBToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
 //==============================================================================
-float SlewCompressor::processHardKneeLinPeak(float in)
+template <typename Conversion>
+float SlewCompressor<Conversion>::processHardKneeLinPeak(float in)
 {	
 	// Smooth
 	const float smooth = m_envelopeFollowerLin.process(in);
@@ -121,13 +129,14 @@ float SlewCompressor::processHardKneeLinPeak(float in)
 	}
 
 	//Get gain reduction, positive values
-	const float attenuatedB = (juce::Decibels::gainToDecibels(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+	const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
-float SlewCompressor::processHardKneeLinRMS(float in)
+template <typename Conversion>
+float SlewCompressor<Conversion>::processHardKneeLinRMS(float in)
 {
 	// Get RMS
 	const float rms = RMS_FACTOR * m_RMS.process(in);
@@ -142,16 +151,17 @@ float SlewCompressor::processHardKneeLinRMS(float in)
 	}
 
 	//Get gain reduction, positive values
-	const float attenuatedB = (juce::Decibels::gainToDecibels(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+	const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
-float SlewCompressor::processHardKneeLogPeak(float in)
+template <typename Conversion>
+float SlewCompressor<Conversion>::processHardKneeLogPeak(float in)
 {
 	// Convert input from gain to dB
-	const float indB = juce::Decibels::gainToDecibels(fabsf(in));
+	const float indB = Conversion::gainTodB(fabsf(in));
 
 	//Get gain reduction, positive values
 	const float attenuatedB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
@@ -160,16 +170,17 @@ float SlewCompressor::processHardKneeLogPeak(float in)
 	const float attenuateSmoothdB = -m_envelopeFollowerLog.process(attenuatedB);
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuateSmoothdB);
+	return in * Conversion::dBToGain(attenuateSmoothdB);
 }
 
-float SlewCompressor::processHardKneeLogRMS(float in)
+template <typename Conversion>
+float SlewCompressor<Conversion>::processHardKneeLogRMS(float in)
 {
 	// Get RMS
 	const float rms = RMS_FACTOR * m_RMS.process(in);
 
 	// Convert input from gain to dB
-	const float indB = juce::Decibels::gainToDecibels(rms);
+	const float indB = Conversion::gainTodB(rms);
 
 	//Get gain reduction, positive values
 	const float attenuatedB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
@@ -178,10 +189,11 @@ float SlewCompressor::processHardKneeLogRMS(float in)
 	const float attenuateSmoothdB = -m_envelopeFollowerLog.process(attenuatedB);
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuateSmoothdB);
+	return in * Conversion::dBToGain(attenuateSmoothdB);
 }
 
-float SlewCompressor::processSoftKnee(float in)
+template <typename Conversion>
+float SlewCompressor<Conversion>::processSoftKnee(float in)
 {
 	// Smooth
 	const float smooth = m_envelopeFollowerLin.process(in);
@@ -193,7 +205,7 @@ float SlewCompressor::processSoftKnee(float in)
 	}
 
 	// Convert input from gain to dB
-	const float smoothdB = juce::Decibels::gainToDecibels(smooth);
+	const float smoothdB = Conversion::gainTodB(smooth);
 
 	//Get gain reduction, positive values
 	float attenuatedB = 0.0f;
@@ -209,11 +221,12 @@ float SlewCompressor::processSoftKnee(float in)
 	}
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
 //==============================================================================
-float OptoCompressor::processHardKneeLinPeak(float in)
+template <typename Conversion>
+float OptoCompressor<Conversion>::processHardKneeLinPeak(float in)
 {
 	// Smooth
 	const float smooth = m_envelopeFollowerLin.process(24.0f * in) / 24.0f;
@@ -225,13 +238,14 @@ float OptoCompressor::processHardKneeLinPeak(float in)
 	}
 
 	//Get gain reduction, positive values
-	const float attenuatedB = (juce::Decibels::gainToDecibels(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+	const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
-float OptoCompressor::processHardKneeLinRMS(float in)
+template <typename Conversion>
+float OptoCompressor<Conversion>::processHardKneeLinRMS(float in)
 {
 	// Get RMS
 	const float rms = RMS_FACTOR * m_RMS.process(in);
@@ -246,16 +260,17 @@ float OptoCompressor::processHardKneeLinRMS(float in)
 	}
 
 	//Get gain reduction, positive values
-	const float attenuatedB = (juce::Decibels::gainToDecibels(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+	const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
-float OptoCompressor::processHardKneeLogPeak(float in)
+template <typename Conversion>
+float OptoCompressor<Conversion>::processHardKneeLogPeak(float in)
 {
 	// Convert input from gain to dB
-	const float indB = juce::Decibels::gainToDecibels(fabsf(in));
+	const float indB = Conversion::gainTodB(fabsf(in));
 
 	//Get gain reduction, positive values
 	const float attenuatedB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
@@ -264,16 +279,17 @@ float OptoCompressor::processHardKneeLogPeak(float in)
 	const float attenuateSmoothdB = -m_envelopeFollowerLog.process(attenuatedB);
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuateSmoothdB);
+	return in * Conversion::dBToGain(attenuateSmoothdB);
 }
 
-float OptoCompressor::processHardKneeLogRMS(float in)
+template <typename Conversion>
+float OptoCompressor<Conversion>::processHardKneeLogRMS(float in)
 {
 	// Get RMS
 	const float rms = RMS_FACTOR * m_RMS.process(in);
 
 	// Convert input from gain to dB
-	const float indB = juce::Decibels::gainToDecibels(rms);
+	const float indB = Conversion::gainTodB(rms);
 
 	//Get gain reduction, positive values
 	const float attenuatedB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
@@ -282,10 +298,11 @@ float OptoCompressor::processHardKneeLogRMS(float in)
 	const float attenuateSmoothdB = -m_envelopeFollowerLog.process(attenuatedB);
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuateSmoothdB);
+	return in * Conversion::dBToGain(attenuateSmoothdB);
 }
 
-float OptoCompressor::processSoftKnee(float in)
+template <typename Conversion>
+float OptoCompressor<Conversion>::processSoftKnee(float in)
 {
 	// Smooth
 	const float smooth = m_envelopeFollowerLin.process(in);
@@ -297,7 +314,7 @@ float OptoCompressor::processSoftKnee(float in)
 	}
 
 	// Convert input from gain to dB
-	const float smoothdB = juce::Decibels::gainToDecibels(smooth);
+	const float smoothdB = Conversion::gainTodB(smooth);
 
 	//Get gain reduction, positive values
 	float attenuatedB = 0.0f;
@@ -313,11 +330,12 @@ float OptoCompressor::processSoftKnee(float in)
 	}
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
 //==============================================================================
-float DualCompressor::processHardKneeLinPeak(float in)
+template <typename Conversion>
+float DualCompressor<Conversion>::processHardKneeLinPeak(float in)
 {
 	// Smooth
 	const float smooth = m_envelopeFollowerLin.process(24.0f * in) / 24.0f;
@@ -329,13 +347,14 @@ float DualCompressor::processHardKneeLinPeak(float in)
 	}
 
 	//Get gain reduction, positive values
-	const float attenuatedB = (juce::Decibels::gainToDecibels(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+	const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
-float DualCompressor::processHardKneeLinRMS(float in)
+template <typename Conversion>
+float DualCompressor<Conversion>::processHardKneeLinRMS(float in)
 {
 	// Get RMS
 	const float rms = RMS_FACTOR * m_RMS.process(in);
@@ -350,16 +369,17 @@ float DualCompressor::processHardKneeLinRMS(float in)
 	}
 
 	//Get gain reduction, positive values
-	const float attenuatedB = (juce::Decibels::gainToDecibels(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+	const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
+	return in * Conversion::dBToGain(attenuatedB);
 }
 
-float DualCompressor::processHardKneeLogPeak(float in)
+template <typename Conversion>
+float DualCompressor<Conversion>::processHardKneeLogPeak(float in)
 {
 	// Convert input from gain to dB
-	const float indB = juce::Decibels::gainToDecibels(fabsf(in));
+	const float indB = Conversion::gainTodB(fabsf(in));
 
 	//Get gain reduction, positive values
 	const float attenuatedB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
@@ -368,16 +388,17 @@ float DualCompressor::processHardKneeLogPeak(float in)
 	const float attenuateSmoothdB = -m_envelopeFollowerLog.process(attenuatedB);
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuateSmoothdB);
+	return in * Conversion::dBToGain(attenuateSmoothdB);
 }
 
-float DualCompressor::processHardKneeLogRMS(float in)
+template <typename Conversion>
+float DualCompressor<Conversion>::processHardKneeLogRMS(float in)
 {
 	// Get RMS
 	const float rms = RMS_FACTOR * m_RMS.process(in);
 
 	// Convert input from gain to dB
-	const float indB = juce::Decibels::gainToDecibels(rms);
+	const float indB = Conversion::gainTodB(rms);
 
 	//Get gain reduction, positive values
 	const float attenuatedB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
@@ -386,10 +407,11 @@ float DualCompressor::processHardKneeLogRMS(float in)
 	const float attenuateSmoothdB = -m_envelopeFollowerLog.process(attenuatedB);
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuateSmoothdB);
+	return in * Conversion::dBToGain(attenuateSmoothdB);
 }
 
-float DualCompressor::processSoftKnee(float in)
+template <typename Conversion>
+float DualCompressor<Conversion>::processSoftKnee(float in)
 {
 	// Smooth
 	const float smooth = m_envelopeFollowerLin.process(in);
@@ -401,7 +423,7 @@ float DualCompressor::processSoftKnee(float in)
 	}
 
 	// Convert input from gain to dB
-	const float smoothdB = juce::Decibels::gainToDecibels(smooth);
+	const float smoothdB = Conversion::gainTodB(smooth);
 
 	//Get gain reduction, positive values
 	float attenuatedB = 0.0f;
@@ -417,5 +439,22 @@ float DualCompressor::processSoftKnee(float in)
 	}
 
 	// Apply gain reduction
-	return in * juce::Decibels::decibelsToGain(attenuatedB);
-}
\ No newline at end of file
+	return in * Conversion::dBToGain(attenuatedB);
+}
+//==============================================================================
+// Out of line methods are compiled here for every conversion policy
+template class Compressor<DecibelConversion::Exact>;
+template class Compressor<DecibelConversion::Approx>;
+template class Compressor<DecibelConversion::Table>;
+
+template class SlewCompressor<DecibelConversion::Exact>;
+template class SlewCompressor<DecibelConversion::Approx>;
+template class SlewCompressor<DecibelConversion::Table>;
+
+template class OptoCompressor<DecibelConversion::Exact>;
+template class OptoCompressor<DecibelConversion::Approx>;
+template class OptoCompressor<DecibelConversion::Table>;
+
+template class DualCompressor<DecibelConversion::Exact>;
+template class DualCompressor<DecibelConversion::Approx>;
+template class DualCompressor<DecibelConversion::Table>;
@@ -7,12 +7,43 @@
 #include "../../../zazzVSTPlugins/Shared/Utilities/Math.h"
 #include "../../../zazzVSTPlugins/Shared/Dynamics/RMS.h"
 #include "../../../zazzVSTPlugins/Shared/Utilities/ZeroCrossingRate.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/DecibelConversion.h"
 
 #include <JuceHeader.h>
 
 // Used to match ammount of compression when using RMS compared to peak detection
 #define RMS_FACTOR 1.5f
 
+// Compressors are templated on gain <-> dB conversion used per sample,
+// DecibelConversion::Exact, Approx or Table. Compressor<> uses Exact.
+
+//==============================================================================
+// Detector and envelope domain of Compressor::processHardKnee<Detector, Envelope>().
+// Blend mixes both by peakRatio / logRatio, pure modes skip the unused path.
+enum class CompressorDetector
+{
+	Peak,
+	RMS,
+	Blend
+};
+
+enum class CompressorEnvelope
+{
+	Lin,
+	Log,
+	Blend
+};
+
+inline CompressorDetector getCompressorDetector(const float peakRatio)
+{
+	return peakRatio >= 1.0f ? CompressorDetector::Peak : (peakRatio <= 0.0f ? CompressorDetector::RMS : CompressorDetector::Blend);
+}
+
+inline CompressorEnvelope getCompressorEnvelope(const float logRatio)
+{
+	return logRatio >= 1.0f ? CompressorEnvelope::Log : (logRatio <= 0.0f ? CompressorEnvelope::Lin : CompressorEnvelope::Blend);
+}
+
 //==============================================================================
 template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
 struct CompressorParams
@@ -53,6 +84,7 @@ public:
 };
 
 //==============================================================================
+template <typename Conversion = DecibelConversion::Exact>
 class Compressor
 {
 public:
@@ -80,28 +112,75 @@ public:
 		m_peakRatio = peakRatio;
 		m_logRatio = logRatio;
 	}
-	inline float processHardKnee(const float in)
+	// Call once per block before processHardKnee<Detector, Envelope>(). State the new mode does not
+	// update is reset, so it does not resume from stale values when a later mode uses it again.
+	inline void setMode(const CompressorDetector detector, const CompressorEnvelope envelope) noexcept
 	{
-		// Get combined peak/rms input
-		const float rms = RMS_FACTOR * m_RMS.process(in);
-		const float peak = Math::fabsf(in);
-		const float inCombined = m_peakRatio * (peak - rms) + rms;
+		if (detector == m_detector && envelope == m_envelope)
+		{
+			return;
+		}
 
-		// Get log attenuation
-		const float indB = juce::Decibels::gainToDecibels(inCombined);
-		const float envelopeIndB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
-		const float attenuateLogdB = -m_envelopeFollowerLog.process(envelopeIndB);
+		if (detector == CompressorDetector::Peak)
+		{
+			m_RMS.reset();
+		}
+		if (envelope == CompressorEnvelope::Lin)
+		{
+			m_envelopeFollowerLog.reset();
+		}
+		else if (envelope == CompressorEnvelope::Log)
+		{
+			m_envelopeFollowerLin.reset();
+		}
 
-		// Get lin attenuation
-		const float smoothLin = m_envelopeFollowerLin.process(inCombined);
-		const float attenuateLindB = smoothLin > m_params.m_threshold ? (juce::Decibels::gainToDecibels(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
+		m_detector = detector;
+		m_envelope = envelope;
+	};
+	inline float processHardKnee(const float in)
+	{
+		return processHardKnee<CompressorDetector::Blend, CompressorEnvelope::Blend>(in);
+	};
+	// RMS buffer and envelope follower not used by the mode are not updated
+	template <CompressorDetector Detector, CompressorEnvelope Envelope>
+	inline float processHardKnee(const float in)
+	{
+		// Get detector input
+		float inDetector;
+		if constexpr (Detector == CompressorDetector::Peak)
+		{
+			inDetector = Math::fabsf(in);
+		}
+		else if constexpr (Detector == CompressorDetector::RMS)
+		{
+			inDetector = RMS_FACTOR * m_RMS.process(in);
+		}
+		else
+		{
+			const float rms = RMS_FACTOR * m_RMS.process(in);
+			const float peak = Math::fabsf(in);
+			inDetector = m_peakRatio * (peak - rms) + rms;
+		}
+
+		// Get attenuation
+		float attenuatedB;
+		if constexpr (Envelope == CompressorEnvelope::Log)
+		{
+			attenuatedB = getLogAttenuation(inDetector);
+		}
+		else if constexpr (Envelope == CompressorEnvelope::Lin)
+		{
+			attenuatedB = getLinAttenuation(inDetector);
+		}
+		else
+		{
+			const float attenuateLogdB = getLogAttenuation(inDetector);
+			const float attenuateLindB = getLinAttenuation(inDetector);
+			attenuatedB = m_logRatio * (attenuateLogdB - attenuateLindB) + attenuateLindB;
+		}
 
-		// Get combined lin/log attenuation
-		const float attenuatedB = m_logRatio * (attenuateLogdB - attenuateLindB) + attenuateLindB;
-		const float attenuateGain = juce::Decibels::decibelsToGain(attenuatedB);
-		
 		// Apply gain reduction
-		return attenuateGain * in;
+		return Conversion::dBToGain(attenuatedB) * in;
 	};
 	float processHardKneeLinPeak(float in);
 	float processHardKneeLogPeak(float in);
@@ -110,15 +189,32 @@ public:
 	float processSoftKneeLinPeak(float in);
 
 protected:
+	// Gain reduction in dB smoothed in log domain, negative values
+	inline float getLogAttenuation(const float inDetector)
+	{
+		const float indB = Conversion::gainTodB(inDetector);
+		const float envelopeIndB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
+		return -m_envelopeFollowerLog.process(envelopeIndB);
+	};
+	// Gain reduction in dB smoothed in lin domain, negative values
+	inline float getLinAttenuation(const float inDetector)
+	{
+		const float smoothLin = m_envelopeFollowerLin.process(inDetector);
+		return smoothLin > m_params.m_threshold ? (Conversion::gainTodB(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
+	};
+
 	RMS m_RMS;
 	CompressorParams<float> m_params;
 	DecoupeledEnvelopeFollower<float> m_envelopeFollowerLog;
 	DecoupeledEnvelopeFollower<float> m_envelopeFollowerLin;
 	float m_peakRatio = 1.0f;
 	float m_logRatio = 1.0f;
+	CompressorDetector m_detector = CompressorDetector::Blend;
+	CompressorEnvelope m_envelope = CompressorEnvelope::Blend;
 };
 
 //==============================================================================
+template <typename Conversion = DecibelConversion::Exact>
 class SlewCompressor
 {
 public:
@@ -147,30 +243,30 @@ public:
 	{
 		// Get combined peak/rms input
 		const float rms = RMS_FACTOR * m_RMS.process(in);
-		const float peak = std::fabsf(in);
+		const float peak = std::fabs(in);
 		const float inCombined = m_peakRatio * (peak - rms) + rms;
 
 		// Get log attenuation
-		const float indB = juce::Decibels::gainToDecibels(inCombined);
+		const float indB = Conversion::gainTodB(inCombined);
 		const float envelopeIndB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
 		const float attenuateLogdB = -m_envelopeFollowerLog.process(envelopeIndB);
 
 		// Get lin attenuation
 		const float smoothLin = m_envelopeFollowerLin.process(inCombined);
-		const float attenuateLindB = smoothLin > m_params.m_threshold ? (juce::Decibels::gainToDecibels(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
+		const float attenuateLindB = smoothLin > m_params.m_threshold ? (Conversion::gainTodB(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
 
 		// Get combined lin/log attenuation
 		const float attenuatedB = m_logRatio * (attenuateLogdB - attenuateLindB) + attenuateLindB;
-		const float attenuateGain = juce::Decibels::decibelsToGain(attenuatedB);
+		const float attenuateGain = Conversion::dBToGain(attenuatedB);
 
 		// Apply gain reduction
 		return attenuateGain * in;
 	};
-	inline float processHardKneeLinPeak(const float in);
-	inline float processHardKneeLogPeak(const float in);
-	inline float processHardKneeLinRMS(const float in);
-	inline float processHardKneeLogRMS(const float in);
-	inline float processSoftKnee(const float in);
+	float processHardKneeLinPeak(float in);
+	float processHardKneeLogPeak(float in);
+	float processHardKneeLinRMS(float in);
+	float processHardKneeLogRMS(float in);
+	float processSoftKnee(float in);
 
 protected:
 	SlewEnvelopeFollower<float> m_envelopeFollowerLog;
@@ -182,6 +278,7 @@ protected:
 };
 
 //==============================================================================
+template <typename Conversion = DecibelConversion::Exact>
 class OptoCompressor
 {
 public:
@@ -210,21 +307,21 @@ public:
 	{
 		// Get combined peak/rms input
 		const float rms = RMS_FACTOR * m_RMS.process(in);
-		const float peak = std::fabsf(in);
+		const float peak = std::fabs(in);
 		const float inCombined = m_peakRatio * (peak - rms) + rms;
 
 		// Get log attenuation
-		const float indB = juce::Decibels::gainToDecibels(inCombined);
+		const float indB = Conversion::gainTodB(inCombined);
 		const float envelopeIndB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
 		const float attenuateLogdB = -m_envelopeFollowerLog.process(envelopeIndB);
 
 		// Get lin attenuation
 		const float smoothLin = (1.0f / 24.0f) * m_envelopeFollowerLin.process(24.0f * inCombined);
-		const float attenuateLindB = smoothLin > m_params.m_threshold ? (juce::Decibels::gainToDecibels(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
+		const float attenuateLindB = smoothLin > m_params.m_threshold ? (Conversion::gainTodB(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
 
 		// Get combined lin/log attenuation
 		const float attenuatedB = m_logRatio * (attenuateLogdB - attenuateLindB) + attenuateLindB;
-		const float attenuateGain = juce::Decibels::decibelsToGain(attenuatedB);
+		const float attenuateGain = Conversion::dBToGain(attenuatedB);
 
 		// Apply gain reduction
 		return attenuateGain * in;
@@ -245,6 +342,7 @@ protected:
 };
 
 //==============================================================================
+template <typename Conversion = DecibelConversion::Exact>
 class DualCompressor
 {
 public:
@@ -273,21 +371,21 @@ public:
 	{
 		// Get combined peak/rms input
 		const float rms = RMS_FACTOR * m_RMS.process(in);
-		const float peak = std::fabsf(in);
+		const float peak = std::fabs(in);
 		const float inCombined = m_peakRatio * (peak - rms) + rms;
 
 		// Get log attenuation
-		const float indB = juce::Decibels::gainToDecibels(inCombined);
+		const float indB = Conversion::gainTodB(inCombined);
 		const float envelopeIndB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
 		const float attenuateLogdB = -m_envelopeFollowerLog.process(envelopeIndB);
 
 		// Get lin attenuation
 		const float smoothLin = (1.0f / 24.0f) * m_envelopeFollowerLin.process(24.0f * inCombined);
-		const float attenuateLindB = smoothLin > m_params.m_threshold ? (juce::Decibels::gainToDecibels(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
+		const float attenuateLindB = smoothLin > m_params.m_threshold ? (Conversion::gainTodB(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
 
 		// Get combined lin/log attenuation
 		const float attenuatedB = m_logRatio * (attenuateLogdB - attenuateLindB) + attenuateLindB;
-		const float attenuateGain = juce::Decibels::decibelsToGain(attenuatedB);
+		const float attenuateGain = Conversion::dBToGain(attenuatedB);
 
 		// Apply gain reduction
 		return attenuateGain * in;
@@ -308,6 +406,7 @@ protected:
 };
 
 //==============================================================================
+template <typename Conversion = DecibelConversion::Exact>
 class AdaptiveCompressor
 {
 public:
@@ -343,21 +442,21 @@ public:
 		
 		// Get combined peak/rms input
 		const float rms = RMS_FACTOR * m_RMS.process(in);
-		const float peak = std::fabsf(in);
+		const float peak = std::fabs(in);
 		const float inCombined = m_peakRatio * (peak - rms) + rms;
 
 		// Get log attenuation
-		const float indB = juce::Decibels::gainToDecibels(inCombined);
+		const float indB = Conversion::gainTodB(inCombined);
 		const float envelopeIndB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
 		const float attenuateLogdB = -m_envelopeFollowerLog.process(envelopeIndB);
 
 		// Get lin attenuation
 		const float smoothLin = (1.0f / 24.0f) * m_envelopeFollowerLin.process(24.0f * inCombined);
-		const float attenuateLindB = smoothLin > m_params.m_threshold ? (juce::Decibels::gainToDecibels(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
+		const float attenuateLindB = smoothLin > m_params.m_threshold ? (Conversion::gainTodB(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
 
 		// Get combined lin/log attenuation
 		const float attenuatedB = m_logRatio * (attenuateLogdB - attenuateLindB) + attenuateLindB;
-		const float attenuateGain = juce::Decibels::decibelsToGain(attenuatedB);
+		const float attenuateGain = Conversion::dBToGain(attenuatedB);
 
 		// Apply gain reduction
 		return attenuateGain * in;
@@ -374,15 +473,15 @@ public:
 		}
 
 		//Get gain reduction, positive values
-		const float attenuatedB = (juce::Decibels::gainToDecibels(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+		const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 		// Apply gain reduction
-		return in * juce::Decibels::decibelsToGain(attenuatedB);
+		return in * Conversion::dBToGain(attenuatedB);
 	};
 	float processHardKneeLogPeak(float in)
 	{
 		// Convert input from gain to dB
-		const float indB = juce::Decibels::gainToDecibels(fabsf(in));
+		const float indB = Conversion::gainTodB(fabsf(in));
 
 		//Get gain reduction, positive values
 		const float attenuatedB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
@@ -391,7 +490,7 @@ public:
 		const float attenuateSmoothdB = -m_envelopeFollowerLog.process(attenuatedB);
 
 		// Apply gain reduction
-		return in * juce::Decibels::decibelsToGain(attenuateSmoothdB);
+		return in * Conversion::dBToGain(attenuateSmoothdB);
 	}
 	float processHardKneeLinRMS(float in)
 	{
@@ -408,10 +507,10 @@ public:
 		}
 
 		//Get gain reduction, positive values
-		const float attenuatedB = (juce::Decibels::gainToDecibels(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+		const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 		// Apply gain reduction
-		return in * juce::Decibels::decibelsToGain(attenuatedB);
+		return in * Conversion::dBToGain(attenuatedB);
 	}
 	float processHardKneeLogRMS(float in)
 	{
@@ -419,7 +518,7 @@ public:
 		const float rms = RMS_FACTOR * m_RMS.process(in);
 
 		// Convert input from gain to dB
-		const float indB = juce::Decibels::gainToDecibels(rms);
+		const float indB = Conversion::gainTodB(rms);
 
 		//Get gain reduction, positive values
 		const float attenuatedB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
@@ -428,7 +527,7 @@ public:
 		const float attenuateSmoothdB = -m_envelopeFollowerLog.process(attenuatedB);
 
 		// Apply gain reduction
-		return in * juce::Decibels::decibelsToGain(attenuateSmoothdB);
+		return in * Conversion::dBToGain(attenuateSmoothdB);
 	}
 	float processSoftKnee(float in)
 	{
@@ -442,7 +541,7 @@ public:
 		}
 
 		// Convert input from gain to dB
-		const float smoothdB = juce::Decibels::gainToDecibels(smooth);
+		const float smoothdB = Conversion::gainTodB(smooth);
 
 		//Get gain reduction, positive values
 		float attenuatedB = 0.0f;
@@ -458,7 +557,7 @@ public:
 		}
 
 		// Apply gain reduction
-		return in * juce::Decibels::decibelsToGain(attenuatedB);
+		return in * Conversion::dBToGain(attenuatedB);
 	}
 
 protected:
@@ -472,6 +571,7 @@ protected:
 };
 
 //==============================================================================
+template <typename Conversion = DecibelConversion::Exact>
 class SmoothCompressor
 {
 public:
@@ -500,21 +600,21 @@ public:
 	{
 		// Get combined peak/rms input
 		const float rms = RMS_FACTOR * m_RMS.process(in);
-		const float peak = std::fabsf(in);
+		const float peak = std::fabs(in);
 		const float inCombined = m_peakRatio * (peak - rms) + rms;
 
 		// Get log attenuation
-		const float indB = juce::Decibels::gainToDecibels(inCombined);
+		const float indB = Conversion::gainTodB(inCombined);
 		const float envelopeIndB = (indB >= m_params.m_thresholddB) ? (indB - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
 		const float attenuateLogdB = -m_envelopeFollowerLog.process(envelopeIndB);
 
 		// Get lin attenuation
 		const float smoothLin = (1.0f / 24.0f) * m_envelopeFollowerLin.process(24.0f * inCombined);
-		const float attenuateLindB = smoothLin > m_params.m_threshold ? (juce::Decibels::gainToDecibels(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
+		const float attenuateLindB = smoothLin > m_params.m_threshold ? (Conversion::gainTodB(smoothLin) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One : 0.0f;
 
 		// Get combined lin/log attenuation
 		const float attenuatedB = m_logRatio * (attenuateLogdB - attenuateLindB) + attenuateLindB;
-		const float attenuateGain = juce::Decibels::decibelsToGain(attenuatedB);
+		const float attenuateGain = Conversion::dBToGain(attenuatedB);
 
 		// Apply gain reduction
 		return attenuateGain * in;
@@ -22,6 +22,23 @@
 #include <algorithm>
 #include <type_traits>
 
+//==============================================================================
+// Adds processBlock() to a follower with process(T), input and output can be the same buffer
+template <typename Derived, typename T>
+class BlockEnvelopeFollower
+{
+public:
+	inline void processBlock(const T* input, T* output, const int samples)
+	{
+		auto& follower = static_cast<Derived&>(*this);
+
+		for (int sample = 0; sample < samples; sample++)
+		{
+			output[sample] = follower.process(input[sample]);
+		}
+	};
+};
+
 //==============================================================================
 template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
 class BaseEnvelopeFollower
@@ -55,6 +72,10 @@ public:
 	{
 		m_attackCoef = exp(static_cast<T>(-m_sampleRate) / static_cast<T>(releaseSize));
 	};
+	inline void reset()
+	{
+		m_outLast = T(0.0);
+	}
 	inline void release()
 	{
 		m_attackCoef = T(0.0);
@@ -72,7 +93,7 @@ protected:
 
 //==============================================================================
 template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
-class BranchingEnvelopeFollower : public BaseEnvelopeFollower<T>
+class BranchingEnvelopeFollower : public BaseEnvelopeFollower<T>, public BlockEnvelopeFollower<BranchingEnvelopeFollower<T>, T>
 {
 public:
 	BranchingEnvelopeFollower() = default;
@@ -85,11 +106,16 @@ public:
 
 		return m_outLast = inAbs + coef * (m_outLast - inAbs);
 	};
+
+protected:
+	using BaseEnvelopeFollower<T>::m_attackCoef;
+	using BaseEnvelopeFollower<T>::m_releaseCoef;
+	using BaseEnvelopeFollower<T>::m_outLast;
 };
 
 //==============================================================================
 template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
-class BranchingEnvelopeFollowerUnsafe : public BaseEnvelopeFollower<T>
+class BranchingEnvelopeFollowerUnsafe : public BaseEnvelopeFollower<T>, public BlockEnvelopeFollower<BranchingEnvelopeFollowerUnsafe<T>, T>
 {
 public:
 	BranchingEnvelopeFollowerUnsafe() = default;
@@ -101,12 +127,17 @@ public:
 		const T coef = (in > m_outLast) ? m_attackCoef : m_releaseCoef;
 		return m_outLast = in + coef * (m_outLast - in);
 	};
+
+protected:
+	using BaseEnvelopeFollower<T>::m_attackCoef;
+	using BaseEnvelopeFollower<T>::m_releaseCoef;
+	using BaseEnvelopeFollower<T>::m_outLast;
 };
 
 
 //==============================================================================
 template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
-class DecoupeledEnvelopeFollower : public BaseEnvelopeFollower<T>
+class DecoupeledEnvelopeFollower : public BaseEnvelopeFollower<T>, public BlockEnvelopeFollower<DecoupeledEnvelopeFollower<T>, T>
 {
 public:
 	DecoupeledEnvelopeFollower() = default;
@@ -119,6 +150,16 @@ public:
 		
 		return m_outLast = m_OutReleaseLast + m_attackCoef * (m_outLast - m_OutReleaseLast);
 	};
+	inline void reset()
+	{
+		m_outLast = T(0.0);
+		m_OutReleaseLast = T(0.0);
+	}
+
+protected:
+	using BaseEnvelopeFollower<T>::m_attackCoef;
+	using BaseEnvelopeFollower<T>::m_releaseCoef;
+	using BaseEnvelopeFollower<T>::m_outLast;
 
 private:
 	T m_OutReleaseLast = T(0.0);
@@ -126,7 +167,7 @@ private:
 
 //==============================================================================
 template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
-class HoldEnvelopeFollower
+class HoldEnvelopeFollower : public BlockEnvelopeFollower<HoldEnvelopeFollower<T>, T>
 {
 public:
 	HoldEnvelopeFollower() = default;
@@ -189,7 +230,7 @@ protected:
 
 //==============================================================================
 template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
-class SlewEnvelopeFollower
+class SlewEnvelopeFollower : public BlockEnvelopeFollower<SlewEnvelopeFollower<T>, T>
 {
 public:
 	SlewEnvelopeFollower() = default;
@@ -232,7 +273,7 @@ protected:
 
 //==============================================================================
 template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
-class OptoEnvelopeFollower
+class OptoEnvelopeFollower : public BlockEnvelopeFollower<OptoEnvelopeFollower<T>, T>
 {
 public:
 	OptoEnvelopeFollower() = default;
@@ -378,7 +419,7 @@ public:
 			}
 		}
 
-		return gainComponesation;
+		return gainCompensation;
 	}
 
 private:
@@ -391,7 +432,7 @@ private:
 //==============================================================================
 
 template <typename T>
-class ZCHoldEnvelopeFollower
+class ZCHoldEnvelopeFollower : public BlockEnvelopeFollower<ZCHoldEnvelopeFollower<T>, T>
 {
 public:
 	ZCHoldEnvelopeFollower()
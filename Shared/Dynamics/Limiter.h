@@ -64,7 +64,7 @@ public:
 	inline float process(float in, float inDelayed)
 	{
 		// Start attack
-		const float inAbs = std::fabsf(in);
+		const float inAbs = std::fabs(in);
 		if (inAbs > m_threshold && inAbs > m_currentPeak)
 		{
 			const float finalMultiplier = m_threshold / inAbs;
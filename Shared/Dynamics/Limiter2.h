@@ -68,7 +68,7 @@ public:
 	inline float process(float in, float inDelayed)
 	{
 		// Get envelope
-		const float inAbs = std::fabsf(in);
+		const float inAbs = std::fabs(in);
 		const float aboveThresholdNormalized = m_thresholdMultiplier * inAbs;
 		const float envelope = std::max(1.0f, m_envelopeFollower.process(aboveThresholdNormalized));
 
@@ -18,44 +18,47 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <cmath>
 
 #include "../../../zazzVSTPlugins/Shared/Utilities/CircularBuffers.h"
 #include "../../../zazzVSTPlugins/Shared/Dynamics/EnvelopeFollowers.h"
 #include "../../../zazzVSTPlugins/Shared/Utilities/Math.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/DecibelConversion.h"
 
+//==============================================================================
+/**
+ * Lookahead limiter. Every peak above threshold starts a linear gain reduction
+ * ramp that reaches its attenuation when the delayed peak is output.
+ *
+ * Gain reduction is the maximum of all active ramps. Ramp with value below an older
+ * ramp can overtake it later, but once a newer ramp overtakes an older one it stays
+ * above it (both grow, older one grows relatively slower) and it lives longer.
+ * Overtaken ramps are dropped, remaining ramps are ordered by value so the oldest one
+ * is the maximum. Overtake times are known in advance and kept in a timing wheel,
+ * so cost per sample is constant regardless of attack length.
+ * Only after attack time gets shorter, active ramps are scanned until the older ones end.
+ * Conversion is the per sample gain <-> dB policy from DecibelConversion.h.
+ */
+template <typename Conversion = DecibelConversion::Exact>
 class Limiter3
 {
 public:
 	Limiter3() = default;
 	~Limiter3() = default;
 
-	struct Peak
-	{
-		Peak() : m_samples(0), m_step(0.0)
-		{
-		};
-		Peak(int samples, float step) : m_samples(samples), m_step(step)
-		{
-		};
-		float increase()
-		{
-			m_samples--;
-			return m_value += m_step;
-		}
-
-		int m_samples;
-		float m_step;
-		float m_value = 0.0f;
-	};
-
 	inline void init(const int sampleRate, const int size)
 	{
 		m_sampleRate = sampleRate;
 		m_buffer.init(size);
 		m_envelopeFollower.init(sampleRate);
 
-		m_peaks = new Peak[size];
 		m_attackSizeMax = size;
+		m_peaks.resize(size);
+		m_wheelSize = size + 1;
+		m_wheel.resize(m_wheelSize);
+
+		reset();
 	}
 	inline void set(const float attackMS, const float releaseMS, const float threshold)
 	{
@@ -87,7 +90,7 @@ public:
 	inline void setThreshold(const float threshold)
 	{
 		m_threshold = threshold;
-		m_thresholddB = Math::gainTodB(threshold);
+		m_thresholddB = Conversion::gainTodB(threshold);
 	}
 	inline float process(float in)
 	{
@@ -101,54 +104,52 @@ public:
 	// inDelayed: used to for output calculation
 	inline float process(const float in, const float inDelayed)
 	{
-		// Detect peak
-		const float inAbs = std::fabsf(in);
-		if (inAbs > m_threshold)
-		{
-			const float attenuatedB = Math::gainTodB(inAbs) - m_thresholddB;
-			const float step = attenuatedB * m_attackFactor;
+		m_time++;
 
-			Peak& peak = m_peaks[m_peaksWritteIndex];
-			m_peaksWritteIndex++;
-			if (m_peaksWritteIndex >= m_attackSizeMax)
-			{
-				m_peaksWritteIndex -= m_attackSizeMax;
-			}
-
-			peak.m_samples = m_attackSize;
-			peak.m_step = step;
-			peak.m_value = 0.0f;
+		// Drop expired ramps, oldest is first
+		while (m_first != NONE && m_peaks[m_first].m_end < m_time)
+		{
+			unlink(m_first);
 		}
 
-		// Process peaks
-		float max = 0.0f;
-		//const int validPeaksCount = m_firstValidPeakIndex <= m_peaksWritteIndex ? m_peaksWritteIndex - m_firstValidPeakIndex + 1 : m_firstValidPeakIndex + m_attackSizeMax - m_peaksWritteIndex - 1;
-
-		//for (int i = 0; i < validPeaksCount; i++)
-		for (int i = 0; i < m_attackSizeMax; i++)
+		// Detect peak. Ramp is active for attackSize - 1 samples, its value is step * age
+		const float inAbs = std::fabs(in);
+		if (inAbs > m_threshold && m_attackSize > 1)
 		{
-			//const int idx = (i + m_firstValidPeakIndex) % m_attackSizeMax;
+			const float attenuatedB = Conversion::gainTodB(inAbs) - m_thresholddB;
+			const float step = attenuatedB * m_attackFactor;
 
-			//Peak& peak = m_peaks[idx];
-			Peak& peak = m_peaks[i];
+			const int index = (int)(m_time % m_attackSizeMax);
+			Peak& peak = m_peaks[index];
+			peak.m_start = m_time - 1;
+			peak.m_end = m_time + std::min(m_attackSize, m_attackSizeMax) - 2;
+			peak.m_step = step;
 
-			// Find maximum
-			const float value = peak.increase();
-			if (peak.m_samples > 0 && value > max)
+			// Shorter attack, older ramps outlive this one until their end
+			if (m_last != NONE && m_peaks[m_last].m_end > peak.m_end)
 			{
-				max = value;
+				m_unorderedUntil = std::max(m_unorderedUntil, m_peaks[m_last].m_end);
 			}
 
-			// Store first invalid peak
-			/*if (peak.m_samples <= 0)
-			{
-				m_firstValidPeakIndex = idx;
-			}*/
+			append(index);
+			dropOvertaken(index);
 		}
 
+		// Ramps overtaking their older neighbour now. Events are less than wheel size ahead,
+		// so whole bucket is due. Handling an event removes it from the bucket.
+		int& bucket = m_wheel[m_time % m_wheelSize];
+		while (bucket != NONE)
+		{
+			jassert(m_peaks[bucket].m_eventTime == m_time);
+			dropOvertaken(bucket);
+		}
+
+		// Maximum ramp
+		const float max = m_time > m_unorderedUntil ? (m_first != NONE ? getValue(m_first) : 0.0f) : getMaxUnordered();
+
 		// Apply release
 		const float maxSmooth = m_envelopeFollower.process(max);
-		const float gain = Math::dBToGain(-maxSmooth);
+		const float gain = Conversion::dBToGain(-maxSmooth);
 
 		// apply attenuation for output
 		return gain * inDelayed;
@@ -157,8 +158,8 @@ public:
 	{
 		m_buffer.release();
 		
-		delete[] m_peaks;
-		m_peaks = nullptr;
+		m_peaks.clear();
+		m_wheel.clear();
 		
 		m_envelopeFollower.release();
 
@@ -168,13 +169,191 @@ public:
 		m_sampleRate = 48000;
 		m_attackSize = 0;
 		m_attackSizeMax = 0;
-		m_peaksWritteIndex = 0;
-		m_firstValidPeakIndex = 0;
+		m_wheelSize = 0;
+		m_time = 0;
+		m_unorderedUntil = 0;
+		m_first = NONE;
+		m_last = NONE;
 	}
 
 private:
+	static constexpr int NONE = -1;
+
+	struct Peak
+	{
+		long long m_start = 0;			// Sample before peak, ramp value is m_step * (time - m_start)
+		long long m_end = 0;			// Last active sample
+		float m_step = 0.0f;
+
+		// Active ramps, ordered by age
+		int m_previous = NONE;
+		int m_next = NONE;
+
+		// Time this ramp overtakes m_previous, timing wheel bucket list
+		long long m_eventTime = -1;
+		int m_eventPrevious = NONE;
+		int m_eventNext = NONE;
+	};
+
+	// After attack time was shortened, newer ramps can overtake older ones they cannot drop
+	inline float getMaxUnordered() const
+	{
+		float max = 0.0f;
+		for (int index = m_first; index != NONE; index = m_peaks[index].m_next)
+		{
+			if (m_peaks[index].m_end >= m_time)
+			{
+				max = std::max(max, getValue(index));
+			}
+		}
+
+		return max;
+	}
+
+	inline void reset()
+	{
+		std::fill(m_wheel.begin(), m_wheel.end(), NONE);
+		m_time = 0;
+		m_unorderedUntil = 0;
+		m_first = NONE;
+		m_last = NONE;
+	}
+
+	inline float getValue(const int index) const
+	{
+		const Peak& peak = m_peaks[index];
+		return peak.m_step * (float)(m_time - peak.m_start);
+	}
+
+	inline void append(const int index)
+	{
+		Peak& peak = m_peaks[index];
+		peak.m_previous = m_last;
+		peak.m_next = NONE;
+		peak.m_eventTime = -1;
+
+		if (m_last != NONE)
+		{
+			m_peaks[m_last].m_next = index;
+		}
+		else
+		{
+			m_first = index;
+		}
+		m_last = index;
+	}
+
+	inline void unlink(const int index)
+	{
+		cancelEvent(index);
+
+		Peak& peak = m_peaks[index];
+		if (peak.m_previous != NONE)
+		{
+			m_peaks[peak.m_previous].m_next = peak.m_next;
+		}
+		else
+		{
+			m_first = peak.m_next;
+		}
+
+		if (peak.m_next != NONE)
+		{
+			m_peaks[peak.m_next].m_previous = peak.m_previous;
+		}
+		else
+		{
+			m_last = peak.m_previous;
+		}
+
+		// New first ramp has nothing to overtake
+		if (m_first != NONE)
+		{
+			cancelEvent(m_first);
+		}
+	}
+
+	// Drops older neighbours the ramp already overtook, schedules next overtake
+	inline void dropOvertaken(const int index)
+	{
+		cancelEvent(index);
+
+		while (true)
+		{
+			const int previous = m_peaks[index].m_previous;
+			if (previous == NONE || m_peaks[previous].m_end > m_peaks[index].m_end)
+			{
+				return;
+			}
+
+			if (getValue(index) < getValue(previous))
+			{
+				break;
+			}
+
+			unlink(previous);
+		}
+
+		// step * (t - start) >= previousStep * (t - previousStart) from time t on, if step is larger
+		const Peak& peak = m_peaks[index];
+		const Peak& previous = m_peaks[peak.m_previous];
+		if (peak.m_step <= previous.m_step)
+		{
+			return;
+		}
+
+		const double age = (double)peak.m_step * (double)(peak.m_start - previous.m_start) / (double)(peak.m_step - previous.m_step);
+		const long long eventTime = std::max(m_time + 1, previous.m_start + (long long)std::ceil(age));
+		if (eventTime <= previous.m_end)
+		{
+			scheduleEvent(index, eventTime);
+		}
+	}
+
+	inline void scheduleEvent(const int index, const long long eventTime)
+	{
+		Peak& peak = m_peaks[index];
+		int& bucket = m_wheel[eventTime % m_wheelSize];
+
+		peak.m_eventTime = eventTime;
+		peak.m_eventPrevious = NONE;
+		peak.m_eventNext = bucket;
+
+		if (bucket != NONE)
+		{
+			m_peaks[bucket].m_eventPrevious = index;
+		}
+		bucket = index;
+	}
+
+	inline void cancelEvent(const int index)
+	{
+		Peak& peak = m_peaks[index];
+		if (peak.m_eventTime < 0)
+		{
+			return;
+		}
+
+		if (peak.m_eventPrevious != NONE)
+		{
+			m_peaks[peak.m_eventPrevious].m_eventNext = peak.m_eventNext;
+		}
+		else
+		{
+			m_wheel[peak.m_eventTime % m_wheelSize] = peak.m_eventNext;
+		}
+
+		if (peak.m_eventNext != NONE)
+		{
+			m_peaks[peak.m_eventNext].m_eventPrevious = peak.m_eventPrevious;
+		}
+
+		peak.m_eventTime = -1;
+	}
+
 	CircularBuffer m_buffer;
-	Peak* m_peaks = nullptr;
+	std::vector<Peak> m_peaks;						// Indexed by time % m_attackSizeMax
+	std::vector<int> m_wheel;						// First ramp with overtake event at time % m_wheelSize
 	BranchingEnvelopeFollower<float> m_envelopeFollower;
 
 	float m_threshold = 1.0;
@@ -183,6 +362,9 @@ private:
 	int m_sampleRate = 48000;
 	int m_attackSize = 0;
 	int m_attackSizeMax = 0;
-	int m_peaksWritteIndex = 0;
-	int m_firstValidPeakIndex = 0;
+	int m_wheelSize = 0;
+	long long m_time = 0;
+	long long m_unorderedUntil = 0;					// Ramps are not ordered by value until this time
+	int m_first = NONE;
+	int m_last = NONE;
 };
\ No newline at end of file
@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+#endif
+
+#include <cmath>
+
+//==============================================================================
+// 2, 4 or 8 independent envelope followers processed together, one lane per follower.
+// Lanes can be channels or sidechain bands. Attack / release selection is branch free.
+// Output of each type matches the scalar follower from EnvelopeFollowers.h:
+//		Branching	- BranchingEnvelopeFollower
+//		Decoupled	- DecoupeledEnvelopeFollower
+//		Hold		- HoldEnvelopeFollower
+// Uses AVX (8 lanes), SSE or NEON (4 lanes per register) with scalar fallback.
+template <int Lanes>
+class MultiLaneEnvelopeFollower
+{
+	static_assert(Lanes == 2 || Lanes == 4 || Lanes == 8, "MultiLaneEnvelopeFollower supports 2, 4 or 8 lanes");
+
+public:
+	MultiLaneEnvelopeFollower() = default;
+	~MultiLaneEnvelopeFollower() = default;
+
+	static constexpr int LANES = Lanes;
+
+	enum class Type
+	{
+		Branching,
+		Decoupled,
+		Hold
+	};
+
+	inline void init(const int sampleRate) noexcept
+	{
+		m_sampleRate = sampleRate;
+	};
+	inline void setType(const Type type) noexcept
+	{
+		m_type = type;
+	};
+	inline void set(const int lane, const float attackTimeMs, const float releaseTimeMs, const float holdTimeMs = 0.0f) noexcept
+	{
+		m_attackCoef[lane] = std::exp(-1000.0f / (attackTimeMs * static_cast<float>(m_sampleRate)));
+		m_releaseCoef[lane] = std::exp(-1000.0f / (releaseTimeMs * static_cast<float>(m_sampleRate)));
+		m_holdTimeSamples[lane] = static_cast<float>(static_cast<int>(0.001f * holdTimeMs * static_cast<float>(m_sampleRate)));
+	};
+	// Same times on all lanes, typical for multichannel processing
+	inline void set(const float attackTimeMs, const float releaseTimeMs, const float holdTimeMs = 0.0f) noexcept
+	{
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			set(lane, attackTimeMs, releaseTimeMs, holdTimeMs);
+		}
+	};
+
+	// One sample for each lane, in place. frame has to hold Lanes floats.
+	inline void process(float* frame) noexcept
+	{
+		switch (m_type)
+		{
+		case Type::Branching:	processLanes<Type::Branching>(frame); break;
+		case Type::Decoupled:	processLanes<Type::Decoupled>(frame); break;
+		case Type::Hold:		processLanes<Type::Hold>(frame); break;
+		}
+	};
+
+	// Lane i processes buffers[i] in place. Lanes without buffer are fed with silence.
+	inline void processBlock(float* const* buffers, const int buffersCount, const int samples) noexcept
+	{
+		switch (m_type)
+		{
+		case Type::Branching:	processBlockLanes<Type::Branching>(buffers, buffersCount, samples); break;
+		case Type::Decoupled:	processBlockLanes<Type::Decoupled>(buffers, buffersCount, samples); break;
+		case Type::Hold:		processBlockLanes<Type::Hold>(buffers, buffersCount, samples); break;
+		}
+	};
+
+	inline float getOutput(const int lane) const noexcept
+	{
+		return m_outLast[lane];
+	};
+	// Resets envelopes
+	inline void reset() noexcept
+	{
+		for (int lane = 0; lane < REGISTER_LANES; lane++)
+		{
+			m_outLast[lane] = 0.0f;
+			m_outReleaseLast[lane] = 0.0f;
+			m_holdCounter[lane] = 0.0f;
+		}
+	};
+	inline void release() noexcept
+	{
+		reset();
+
+		for (int lane = 0; lane < REGISTER_LANES; lane++)
+		{
+			m_attackCoef[lane] = 0.0f;
+			m_releaseCoef[lane] = 0.0f;
+			m_holdTimeSamples[lane] = 0.0f;
+		}
+
+		m_sampleRate = 48000;
+	};
+
+private:
+	// 2 lanes still use one 4 lane register, extra lanes stay silent
+	static constexpr int REGISTER_LANES = Lanes < 4 ? 4 : Lanes;
+
+	template <Type type>
+	inline void processBlockLanes(float* const* buffers, const int buffersCount, const int samples) noexcept
+	{
+		alignas(32) float frame[REGISTER_LANES] = {};
+		const int count = buffersCount < Lanes ? buffersCount : Lanes;
+
+		for (int sample = 0; sample < samples; sample++)
+		{
+			for (int lane = 0; lane < count; lane++)
+			{
+				frame[lane] = buffers[lane][sample];
+			}
+
+			processLanes<type>(frame);
+
+			for (int lane = 0; lane < count; lane++)
+			{
+				buffers[lane][sample] = frame[lane];
+			}
+
+			for (int lane = count; lane < REGISTER_LANES; lane++)
+			{
+				frame[lane] = 0.0f;
+			}
+		}
+	};
+
+	template <Type type>
+	inline void processLanes(float* frame) noexcept
+	{
+#if defined(__AVX__)
+		if constexpr (Lanes == 8)
+		{
+			const __m256 inAbs = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _mm256_loadu_ps(frame));
+			const __m256 attackCoef = _mm256_load_ps(m_attackCoef);
+			const __m256 releaseCoef = _mm256_load_ps(m_releaseCoef);
+			const __m256 outLast = _mm256_load_ps(m_outLast);
+			__m256 out;
+
+			if constexpr (type == Type::Branching)
+			{
+				const __m256 isAttack = _mm256_cmp_ps(inAbs, outLast, _CMP_GT_OQ);
+				const __m256 coef = _mm256_blendv_ps(releaseCoef, attackCoef, isAttack);
+				out = _mm256_add_ps(inAbs, _mm256_mul_ps(coef, _mm256_sub_ps(outLast, inAbs)));
+			}
+			else if constexpr (type == Type::Decoupled)
+			{
+				const __m256 releaseLast = _mm256_load_ps(m_outReleaseLast);
+				const __m256 release = _mm256_max_ps(inAbs, _mm256_add_ps(inAbs, _mm256_mul_ps(releaseCoef, _mm256_sub_ps(releaseLast, inAbs))));
+				_mm256_store_ps(m_outReleaseLast, release);
+				out = _mm256_add_ps(release, _mm256_mul_ps(attackCoef, _mm256_sub_ps(outLast, release)));
+			}
+			else
+			{
+				const __m256 holdCounter = _mm256_load_ps(m_holdCounter);
+				const __m256 isAttack = _mm256_cmp_ps(inAbs, outLast, _CMP_GT_OQ);
+				const __m256 isHolding = _mm256_cmp_ps(holdCounter, _mm256_setzero_ps(), _CMP_GT_OQ);
+
+				const __m256 attack = _mm256_add_ps(_mm256_mul_ps(attackCoef, _mm256_sub_ps(outLast, inAbs)), inAbs);
+				const __m256 release = _mm256_add_ps(_mm256_mul_ps(releaseCoef, _mm256_sub_ps(outLast, inAbs)), inAbs);
+				out = _mm256_blendv_ps(_mm256_blendv_ps(release, outLast, isHolding), attack, isAttack);
+
+				const __m256 counterDecremented = _mm256_max_ps(_mm256_sub_ps(holdCounter, _mm256_set1_ps(1.0f)), _mm256_setzero_ps());
+				_mm256_store_ps(m_holdCounter, _mm256_blendv_ps(counterDecremented, _mm256_load_ps(m_holdTimeSamples), isAttack));
+			}
+
+			_mm256_store_ps(m_outLast, out);
+			_mm256_storeu_ps(frame, out);
+			return;
+		}
+#endif
+
+#if JUCE_USE_SSE_INTRINSICS
+		// Process 4 lanes per iteration
+		for (int lane = 0; lane < Lanes; lane += 4)
+		{
+			const __m128 inAbs = _mm_andnot_ps(_mm_set1_ps(-0.0f), loadFrame(frame + lane));
+			const __m128 attackCoef = _mm_load_ps(m_attackCoef + lane);
+			const __m128 releaseCoef = _mm_load_ps(m_releaseCoef + lane);
+			const __m128 outLast = _mm_load_ps(m_outLast + lane);
+			__m128 out;
+
+			if constexpr (type == Type::Branching)
+			{
+				const __m128 isAttack = _mm_cmpgt_ps(inAbs, outLast);
+				const __m128 coef = select(isAttack, attackCoef, releaseCoef);
+				out = _mm_add_ps(inAbs, _mm_mul_ps(coef, _mm_sub_ps(outLast, inAbs)));
+			}
+			else if constexpr (type == Type::Decoupled)
+			{
+				const __m128 releaseLast = _mm_load_ps(m_outReleaseLast + lane);
+				const __m128 release = _mm_max_ps(inAbs, _mm_add_ps(inAbs, _mm_mul_ps(releaseCoef, _mm_sub_ps(releaseLast, inAbs))));
+				_mm_store_ps(m_outReleaseLast + lane, release);
+				out = _mm_add_ps(release, _mm_mul_ps(attackCoef, _mm_sub_ps(outLast, release)));
+			}
+			else
+			{
+				const __m128 holdCounter = _mm_load_ps(m_holdCounter + lane);
+				const __m128 isAttack = _mm_cmpgt_ps(inAbs, outLast);
+				const __m128 isHolding = _mm_cmpgt_ps(holdCounter, _mm_setzero_ps());
+
+				const __m128 attack = _mm_add_ps(_mm_mul_ps(attackCoef, _mm_sub_ps(outLast, inAbs)), inAbs);
+				const __m128 release = _mm_add_ps(_mm_mul_ps(releaseCoef, _mm_sub_ps(outLast, inAbs)), inAbs);
+				out = select(isAttack, attack, select(isHolding, outLast, release));
+
+				const __m128 counterDecremented = _mm_max_ps(_mm_sub_ps(holdCounter, _mm_set1_ps(1.0f)), _mm_setzero_ps());
+				_mm_store_ps(m_holdCounter + lane, select(isAttack, _mm_load_ps(m_holdTimeSamples + lane), counterDecremented));
+			}
+
+			_mm_store_ps(m_outLast + lane, out);
+			storeFrame(frame + lane, out);
+		}
+#elif JUCE_USE_ARM_NEON
+		// Process 4 lanes per iteration
+		for (int lane = 0; lane < Lanes; lane += 4)
+		{
+			const float32x4_t inAbs = vabsq_f32(loadFrame(frame + lane));
+			const float32x4_t attackCoef = vld1q_f32(m_attackCoef + lane);
+			const float32x4_t releaseCoef = vld1q_f32(m_releaseCoef + lane);
+			const float32x4_t outLast = vld1q_f32(m_outLast + lane);
+			float32x4_t out;
+
+			if constexpr (type == Type::Branching)
+			{
+				const uint32x4_t isAttack = vcgtq_f32(inAbs, outLast);
+				const float32x4_t coef = vbslq_f32(isAttack, attackCoef, releaseCoef);
+				out = vaddq_f32(inAbs, vmulq_f32(coef, vsubq_f32(outLast, inAbs)));
+			}
+			else if constexpr (type == Type::Decoupled)
+			{
+				const float32x4_t releaseLast = vld1q_f32(m_outReleaseLast + lane);
+				const float32x4_t release = vmaxq_f32(inAbs, vaddq_f32(inAbs, vmulq_f32(releaseCoef, vsubq_f32(releaseLast, inAbs))));
+				vst1q_f32(m_outReleaseLast + lane, release);
+				out = vaddq_f32(release, vmulq_f32(attackCoef, vsubq_f32(outLast, release)));
+			}
+			else
+			{
+				const float32x4_t holdCounter = vld1q_f32(m_holdCounter + lane);
+				const uint32x4_t isAttack = vcgtq_f32(inAbs, outLast);
+				const uint32x4_t isHolding = vcgtq_f32(holdCounter, vdupq_n_f32(0.0f));
+
+				const float32x4_t attack = vaddq_f32(vmulq_f32(attackCoef, vsubq_f32(outLast, inAbs)), inAbs);
+				const float32x4_t release = vaddq_f32(vmulq_f32(releaseCoef, vsubq_f32(outLast, inAbs)), inAbs);
+				out = vbslq_f32(isAttack, attack, vbslq_f32(isHolding, outLast, release));
+
+				const float32x4_t counterDecremented = vmaxq_f32(vsubq_f32(holdCounter, vdupq_n_f32(1.0f)), vdupq_n_f32(0.0f));
+				vst1q_f32(m_holdCounter + lane, vbslq_f32(isAttack, vld1q_f32(m_holdTimeSamples + lane), counterDecremented));
+			}
+
+			vst1q_f32(m_outLast + lane, out);
+			storeFrame(frame + lane, out);
+		}
+#else
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			const float inAbs = std::abs(frame[lane]);
+			const float outLast = m_outLast[lane];
+			float out;
+
+			if constexpr (type == Type::Branching)
+			{
+				const float coef = (inAbs > outLast) ? m_attackCoef[lane] : m_releaseCoef[lane];
+				out = inAbs + coef * (outLast - inAbs);
+			}
+			else if constexpr (type == Type::Decoupled)
+			{
+				const float release = std::max(inAbs, inAbs + m_releaseCoef[lane] * (m_outReleaseLast[lane] - inAbs));
+				m_outReleaseLast[lane] = release;
+				out = release + m_attackCoef[lane] * (outLast - release);
+			}
+			else
+			{
+				const bool isAttack = inAbs > outLast;
+				const float attack = m_attackCoef[lane] * (outLast - inAbs) + inAbs;
+				const float release = m_releaseCoef[lane] * (outLast - inAbs) + inAbs;
+				out = isAttack ? attack : (m_holdCounter[lane] > 0.0f ? outLast : release);
+
+				m_holdCounter[lane] = isAttack ? m_holdTimeSamples[lane] : std::max(m_holdCounter[lane] - 1.0f, 0.0f);
+			}
+
+			m_outLast[lane] = out;
+			frame[lane] = out;
+		}
+#endif
+	};
+
+#if JUCE_USE_SSE_INTRINSICS
+	static inline __m128 select(const __m128 mask, const __m128 a, const __m128 b) noexcept
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	};
+	static inline __m128 loadFrame(const float* frame) noexcept
+	{
+		if constexpr (Lanes == 2)
+		{
+			return _mm_setr_ps(frame[0], frame[1], 0.0f, 0.0f);
+		}
+		else
+		{
+			return _mm_loadu_ps(frame);
+		}
+	};
+	static inline void storeFrame(float* frame, const __m128 x) noexcept
+	{
+		if constexpr (Lanes == 2)
+		{
+			_mm_storel_pi(reinterpret_cast<__m64*>(frame), x);
+		}
+		else
+		{
+			_mm_storeu_ps(frame, x);
+		}
+	};
+#elif JUCE_USE_ARM_NEON
+	static inline float32x4_t loadFrame(const float* frame) noexcept
+	{
+		if constexpr (Lanes == 2)
+		{
+			return vcombine_f32(vld1_f32(frame), vdup_n_f32(0.0f));
+		}
+		else
+		{
+			return vld1q_f32(frame);
+		}
+	};
+	static inline void storeFrame(float* frame, const float32x4_t x) noexcept
+	{
+		if constexpr (Lanes == 2)
+		{
+			vst1_f32(frame, vget_low_f32(x));
+		}
+		else
+		{
+			vst1q_f32(frame, x);
+		}
+	};
+#endif
+
+	alignas(32) float m_attackCoef[REGISTER_LANES] = {};
+	alignas(32) float m_releaseCoef[REGISTER_LANES] = {};
+	alignas(32) float m_holdTimeSamples[REGISTER_LANES] = {};
+
+	alignas(32) float m_outLast[REGISTER_LANES] = {};
+	alignas(32) float m_outReleaseLast[REGISTER_LANES] = {};
+	alignas(32) float m_holdCounter[REGISTER_LANES] = {};
+
+	int m_sampleRate = 48000;
+	Type m_type = Type::Branching;
+};
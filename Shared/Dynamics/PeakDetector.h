@@ -31,7 +31,7 @@ public:
 	inline void set(const float holdTimeMS, const float releaseTimeMS)
 	{
 		m_holdTimeSamples = static_cast<int>(0.001f * holdTimeMS * static_cast<float>(m_sampleRate));
-		m_decayCoefficient = std::expf(-1.0f / (0.001f * releaseTimeMS * (float)m_sampleRate));
+		m_decayCoefficient = std::exp(-1.0f / (0.001f * releaseTimeMS * (float)m_sampleRate));
 	};
 	inline float process(const float in)
 	{
@@ -32,6 +32,11 @@ public:
 				
 		return m_sum / static_cast<float>(m_size);
 	};
+	inline void reset() noexcept
+	{
+		m_buffer.reset();
+		m_sum = 0.0f;
+	}
 	inline void release()
 	{
 		m_buffer.release();
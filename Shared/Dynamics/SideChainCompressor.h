@@ -5,6 +5,7 @@
 #include "../../../zazzVSTPlugins/Shared/Filters/BiquadFilters.h"
 #include "../../../zazzVSTPlugins/Shared/Dynamics/Compressors.h"
 
+template <typename Conversion = DecibelConversion::Exact>
 class SideChainCompressor
 {
 public:
@@ -37,10 +38,10 @@ public:
 		}
 
 		//Get gain reduction, positive values
-		const float attenuatedB = (Math::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
+		const float attenuatedB = (Conversion::gainTodB(smooth) - m_params.m_thresholddB) * m_params.m_R_Inv_minus_One;
 
 		// Apply gain reduction
-		return in * Math::dBToGain(attenuatedB);
+		return in * Conversion::dBToGain(attenuatedB);
 	};
 
 protected:
@@ -18,7 +18,7 @@ public:
 	}
 	inline float process(float in)
 	{
-		const float smooth = m_envelopeFollower.process(std::fabsf(in));
+		const float smooth = m_envelopeFollower.process(std::fabs(in));
 		return GetCompressionMultiplier(smooth) * in;
 	}
 
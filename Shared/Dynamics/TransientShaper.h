@@ -27,7 +27,7 @@ public:
 	}
 	inline void process(float& in)
 	{
-		const float envelopeIn = std::fabsf(in);
+		const float envelopeIn = std::fabs(in);
 		// Add 1e-6 to avoid division by 0. Envelope output is alway > 0
 		const float envelopeSlow = 1e-6f + m_envelopeFollowerSlow.process(envelopeIn);
 		const float envelopeFast = m_envelopeFollowerFast.process(envelopeIn);
@@ -134,7 +134,7 @@ public:
 		float differencedB = envelopeFastdB - envelopeSlowdB;
 
 		// Limit difference
-		differencedB = 12.0f * std::atanf(0.083f * differencedB);
+		differencedB = 12.0f * std::atan(0.083f * differencedB);
 
 		// Evaluate state
 		differencedB = differencedB > 0.0f ? m_attackGain * differencedB : m_sustainGain * differencedB;
@@ -58,8 +58,8 @@ public:
 	}
 
 protected:
-	SideChainCompressor m_leveler;
-	Compressor m_compressor;
+	SideChainCompressor<> m_leveler;
+	Compressor<> m_compressor;
 	TubeEmulation m_tubeEmulation;
 	float m_gainCompensation = 1.0f;
 };
\ No newline at end of file
@@ -39,6 +39,6 @@ public:
 	}
 
 protected:
-	Compressor m_FETCompressor;
-	OptoCompressor m_optoCompressor;
+	Compressor<> m_FETCompressor;
+	OptoCompressor<> m_optoCompressor;
 };
@@ -226,6 +226,94 @@ public:
 		normalize();
 	}
 
+	inline void setFilter(const Type type, const float frequency, const float Q, const float gain = 0.0f) noexcept
+	{
+		switch (type)
+		{
+		case Type::LowPass:
+			setLowPass(frequency, Q, gain);
+			break;
+
+		case Type::HighPass:
+			setHighPass(frequency, Q, gain);
+			break;
+
+		case Type::BandPassSkirtGain:
+			setBandPassSkirtGain(frequency, Q, gain);
+			break;
+
+		case Type::BandPassPeakGain:
+			setBandPassPeakGain(frequency, Q, gain);
+			break;
+
+		case Type::Notch:
+			setNotch(frequency, Q, gain);
+			break;
+
+		case Type::Peak:
+			setPeak(frequency, Q, gain);
+			break;
+
+		case Type::LowShelf:
+			setLowShelf(frequency, Q, gain);
+			break;
+
+		case Type::HighShelf:
+			setHighShelf(frequency, Q, gain);
+			break;
+
+		case Type::AllPass:
+			setAllPass(frequency, Q, gain);
+			break;
+		}
+	};
+
+	// Smoothed mode: call once per control block instead of every sample.
+	// Target coefficients are calculated once and processSmoothed*() ramps the current
+	// coefficients linearly to them in rampSamples. Linear ramp between two stable biquads
+	// stays stable, the (a1, a2) stability triangle is convex.
+	inline void setSmoothed(const Type type, const float frequency, const float Q, const float gain, const int rampSamples) noexcept
+	{
+		const Coefficients current = getCoefficients();
+
+		setFilter(type, frequency, Q, gain);
+
+		// First call after init() / release(), nothing to ramp from
+		if (!m_smoothedInitialized || rampSamples <= 1)
+		{
+			m_smoothedInitialized = true;
+			m_rampRemaining = 0;
+			return;
+		}
+
+		m_target = getCoefficients();
+
+		const float rampStep = 1.0f / static_cast<float>(rampSamples);
+		m_delta.b0 = (m_target.b0 - current.b0) * rampStep;
+		m_delta.b1 = (m_target.b1 - current.b1) * rampStep;
+		m_delta.b2 = (m_target.b2 - current.b2) * rampStep;
+		m_delta.a1 = (m_target.a1 - current.a1) * rampStep;
+		m_delta.a2 = (m_target.a2 - current.a2) * rampStep;
+
+		b0 = current.b0;
+		b1 = current.b1;
+		b2 = current.b2;
+		a1 = current.a1;
+		a2 = current.a2;
+
+		m_rampRemaining = rampSamples;
+	};
+	inline float processSmoothedDF1(const float in) noexcept
+	{
+		advanceRamp();
+		return processDF1(in);
+	};
+	inline float processSmoothedDF2T(const float in) noexcept
+	{
+		advanceRamp();
+		return processDF2T(in);
+	};
+
 	inline float processDF1(const float in) noexcept
 	{
 		const float out = b0 * in + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
@@ -272,6 +360,71 @@ public:
 
 		return out;
 	};
+
+	// Block processing keeps the filter history in locals for the whole block,
+	// so the compiler does not reload / store members every sample.
+	// Shares history with processDF1() / processDF2T(), both can be mixed freely.
+	inline void processBlockDF1(float* buffer, const int samples) noexcept
+	{
+		float lx1 = x1;
+		float lx2 = x2;
+		float ly1 = y1;
+		float ly2 = y2;
+
+		for (int sample = 0; sample < samples; sample++)
+		{
+			const float in = buffer[sample];
+			const float out = b0 * in + b1 * lx1 + b2 * lx2 - a1 * ly1 - a2 * ly2;
+
+			lx2 = lx1;
+			lx1 = in;
+
+			ly2 = ly1;
+			ly1 = out;
+
+			buffer[sample] = out;
+		}
+
+		x1 = lx1;
+		x2 = lx2;
+		y1 = ly1;
+		y2 = ly2;
+	};
+	inline void processBlockDF2T(float* buffer, const int samples) noexcept
+	{
+		float lx1 = x1;
+		float lx2 = x2;
+
+		for (int sample = 0; sample < samples; sample++)
+		{
+			const float in = buffer[sample];
+			const float out = b0 * in + lx2;
+
+			lx2 = b1 * in + lx1 - a1 * out;
+			lx1 = b2 * in - a2 * out;
+
+			buffer[sample] = out;
+		}
+
+		x1 = lx1;
+		x2 = lx2;
+	};
+	inline void processBlock(float* buffer, const int samples) noexcept
+	{
+		processBlockDF2T(buffer, samples);
+	};
+	inline void processBlockSmoothedDF1(float* buffer, const int samples) noexcept
+	{
+		// Split block to ramp and steady part, steady part runs without ramp check
+		const int rampSamples = m_rampRemaining < samples ? m_rampRemaining : samples;
+
+		for (int sample = 0; sample < rampSamples; sample++)
+		{
+			buffer[sample] = processSmoothedDF1(buffer[sample]);
+		}
+
+		processBlockDF1(buffer + rampSamples, samples - rampSamples);
+	};
 	inline void release() noexcept
 	{
 		reset();
@@ -284,6 +437,9 @@ public:
 		b1 = 0.0f;
 		b2 = 0.0f;
 
+		m_rampRemaining = 0;
+		m_smoothedInitialized = false;
+
 		m_samplePeriod = 2.08e-5f;
 	};
 	// Resets samples history
@@ -362,7 +518,48 @@ public:
 		}
 	}
 
+	// Normalized coefficients, used by MultiLaneBiquadFilter
+	struct Coefficients
+	{
+		float b0 = 0.0f;
+		float b1 = 0.0f;
+		float b2 = 0.0f;
+		float a1 = 0.0f;
+		float a2 = 0.0f;
+	};
+	inline Coefficients getCoefficients() const noexcept
+	{
+		return { b0, b1, b2, a1, a2 };
+	};
+
 private:
+	__forceinline void advanceRamp() noexcept
+	{
+		if (m_rampRemaining <= 0)
+		{
+			return;
+		}
+
+		m_rampRemaining--;
+
+		// Land exactly on target, avoids accumulated rounding error
+		if (m_rampRemaining == 0)
+		{
+			b0 = m_target.b0;
+			b1 = m_target.b1;
+			b2 = m_target.b2;
+			a1 = m_target.a1;
+			a2 = m_target.a2;
+		}
+		else
+		{
+			b0 += m_delta.b0;
+			b1 += m_delta.b1;
+			b2 += m_delta.b2;
+			a1 += m_delta.a1;
+			a2 += m_delta.a2;
+		}
+	};
 	inline void normalize() noexcept
 	{
 		/*b0 = b0 / a0;
@@ -393,6 +590,11 @@ private:
 	float y1 = 0.0f;
 	float y2 = 0.0f;
 
+	Coefficients m_target;
+	Coefficients m_delta;
+	int m_rampRemaining = 0;
+	bool m_smoothedInitialized = false;
+
 	float m_samplePeriod = 2.08e-5f;
 };
 
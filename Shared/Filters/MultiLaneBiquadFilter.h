@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+	#include <immintrin.h>
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+#endif
+
+#include "../../../zazzVSTPlugins/Shared/Filters/BiquadFilters.h"
+
+//==============================================================================
+// 4 or 8 independent DF2T biquads processed together, one lane per filter.
+// Lanes can be channels (stereo, 5.1, 7.1) or parallel bands fed from one input.
+// Uses AVX (8 lanes), SSE or NEON (4 lanes per register) with scalar fallback.
+template <int Lanes>
+class MultiLaneBiquadFilter
+{
+	static_assert(Lanes == 4 || Lanes == 8, "MultiLaneBiquadFilter supports 4 or 8 lanes");
+
+public:
+	MultiLaneBiquadFilter() = default;
+	~MultiLaneBiquadFilter() = default;
+
+	static constexpr int LANES = Lanes;
+
+	inline void init(const int sampleRate) noexcept
+	{
+		m_designer.init(sampleRate);
+	};
+	inline void set(const int lane, const BiquadFilter::Type type, const float frequency, const float Q, const float gain = 0.0f) noexcept
+	{
+		m_designer.setFilter(type, frequency, Q, gain);
+		setCoefficients(lane, m_designer.getCoefficients());
+	};
+	// Same filter on all lanes, typical for multichannel processing
+	inline void set(const BiquadFilter::Type type, const float frequency, const float Q, const float gain = 0.0f) noexcept
+	{
+		set(0, type, frequency, Q, gain);
+
+		setCoefficients(m_designer.getCoefficients());
+	};
+	inline void setCoefficients(const BiquadFilter::Coefficients& coefficients) noexcept
+	{
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			setCoefficients(lane, coefficients);
+		}
+	};
+	inline void setCoefficients(const int lane, const BiquadFilter::Coefficients& coefficients) noexcept
+	{
+		m_b0[lane] = coefficients.b0;
+		m_b1[lane] = coefficients.b1;
+		m_b2[lane] = coefficients.b2;
+		m_a1[lane] = coefficients.a1;
+		m_a2[lane] = coefficients.a2;
+	};
+
+	// One sample for each lane, in place. frame has to hold Lanes floats.
+	inline void process(float* frame) noexcept
+	{
+#if defined(__AVX__)
+		if constexpr (Lanes == 8)
+		{
+			const __m256 in = _mm256_loadu_ps(frame);
+			const __m256 b0 = _mm256_load_ps(m_b0);
+			const __m256 b1 = _mm256_load_ps(m_b1);
+			const __m256 b2 = _mm256_load_ps(m_b2);
+			const __m256 a1 = _mm256_load_ps(m_a1);
+			const __m256 a2 = _mm256_load_ps(m_a2);
+			const __m256 z1 = _mm256_load_ps(m_z1);
+			const __m256 z2 = _mm256_load_ps(m_z2);
+
+			// out = b0 * in + z2
+			const __m256 out = _mm256_add_ps(_mm256_mul_ps(b0, in), z2);
+
+			// z2 = b1 * in + z1 - a1 * out
+			// z1 = b2 * in - a2 * out
+			_mm256_store_ps(m_z2, _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(b1, in), z1), _mm256_mul_ps(a1, out)));
+			_mm256_store_ps(m_z1, _mm256_sub_ps(_mm256_mul_ps(b2, in), _mm256_mul_ps(a2, out)));
+
+			_mm256_storeu_ps(frame, out);
+			return;
+		}
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+		// Process 4 lanes per iteration
+		for (int lane = 0; lane < Lanes; lane += 4)
+		{
+			const __m128 in = _mm_loadu_ps(frame + lane);
+			const __m128 b0 = _mm_load_ps(m_b0 + lane);
+			const __m128 b1 = _mm_load_ps(m_b1 + lane);
+			const __m128 b2 = _mm_load_ps(m_b2 + lane);
+			const __m128 a1 = _mm_load_ps(m_a1 + lane);
+			const __m128 a2 = _mm_load_ps(m_a2 + lane);
+			const __m128 z1 = _mm_load_ps(m_z1 + lane);
+			const __m128 z2 = _mm_load_ps(m_z2 + lane);
+
+			const __m128 out = _mm_add_ps(_mm_mul_ps(b0, in), z2);
+
+			_mm_store_ps(m_z2 + lane, _mm_sub_ps(_mm_add_ps(_mm_mul_ps(b1, in), z1), _mm_mul_ps(a1, out)));
+			_mm_store_ps(m_z1 + lane, _mm_sub_ps(_mm_mul_ps(b2, in), _mm_mul_ps(a2, out)));
+
+			_mm_storeu_ps(frame + lane, out);
+		}
+#elif defined(__ARM_NEON)
+		// Process 4 lanes per iteration
+		for (int lane = 0; lane < Lanes; lane += 4)
+		{
+			const float32x4_t in = vld1q_f32(frame + lane);
+			const float32x4_t b0 = vld1q_f32(m_b0 + lane);
+			const float32x4_t b1 = vld1q_f32(m_b1 + lane);
+			const float32x4_t b2 = vld1q_f32(m_b2 + lane);
+			const float32x4_t a1 = vld1q_f32(m_a1 + lane);
+			const float32x4_t a2 = vld1q_f32(m_a2 + lane);
+			const float32x4_t z1 = vld1q_f32(m_z1 + lane);
+			const float32x4_t z2 = vld1q_f32(m_z2 + lane);
+
+			const float32x4_t out = vmlaq_f32(z2, b0, in);
+
+			vst1q_f32(m_z2 + lane, vmlsq_f32(vmlaq_f32(z1, b1, in), a1, out));
+			vst1q_f32(m_z1 + lane, vmlsq_f32(vmulq_f32(b2, in), a2, out));
+
+			vst1q_f32(frame + lane, out);
+		}
+#else
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			const float in = frame[lane];
+			const float out = m_b0[lane] * in + m_z2[lane];
+
+			m_z2[lane] = m_b1[lane] * in + m_z1[lane] - m_a1[lane] * out;
+			m_z1[lane] = m_b2[lane] * in - m_a2[lane] * out;
+
+			frame[lane] = out;
+		}
+#endif
+	};
+
+	// Lane i processes buffers[i] in place. Lanes without buffer are fed with silence.
+	inline void processBlock(float* const* buffers, const int buffersCount, const int samples) noexcept
+	{
+		alignas(32) float frame[Lanes] = {};
+		const int count = buffersCount < Lanes ? buffersCount : Lanes;
+
+		for (int sample = 0; sample < samples; sample++)
+		{
+			for (int lane = 0; lane < count; lane++)
+			{
+				frame[lane] = buffers[lane][sample];
+			}
+
+			process(frame);
+
+			for (int lane = 0; lane < count; lane++)
+			{
+				buffers[lane][sample] = frame[lane];
+			}
+
+			// Unused lanes have to stay silent, their output feeds back as input otherwise
+			for (int lane = count; lane < Lanes; lane++)
+			{
+				frame[lane] = 0.0f;
+			}
+		}
+	};
+
+	// Parallel bands: every lane filters the same input, lane i writes to outputs[i]
+	inline void processBlockParallel(const float* input, float* const* outputs, const int outputsCount, const int samples) noexcept
+	{
+		alignas(32) float frame[Lanes] = {};
+		const int count = outputsCount < Lanes ? outputsCount : Lanes;
+
+		for (int sample = 0; sample < samples; sample++)
+		{
+			const float in = input[sample];
+			for (int lane = 0; lane < Lanes; lane++)
+			{
+				frame[lane] = in;
+			}
+
+			process(frame);
+
+			for (int lane = 0; lane < count; lane++)
+			{
+				outputs[lane][sample] = frame[lane];
+			}
+		}
+	};
+
+	// Resets samples history
+	inline void reset() noexcept
+	{
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			m_z1[lane] = 0.0f;
+			m_z2[lane] = 0.0f;
+		}
+	};
+	inline void release() noexcept
+	{
+		reset();
+
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			setCoefficients(lane, BiquadFilter::Coefficients());
+		}
+
+		m_designer.release();
+	};
+
+private:
+	alignas(32) float m_b0[Lanes] = {};
+	alignas(32) float m_b1[Lanes] = {};
+	alignas(32) float m_b2[Lanes] = {};
+	alignas(32) float m_a1[Lanes] = {};
+	alignas(32) float m_a2[Lanes] = {};
+
+	alignas(32) float m_z1[Lanes] = {};
+	alignas(32) float m_z2[Lanes] = {};
+
+	// Only used to calculate coefficients
+	BiquadFilter m_designer;
+};
@@ -26,6 +26,10 @@ public:
 	OnePoleFilter() = default;
 	~OnePoleFilter() = default;
 
+	inline void reset() noexcept
+	{
+		m_sampleLast = 0.0f;
+	};
 	inline void release() noexcept
 	{
 		m_samplePeriod = 0.00002f;
@@ -25,6 +25,7 @@
 
 #include "../../../zazzVSTPlugins/Shared/Filters/BiquadFilters.h"
 #include "../../../zazzVSTPlugins/Shared/Dynamics/EnvelopeFollowers.h"
+#include "../../../zazzVSTPlugins/Shared/Dynamics/MultiLaneEnvelopeFollower.h"
 #include "../../../zazzVSTPlugins/Shared/Utilities/Math.h"
 
 class SpectrumDetectionFFT
@@ -62,7 +63,7 @@ public:
 		const int bucketFrequency = m_sampleRate / FFT_SIZE;
 		m_bucketIndex[0] = 0;
 
-		for (size_t i = 0; i < BANDS_COUNT + 1; i++)
+		for (size_t i = 0; i < BANDS_COUNT; i++)
 		{
 			m_bucketIndex[i + 1] = FILTER_FREQUENCY[i] / bucketFrequency;
 			m_smoother[i].init(sampleRate);
@@ -331,8 +332,9 @@ public:
 		{
 			m_detectionFilter[i].init(sampleRate);
 			m_detectionFilter[i].setBandPassPeakGain(FILTER_FREQUENCY[i], DETECTION_FILTER_Q[i]);
-			m_smoother[i].init(sampleRate);
 		}
+
+		m_smoother.init(sampleRate);
 	}
 	inline void set(const float attackTimeMS, const float releaseTimeMS) noexcept
 	{
@@ -340,20 +342,25 @@ public:
 		for (size_t i = 0; i < BANDS_COUNT; i++)
 		{
 			const float multiplier = 1.0f + (float)(BANDS_COUNT - i - 1) * 0.5f;
-			m_smoother[i].set(multiplier * attackTimeMS, multiplier * releaseTimeMS);
+			m_smoother.set((int)i, multiplier * attackTimeMS, multiplier * releaseTimeMS);
 		}
 	}
 	inline void process(const float in) noexcept
 	{
-		// Get bands RMS
-		float avg = 0.0f;
+		// Get bands RMS, all bands smoothed at once
+		alignas(32) float frame[SMOOTHER_LANES] = {};
 		for (size_t i = 0; i < BANDS_COUNT; i++)
 		{
-			const float filtered = m_detectionFilter[i].processDF1(in);
-			const float filteredSmooth = m_smoother[i].process(filtered);
+			frame[i] = m_detectionFilter[i].processDF1(in);
+		}
 
-			m_spectrumGainsSmooth[i] = filteredSmooth;
-			avg += filteredSmooth;
+		m_smoother.process(frame);
+
+		float avg = 0.0f;
+		for (size_t i = 0; i < BANDS_COUNT; i++)
+		{
+			m_spectrumGainsSmooth[i] = frame[i];
+			avg += frame[i];
 		}
 
 		if (avg > 0.001f)
@@ -381,8 +388,10 @@ public:
 	}
 
 private:
+	static const int SMOOTHER_LANES = 8;
+
 	BiquadFilter m_detectionFilter[BANDS_COUNT];
-	BranchingEnvelopeFollower<float> m_smoother[BANDS_COUNT];
+	MultiLaneEnvelopeFollower<SMOOTHER_LANES> m_smoother;
 
 	float m_spectrumGainsSmooth[BANDS_COUNT]{ 0.0f };
 };
@@ -39,7 +39,7 @@ public:
 		m_bitDepth = bitDepth;
 		m_downSample = downSample;
 
-		m_quantizationLevels = std::exp2f(bitDepth);
+		m_quantizationLevels = std::exp2(bitDepth);
 		m_quantizationStep = 1.0f / m_quantizationLevels;
 
 		m_filter.set(frequency);
@@ -65,8 +65,8 @@ public:
 	inline float processRound(const float in)
 	{
 		//BitCrush
-		float quantizated = std::roundf(in * m_quantizationLevels) * m_quantizationStep;
-		quantizated = std::fabsf(quantizated) < 0.001f ? 0.0f : quantizated;
+		float quantizated = std::round(in * m_quantizationLevels) * m_quantizationStep;
+		quantizated = std::fabs(quantizated) < 0.001f ? 0.0f : quantizated;
 
 		//Filter
 		const float filtered = m_filter.process(quantizated);
@@ -114,7 +114,7 @@ public:
 		m_bitDepth = bitDepth;
 		m_downSample = downSample;
 
-		m_quantizationLevels = 2.0f * std::exp2f(bitDepth);
+		m_quantizationLevels = 2.0f * std::exp2(bitDepth);
 
 		m_roughness = Math::remap(powf(1.0f - drive, 0.2f), 0.0f, 1.0f, 50.0f, 1.5f);
 	}
@@ -149,14 +149,14 @@ private:
 		const float inq = m_quantizationLevels * in;
 
 		// Rescale input to range 0 - 1
-		float inmod = std::fmodf(inq, 1.0f);
+		float inmod = std::fmod(inq, 1.0f);
 		if (inmod < 0.0f)
 		{
 			inmod += 1.0f;  // ensure positive fractional part
 		}
 
 		// Quantize input
-		const int infloor = static_cast<int>(std::floorf(inq));
+		const int infloor = static_cast<int>(std::floor(inq));
 
 		// Create alternating value (0 or 1) - FIXED
 		const float t = static_cast<float>(infloor & 1);
@@ -165,7 +165,7 @@ private:
 		const float exponent = t * m_roughness + (1.0f - t) * (1.0f / m_roughness);
 
 		// Apply power warp
-		const float inpow = std::powf(inmod, exponent);
+		const float inpow = std::pow(inmod, exponent);
 
 		// Rescale and shift back
 		return (inpow + infloor) / m_quantizationLevels;
@@ -50,15 +50,15 @@ public:
 
 		if (inAbs < thresholdHalf)
 		{
-			return std::copysignf(inAbs, in);
+			return std::copysign(inAbs, in);
 		}
 		else if (inAbs < threshold + thresholdHalf)
 		{
-			return std::copysignf(0.5f * (inAbs + thresholdHalf), in);
+			return std::copysign(0.5f * (inAbs + thresholdHalf), in);
 		}
 		else
 		{
-			return std::copysignf(threshold, in);
+			return std::copysign(threshold, in);
 		}
 	}
 	inline static float FoldBack(const float in, float const threshold) noexcept
@@ -512,14 +512,14 @@ public:
 			for (; sample < params.samples; ++sample)
 			{
 				float& in = params.buffer[sample];
-				const float clipped = std::fabsf(in);
+				const float clipped = std::fabs(in);
 				in = clipped > params.threshold ? params.threshold : clipped;
 			}
 #else
 			for (unsigned int sample = 0; sample < params.samples; ++sample)
 			{
 				float& in = params.buffer[sample];
-				const float clipped = std::fabsf(in);
+				const float clipped = std::fabs(in);
 				in = clipped > params.threshold ? params.threshold : clipped;
 			}
 #endif
@@ -552,14 +552,14 @@ public:
 			for (; sample < params.samples; ++sample)
 			{
 				float& in = params.buffer[sample];
-				const float clipped = std::fabsf(in);
+				const float clipped = std::fabs(in);
 				in = clipped > params.threshold ? params.threshold : clipped;
 			}
 #else
 			for (unsigned int sample = 0; sample < params.samples; ++sample)
 			{
 				float& in = params.buffer[sample];
-				const float clipped = std::fabsf(in);
+				const float clipped = std::fabs(in);
 				in = clipped > params.threshold ? params.threshold : clipped;
 			}
 #endif
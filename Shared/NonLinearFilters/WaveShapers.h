@@ -30,7 +30,7 @@ class Waveshapers
 public:
 	inline static float Tanh(const float in, const float drive)
 	{
-		//return std::tanhf(drive * in);
+		//return std::tanh(drive * in);
 
 		// Tanh aproximation for small values
 		const float driveIn = drive * in;
@@ -69,19 +69,19 @@ public:
 	inline static float Reciprocal(float in, float drive)
 	{
 		const float drive2in = 1.4f * drive * in;
-		return drive2in / (1.0f + std::fabsf(drive2in));
+		return drive2in / (1.0f + std::fabs(drive2in));
 	}
 
 	inline static float Reciprocal(const float in, const float drive, const float asymetry)
 	{
 		const float driveIn = 1.4f * drive * in;
-		return driveIn / (1.0f + std::fabsf(driveIn + asymetry));
+		return driveIn / (1.0f + std::fabs(driveIn + asymetry));
 	}
 
 	inline static float Atan(float in, float drive)
 	{
 		constexpr float factor = 1.0f / (0.5f * 3.141592f);
-		return factor * std::atanf(1.7f * drive * in);
+		return factor * std::atan(1.7f * drive * in);
 	}
 
 	inline static float Sin(float in, float drive)
@@ -99,7 +99,7 @@ public:
 		}
 		else
 		{
-			return std::sinf(0.5f * driveAdjusted * in);
+			return std::sin(0.5f * driveAdjusted * in);
 		}
 	}
 	inline static float SinAproximation(float in, float drive)
@@ -153,7 +153,7 @@ public:
 		return 1.5f * in * (1.0f - (1.0f / 3.0f) * (in * in));
 	};
 
-	inline static cubic(float in)
+	inline static float cubic(float in)
 	{
 		return in - (1.0f / 3.0f) * in * in * in;
 	}
@@ -180,21 +180,21 @@ public:
 
 	inline static float Exponential(float in, float drive)
 	{
-		const float driveAdjusted = 0.4f + std::expf(-0.6f * drive);
-		const float inAbs = std::fabsf(in);
-		return std::copysign(std::powf(inAbs, driveAdjusted), in);
+		const float driveAdjusted = 0.4f + std::exp(-0.6f * drive);
+		const float inAbs = std::fabs(in);
+		return std::copysign(std::pow(inAbs, driveAdjusted), in);
 	}
 
 	inline static float Exponential(float in, float drive, const float asymetry)
 	{
-		float driveAdjusted = 0.5f + std::expf(-0.6f * drive);
+		float driveAdjusted = 0.5f + std::exp(-0.6f * drive);
 
 		const float asym = in > 0.0f ? -std::fminf(0.0f, asymetry) : std::fmaxf(0.0f, asymetry);
 
 		driveAdjusted = Math::remap(asym, 0.0f, 1.0f, driveAdjusted, 1.0f);
 
-		const float inAbs = std::fabsf(in);
-		const float out = std::copysign(std::powf(inAbs, driveAdjusted), in);
+		const float inAbs = std::fabs(in);
+		const float out = std::copysign(std::pow(inAbs, driveAdjusted), in);
 
 		return Tanh(out, 1.0f, 0.0f);
 	}
@@ -268,7 +268,7 @@ public:
 		}
 		else if (inAbs < 1.0f)
 		{
-			return std::copysignf(1.0f + ((1.0f - split) * (inAbs - 1.0f)), in);
+			return std::copysign(1.0f + ((1.0f - split) * (inAbs - 1.0f)), in);
 		}
 		else
 		{
@@ -466,7 +466,7 @@ public:
 		}
 		else
 		{
-			return sign * std::powf(-4.0f * inAbs * (0.25f * inAbs - 0.5f), m_shape);
+			return sign * std::pow(-4.0f * inAbs * (0.25f * inAbs - 0.5f), m_shape);
 		}
 	};
 
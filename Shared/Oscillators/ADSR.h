@@ -222,6 +222,6 @@ public:
 									sustainGain,
 									0.0f);
 
-		__super::set(params);
+		Envelope::set(params);
 	};
 };
\ No newline at end of file
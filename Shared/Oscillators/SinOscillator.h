@@ -50,7 +50,7 @@ public:
 			m_phase -= PI2;
 		}
 
-		return std::sinf(m_phase);
+		return std::sin(m_phase);
 	}
 	inline void release() noexcept
 	{
@@ -53,15 +53,16 @@ public:
 
 	static const int DELAY_LINE_COUNT_MAX = 16;
 	static const int DELAY_LINE_LENGHT_MAX_MS = 180;
+	static constexpr int BLOCK_SIZE = 64;
 
 	inline void init(const int sampleRate, const int channel)
 	{
 		m_sampleRate = sampleRate;
 		m_channel = channel;
 		
-		// Set delay line
-		const int size = 0.001f * DELAY_LINE_LENGHT_MAX_MS * sampleRate;
-		__super::init(size);
+		// Set delay line, processBlock() needs one more block of history
+		const int size = 0.001f * DELAY_LINE_LENGHT_MAX_MS * sampleRate + BLOCK_SIZE;
+		CircularBuffer::init(size);
 
 		// Set dissution all-pass filters
 		m_allPassFilter[0].init((int)(0.0021f * (float)sampleRate));
@@ -131,6 +132,44 @@ public:
 
 		return out;
 	};
+	//! Same output as process() for each sample, input and output can be the same buffer
+	inline void processBlock(const float* input, float* output, const int samples) noexcept
+	{
+		float delayed[BLOCK_SIZE];
+		float sum[BLOCK_SIZE];
+
+		for (int start = 0; start < samples; start += BLOCK_SIZE)
+		{
+			const int count = std::min(BLOCK_SIZE, samples - start);
+			const float* in = input + start;
+
+			// Handle diffusion
+			for (int i = 0; i < count; i++)
+			{
+				const float diffused = m_allPassFilter[0].process(m_allPassFilter[1].process(in[i]));
+				delayed[i] = m_params.diffusion * diffused + (1.0f - m_params.diffusion) * in[i];
+			}
+
+			writeBlock(delayed, count);
+			std::fill(sum, sum + count, 0.0f);
+
+			// Read all delay tabs, one contiguous block per tap
+			for (int tap = 0; tap < m_delayLineCount; tap++)
+			{
+				readDelayBlock(m_delayTimeSamples[tap], delayed, count);
+
+				auto& dampingFilter = m_dampingFilter[tap];
+				const float gain = m_delayLineGain[tap];
+
+				for (int i = 0; i < count; i++)
+				{
+					sum[i] += gain * dampingFilter.process(delayed[i]);
+				}
+			}
+
+			std::memcpy(output + start, sum, count * sizeof(float));
+		}
+	};
 
 private:
 	OnePoleLowPassFilter m_dampingFilter[DELAY_LINE_COUNT_MAX];
@@ -0,0 +1,397 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+#endif
+
+#include <cmath>
+
+#include "../../../zazzVSTPlugins/Shared/Utilities/CircularBuffers.h"
+
+//==============================================================================
+// Feedback delay network with 8, 16, 32 or 64 delay lines.
+// Line states (damping filters, gains) are stored as structure of arrays, one lane per line.
+// Damping, feedback and Hadamard / Householder mixing use AVX, SSE or NEON with scalar fallback.
+// Delay lines are read and written in blocks up to the shortest delay line length.
+//
+// Per sample:	y = lowPass(delayed)
+//				out = sum(y)
+//				delayLine <- inputGain * in + feedback * mix(y)
+template <int Lines>
+class FeedbackDelayNetwork
+{
+	static_assert(Lines == 8 || Lines == 16 || Lines == 32 || Lines == 64, "FeedbackDelayNetwork supports 8, 16, 32 or 64 lines");
+
+public:
+	FeedbackDelayNetwork() = default;
+	~FeedbackDelayNetwork() = default;
+
+	static constexpr int LINES = Lines;
+	static constexpr int BLOCK_SIZE_MAX = 32;
+
+	enum class Mixing
+	{
+		Hadamard,		// Fast Walsh-Hadamard transform, N log N
+		Householder		// I - 2/N, N
+	};
+
+	// Maximum delay line sizes in samples, one per line.
+	// A line of size N delays by N + 1 samples, same as CircularBuffer read() before write().
+	inline void init(const int sampleRate, const int* maximumSizes)
+	{
+		m_samplePeriod = 1.0f / (float)sampleRate;
+
+		for (int line = 0; line < Lines; line++)
+		{
+			m_maximumSize[line] = std::max(1, maximumSizes[line]);
+			m_delayLines[line].init(m_maximumSize[line] + 1);
+			m_size[line] = m_maximumSize[line];
+		}
+
+		reset();
+	};
+	inline void setSize(const int line, const int size) noexcept
+	{
+		m_size[line] = std::clamp(size, 1, m_maximumSize[line]);
+	};
+	inline void setInputGain(const int line, const float gain) noexcept
+	{
+		m_inputGain[line] = gain;
+	};
+	// Same as OnePoleLowPassFilter::set()
+	inline void setDampingFrequency(const int line, const float frequency) noexcept
+	{
+		m_dampingA0[line] = frequency * juce::MathConstants<float>::pi * m_samplePeriod;
+	};
+	inline void setFeedback(const float feedback) noexcept
+	{
+		m_feedback = feedback;
+	};
+	inline void setMixing(const Mixing mixing) noexcept
+	{
+		m_mixing = mixing;
+	};
+
+	// Input and output can be the same buffer
+	inline void process(const float* input, float* output, const int samples) noexcept
+	{
+		// Reads of a block must not depend on writes of the same block
+		int blockSize = BLOCK_SIZE_MAX;
+		for (int line = 0; line < Lines; line++)
+		{
+			blockSize = std::min(blockSize, m_size[line]);
+		}
+
+		// Hadamard mixing is scaled by 1 / sqrt(N) to stay orthogonal
+		const float feedback = m_mixing == Mixing::Hadamard ? m_feedback / std::sqrt((float)Lines) : m_feedback;
+
+		for (int start = 0; start < samples; start += blockSize)
+		{
+			const int count = std::min(blockSize, samples - start);
+
+			// Samples written size + 1 samples ago, read before the block is written
+			for (int line = 0; line < Lines; line++)
+			{
+				m_delayLines[line].readDelayBlock(m_size[line] + 1 - count, m_lineBlock[line], count);
+			}
+			transpose(count, false);
+
+			for (int sample = 0; sample < count; sample++)
+			{
+				float* frame = m_frames[sample];
+				const float in = input[start + sample];
+
+				output[start + sample] = damp(frame);
+
+				if (m_mixing == Mixing::Hadamard)
+				{
+					hadamard(frame);
+				}
+				else
+				{
+					householder(frame);
+				}
+
+				feed(frame, in, feedback);
+			}
+
+			transpose(count, true);
+			for (int line = 0; line < Lines; line++)
+			{
+				m_delayLines[line].writeBlock(m_lineBlock[line], count);
+			}
+		}
+	};
+	inline void reset() noexcept
+	{
+		for (int line = 0; line < Lines; line++)
+		{
+			m_dampingState[line] = 0.0f;
+		}
+	};
+	inline void release()
+	{
+		for (auto& delayLine : m_delayLines)
+		{
+			delayLine.release();
+		}
+
+		reset();
+	};
+
+private:
+	// Line blocks to frames and back
+	inline void transpose(const int count, const bool toLines) noexcept
+	{
+		for (int line = 0; line < Lines; line++)
+		{
+			for (int sample = 0; sample < count; sample++)
+			{
+				if (toLines)
+				{
+					m_lineBlock[line][sample] = m_frames[sample][line];
+				}
+				else
+				{
+					m_frames[sample][line] = m_lineBlock[line][sample];
+				}
+			}
+		}
+	};
+
+	// One-pole low-pass per line in place, returns sum of all lines
+	inline float damp(float* frame) noexcept
+	{
+#if defined(__AVX__)
+		__m256 sum8 = _mm256_setzero_ps();
+		for (int line = 0; line < Lines; line += 8)
+		{
+			const __m256 in = _mm256_load_ps(frame + line);
+			const __m256 a0 = _mm256_load_ps(m_dampingA0 + line);
+			const __m256 state = _mm256_load_ps(m_dampingState + line);
+
+			const __m256 out = _mm256_add_ps(_mm256_mul_ps(a0, _mm256_sub_ps(in, state)), state);
+
+			_mm256_store_ps(m_dampingState + line, out);
+			_mm256_store_ps(frame + line, out);
+			sum8 = _mm256_add_ps(sum8, out);
+		}
+
+		const __m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+		return horizontalSum(sum);
+#elif JUCE_USE_SSE_INTRINSICS
+		__m128 sum = _mm_setzero_ps();
+		for (int line = 0; line < Lines; line += 4)
+		{
+			const __m128 in = _mm_load_ps(frame + line);
+			const __m128 a0 = _mm_load_ps(m_dampingA0 + line);
+			const __m128 state = _mm_load_ps(m_dampingState + line);
+
+			const __m128 out = _mm_add_ps(_mm_mul_ps(a0, _mm_sub_ps(in, state)), state);
+
+			_mm_store_ps(m_dampingState + line, out);
+			_mm_store_ps(frame + line, out);
+			sum = _mm_add_ps(sum, out);
+		}
+
+		return horizontalSum(sum);
+#elif JUCE_USE_ARM_NEON
+		float32x4_t sum = vdupq_n_f32(0.0f);
+		for (int line = 0; line < Lines; line += 4)
+		{
+			const float32x4_t in = vld1q_f32(frame + line);
+			const float32x4_t a0 = vld1q_f32(m_dampingA0 + line);
+			const float32x4_t state = vld1q_f32(m_dampingState + line);
+
+			const float32x4_t out = vmlaq_f32(state, a0, vsubq_f32(in, state));
+
+			vst1q_f32(m_dampingState + line, out);
+			vst1q_f32(frame + line, out);
+			sum = vaddq_f32(sum, out);
+		}
+
+		const float32x2_t sum2 = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+		return vget_lane_f32(vpadd_f32(sum2, sum2), 0);
+#else
+		float sum = 0.0f;
+		for (int line = 0; line < Lines; line++)
+		{
+			const float out = m_dampingA0[line] * (frame[line] - m_dampingState[line]) + m_dampingState[line];
+
+			m_dampingState[line] = out;
+			frame[line] = out;
+			sum += out;
+		}
+
+		return sum;
+#endif
+	};
+
+	// Unnormalized Walsh-Hadamard transform in place
+	inline void hadamard(float* frame) noexcept
+	{
+#if JUCE_USE_SSE_INTRINSICS
+		// Butterflies with h = 1 and h = 2 inside of each register
+		const __m128 sign1 = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+		const __m128 sign2 = _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f);
+
+		for (int line = 0; line < Lines; line += 4)
+		{
+			__m128 x = _mm_load_ps(frame + line);
+			x = _mm_add_ps(_mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)), _mm_mul_ps(x, sign1));
+			x = _mm_add_ps(_mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 3, 2)), _mm_mul_ps(x, sign2));
+			_mm_store_ps(frame + line, x);
+		}
+
+		// Butterflies with h >= 4 between registers
+		for (int h = 4; h < Lines; h *= 2)
+		{
+			for (int i = 0; i < Lines; i += 2 * h)
+			{
+				for (int j = i; j < i + h; j += 4)
+				{
+					const __m128 x = _mm_load_ps(frame + j);
+					const __m128 y = _mm_load_ps(frame + j + h);
+					_mm_store_ps(frame + j, _mm_add_ps(x, y));
+					_mm_store_ps(frame + j + h, _mm_sub_ps(x, y));
+				}
+			}
+		}
+#elif JUCE_USE_ARM_NEON
+		const float sign1Data[4] = { 1.0f, -1.0f, 1.0f, -1.0f };
+		const float sign2Data[4] = { 1.0f, 1.0f, -1.0f, -1.0f };
+		const float32x4_t sign1 = vld1q_f32(sign1Data);
+		const float32x4_t sign2 = vld1q_f32(sign2Data);
+
+		for (int line = 0; line < Lines; line += 4)
+		{
+			float32x4_t x = vld1q_f32(frame + line);
+			x = vmlaq_f32(vrev64q_f32(x), x, sign1);
+			x = vmlaq_f32(vextq_f32(x, x, 2), x, sign2);
+			vst1q_f32(frame + line, x);
+		}
+
+		for (int h = 4; h < Lines; h *= 2)
+		{
+			for (int i = 0; i < Lines; i += 2 * h)
+			{
+				for (int j = i; j < i + h; j += 4)
+				{
+					const float32x4_t x = vld1q_f32(frame + j);
+					const float32x4_t y = vld1q_f32(frame + j + h);
+					vst1q_f32(frame + j, vaddq_f32(x, y));
+					vst1q_f32(frame + j + h, vsubq_f32(x, y));
+				}
+			}
+		}
+#else
+		for (int h = 1; h < Lines; h *= 2)
+		{
+			for (int i = 0; i < Lines; i += 2 * h)
+			{
+				for (int j = i; j < i + h; j++)
+				{
+					const float x = frame[j];
+					const float y = frame[j + h];
+					frame[j] = x + y;
+					frame[j + h] = x - y;
+				}
+			}
+		}
+#endif
+	};
+
+	// Householder reflection, x - 2 / N * sum(x)
+	inline void householder(float* frame) noexcept
+	{
+		float sum = 0.0f;
+		for (int line = 0; line < Lines; line++)
+		{
+			sum += frame[line];
+		}
+
+		const float offset = (2.0f / (float)Lines) * sum;
+		for (int line = 0; line < Lines; line++)
+		{
+			frame[line] -= offset;
+		}
+	};
+
+	// Next delay lines input, inputGain * in + feedback * frame
+	inline void feed(float* frame, const float in, const float feedback) noexcept
+	{
+#if defined(__AVX__)
+		const __m256 in8 = _mm256_set1_ps(in);
+		const __m256 feedback8 = _mm256_set1_ps(feedback);
+		for (int line = 0; line < Lines; line += 8)
+		{
+			const __m256 gain = _mm256_load_ps(m_inputGain + line);
+			const __m256 x = _mm256_load_ps(frame + line);
+			_mm256_store_ps(frame + line, _mm256_add_ps(_mm256_mul_ps(gain, in8), _mm256_mul_ps(feedback8, x)));
+		}
+#elif JUCE_USE_SSE_INTRINSICS
+		const __m128 in4 = _mm_set1_ps(in);
+		const __m128 feedback4 = _mm_set1_ps(feedback);
+		for (int line = 0; line < Lines; line += 4)
+		{
+			const __m128 gain = _mm_load_ps(m_inputGain + line);
+			const __m128 x = _mm_load_ps(frame + line);
+			_mm_store_ps(frame + line, _mm_add_ps(_mm_mul_ps(gain, in4), _mm_mul_ps(feedback4, x)));
+		}
+#elif JUCE_USE_ARM_NEON
+		const float32x4_t in4 = vdupq_n_f32(in);
+		for (int line = 0; line < Lines; line += 4)
+		{
+			const float32x4_t gain = vld1q_f32(m_inputGain + line);
+			const float32x4_t x = vld1q_f32(frame + line);
+			vst1q_f32(frame + line, vmlaq_n_f32(vmulq_f32(gain, in4), x, feedback));
+		}
+#else
+		for (int line = 0; line < Lines; line++)
+		{
+			frame[line] = m_inputGain[line] * in + feedback * frame[line];
+		}
+#endif
+	};
+
+#if JUCE_USE_SSE_INTRINSICS
+	static inline float horizontalSum(const __m128 x) noexcept
+	{
+		const __m128 sum2 = _mm_add_ps(x, _mm_movehl_ps(x, x));
+		return _mm_cvtss_f32(_mm_add_ss(sum2, _mm_shuffle_ps(sum2, sum2, _MM_SHUFFLE(1, 1, 1, 1))));
+	};
+#endif
+
+	CircularBuffer m_delayLines[Lines];
+
+	alignas(32) float m_frames[BLOCK_SIZE_MAX][Lines] = {};
+	alignas(32) float m_lineBlock[Lines][BLOCK_SIZE_MAX] = {};
+
+	alignas(32) float m_inputGain[Lines] = {};
+	alignas(32) float m_dampingA0[Lines] = {};
+	alignas(32) float m_dampingState[Lines] = {};
+
+	int m_size[Lines] = {};
+	int m_maximumSize[Lines] = {};
+
+	float m_samplePeriod = 1.0f / 48000.0f;
+	float m_feedback = 0.0f;
+	Mixing m_mixing = Mixing::Hadamard;
+};
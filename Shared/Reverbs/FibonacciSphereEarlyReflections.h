@@ -1,6 +1,7 @@
 #pragma once
 
 #include <immintrin.h>
+#include <algorithm>
 #include <vector>
 #include <math.h>
 
@@ -12,47 +13,78 @@
 #define M_PI  3.14159268f
 #define SPEED_OF_SOUND 343.0f
 
+// Reflections are sorted by delay, reflections with damping frequencies in the same
+// DAMPING_GROUP_RATIO wide band share that band's damping filter. Bands are fixed, so a filter
+// keeps serving the same frequency range when reflections move between bands.
+// All storage is allocated in init(), set() does not allocate and recomputes geometry
+// only if room or listener changed.
 class FibonacciSphereEarlyReflections : CircularBuffer
 {
 public:
 	FibonacciSphereEarlyReflections() {};
 
+	static constexpr int BLOCK_SIZE = 64;
+
+	// 1/12 octave, band filter response is within 0.25 dB of each reflection filter
+	static constexpr float DAMPING_GROUP_RATIO = 1.0595f;
+
+	// Lowest damping filter frequency, reached at full damping by the farthest reflections
+	static constexpr float DAMPING_FREQUENCY_MIN = 500.0f;
+
 	void init(float maximumDimension, int sampleRate, int reflectionsCountMax)
-	{	
-		m_sampleRate = sampleRate;	
-		m_maximumDelayTime =  2.0f * maximumDimension * std::sqrtf(3.0f) / SPEED_OF_SOUND;
-		
+	{
+		m_sampleRate = sampleRate;
+		m_maximumDelayTime =  2.0f * maximumDimension * std::sqrt(3.0f) / SPEED_OF_SOUND;
+		m_reflectionsCountMax = reflectionsCountMax;
+
+		// Block processing writes up to BLOCK_SIZE samples before reading the longest delay
 		const int maximumDelayTimeSamples = (int)(m_maximumDelayTime * sampleRate);
-		__super::init(maximumDelayTimeSamples);
+		CircularBuffer::init(maximumDelayTimeSamples + BLOCK_SIZE);
 
+		m_points.resize(reflectionsCountMax);
+		m_rayDistances.resize(reflectionsCountMax);
+		m_distances.resize(reflectionsCountMax);
+		m_order.resize(reflectionsCountMax);
+		m_frequencies.resize(reflectionsCountMax);
 		m_gains.resize(reflectionsCountMax);
 		m_delayTimesSamples.resize(reflectionsCountMax);
-
-		m_dampingFilters.resize(reflectionsCountMax);
+		m_groupEnd.resize(reflectionsCountMax);
+		m_groupBand.resize(reflectionsCountMax);
 
 		const int sampleRateHalf = sampleRate / 2;
 		m_maximumFilterFrequency = (sampleRateHalf < 18000) ? (float)sampleRateHalf : 18000.0f;
 
-		for (int i = 0; i < reflectionsCountMax; i++)
+		// Band b is centred at maximum filter frequency / ratio^b, undamped reflections use band 0
+		m_inverseLogRatio = 1.0f / std::log(DAMPING_GROUP_RATIO);
+		m_bandsCount = 1 + std::max(0, (int)(std::log(m_maximumFilterFrequency / DAMPING_FREQUENCY_MIN) * m_inverseLogRatio + 0.5f));
+
+		m_dampingFilters.resize(m_bandsCount);
+		m_bandActive.assign(m_bandsCount, false);
+
+		for (int band = 0; band < m_bandsCount; band++)
 		{
-			m_dampingFilters[i].init(sampleRate);
+			m_dampingFilters[band].init(sampleRate);
+			m_dampingFilters[band].set(m_maximumFilterFrequency / std::pow(DAMPING_GROUP_RATIO, (float)band));
 		}
 
+		m_pointsCount = 0;
+		m_groupsCount = 0;
+		m_geometryValid = false;
 	};
 	void set(float roomLenght, float roomWidth, float roomHeightMax, float damping, Point3D listenerPosition, int reflectionsCount)
 	{
+		reflectionsCount = std::min(reflectionsCount, m_reflectionsCountMax);
 		m_reflectionsCount = reflectionsCount;
-		std::vector<float> distances;
-		distances.resize(reflectionsCount);
 
-		Math3D::GetDistances(distances, roomLenght, roomWidth, roomHeightMax, listenerPosition, reflectionsCount);
+		updateGeometry(roomLenght, roomWidth, roomHeightMax, listenerPosition, reflectionsCount);
 
-		const float frequency2 = m_maximumFilterFrequency - 500.0f;
+		const float frequency2 = m_maximumFilterFrequency - DAMPING_FREQUENCY_MIN;
 
+		// m_distances is sorted, so frequencies only go down
 		for (int i = 0; i < reflectionsCount; i++)
 		{
 			// Set reflections times in samples
-			const float distance = 2.0f * distances[i];
+			const float distance = 2.0f * m_distances[i];
 			const float time = distance / SPEED_OF_SOUND;
 			m_delayTimesSamples[i] = (int)(m_sampleRate * time);
 
@@ -64,31 +96,183 @@ public:
 			// TODO: Find better way to calculate filter frequency
 			const float distanceFactor = 0.15f * damping;
 			const float frequencyFactor = std::fminf(1.0f, distanceFactor * distance);
-			const float frequency = m_maximumFilterFrequency - damping * frequencyFactor * frequency2;
-			m_dampingFilters[i].set(frequency);
+			m_frequencies[i] = m_maximumFilterFrequency - damping * frequencyFactor * frequency2;
+		}
+
+		// Group neighbouring reflections in the same band, frequencies only go down so bands only go up
+		m_groupsCount = 0;
+
+		for (int i = 0; i < reflectionsCount; i++)
+		{
+			const int band = getBand(m_frequencies[i]);
+			if (m_groupsCount == 0 || m_groupBand[m_groupsCount - 1] != band)
+			{
+				m_groupBand[m_groupsCount] = band;
+				m_groupsCount++;
+			}
+
+			m_groupEnd[m_groupsCount - 1] = i + 1;
+		}
+
+		// Filters of bands without reflections are not processed, with zero input
+		// their state would have decayed, so newly used bands start from zero
+		for (int group = 0; group < m_groupsCount; group++)
+		{
+			if (!m_bandActive[m_groupBand[group]])
+			{
+				m_dampingFilters[m_groupBand[group]].reset();
+			}
+		}
+
+		std::fill(m_bandActive.begin(), m_bandActive.end(), false);
+		for (int group = 0; group < m_groupsCount; group++)
+		{
+			m_bandActive[m_groupBand[group]] = true;
 		}
 	};
 	float process(float sample)
 	{
 		float out = 0.0f;
 
-		writeSample(sample);
+		write(sample);
 
-		for (int i = 0; i < m_reflectionsCount; i++)
+		// Two partial sums, taps are not waiting for each other
+		int i = 0;
+		for (int group = 0; group < m_groupsCount; group++)
 		{
-			out += m_gains[i] * m_dampingFilters[i].process(readDelay(m_delayTimesSamples[i]));
+			const int groupEnd = m_groupEnd[group];
+			float sum1 = 0.0f;
+			float sum2 = 0.0f;
+
+			for (; i + 1 < groupEnd; i += 2)
+			{
+				sum1 += m_gains[i] * readDelay(m_delayTimesSamples[i]);
+				sum2 += m_gains[i + 1] * readDelay(m_delayTimesSamples[i + 1]);
+			}
+			if (i < groupEnd)
+			{
+				sum1 += m_gains[i] * readDelay(m_delayTimesSamples[i]);
+				i++;
+			}
+
+			out += m_dampingFilters[m_groupBand[group]].process(sum1 + sum2);
 		}
-		
+
 		return out;
 	};
+	// Same as process(sample) for each sample, input and output can be the same buffer
+	void process(const float* input, float* output, const int samples)
+	{
+		float sum[BLOCK_SIZE];
+		float out[BLOCK_SIZE];
+
+		for (int start = 0; start < samples; start += BLOCK_SIZE)
+		{
+			const int count = std::min(BLOCK_SIZE, samples - start);
+
+			writeBlock(input + start, count);
+			std::fill(out, out + count, 0.0f);
+
+			int i = 0;
+			for (int group = 0; group < m_groupsCount; group++)
+			{
+				std::fill(sum, sum + count, 0.0f);
+				for (const int groupEnd = m_groupEnd[group]; i < groupEnd; i++)
+				{
+					addDelayBlock(m_delayTimesSamples[i], m_gains[i], sum, count);
+				}
+
+				auto& dampingFilter = m_dampingFilters[m_groupBand[group]];
+				for (int sample = 0; sample < count; sample++)
+				{
+					out[sample] += dampingFilter.process(sum[sample]);
+				}
+			}
+
+			std::copy(out, out + count, output + start);
+		}
+	};
+	int getDampingFiltersCount() const
+	{
+		return m_groupsCount;
+	};
 
 private:
+	inline int getBand(const float frequency) const
+	{
+		const int band = (int)(std::log(m_maximumFilterFrequency / frequency) * m_inverseLogRatio + 0.5f);
+		return std::max(0, std::min(band, m_bandsCount - 1));
+	};
+
+	// Distances from room centre to walls along Fibonacci sphere rays, sorted
+	void updateGeometry(float roomLenght, float roomWidth, float roomHeightMax, Point3D listenerPosition, int reflectionsCount)
+	{
+		if (m_geometryValid &&
+			m_roomLenght == roomLenght && m_roomWidth == roomWidth && m_roomHeight == roomHeightMax &&
+			m_listenerPosition.x == listenerPosition.x && m_listenerPosition.y == listenerPosition.y && m_listenerPosition.z == listenerPosition.z &&
+			m_pointsCount == reflectionsCount)
+		{
+			return;
+		}
+
+		// Sphere points depend on count only
+		if (m_pointsCount != reflectionsCount)
+		{
+			Math3D::CreateFibonacciSphere(m_points.data(), reflectionsCount);
+			m_pointsCount = reflectionsCount;
+		}
+
+		Math3D::GetDistances(m_rayDistances.data(), m_points.data(), roomLenght, roomWidth, roomHeightMax, listenerPosition, reflectionsCount);
+
+		for (int i = 0; i < reflectionsCount; i++)
+		{
+			m_order[i] = i;
+		}
+
+		const float* distances = m_rayDistances.data();
+		std::sort(m_order.begin(), m_order.begin() + reflectionsCount, [distances](const int a, const int b)
+		{
+			return distances[a] < distances[b] || (distances[a] == distances[b] && a < b);
+		});
+
+		for (int i = 0; i < reflectionsCount; i++)
+		{
+			m_distances[i] = distances[m_order[i]];
+		}
+
+		m_roomLenght = roomLenght;
+		m_roomWidth = roomWidth;
+		m_roomHeight = roomHeightMax;
+		m_listenerPosition = listenerPosition;
+		m_geometryValid = true;
+	};
+
 	std::vector<OnePoleLowPassFilter> m_dampingFilters;
 	std::vector<float> m_gains = {};
 	std::vector<int> m_delayTimesSamples = {};
+	std::vector<float> m_frequencies = {};
+	std::vector<int> m_groupEnd = {};
+	std::vector<int> m_groupBand = {};
+	std::vector<bool> m_bandActive = {};
+
+	// Geometry cache
+	std::vector<Point3D> m_points = {};
+	std::vector<float> m_rayDistances = {};
+	std::vector<float> m_distances = {};
+	std::vector<int> m_order = {};
+	Point3D m_listenerPosition;
+	float m_roomLenght = 0.0f;
+	float m_roomWidth = 0.0f;
+	float m_roomHeight = 0.0f;
+	int m_pointsCount = 0;
+	bool m_geometryValid = false;
+
 	float m_maximumDelayTime = 0.0f;
 	float m_maximumFilterFrequency = 0.0f;
 	int m_sampleRate = 48000;
 	int m_reflectionsCount = 0;
 	int m_reflectionsCountMax = 0;
-};
\ No newline at end of file
+	int m_groupsCount = 0;
+	int m_bandsCount = 1;
+	float m_inverseLogRatio = 0.0f;
+};
@@ -0,0 +1,468 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+#endif
+
+#include <cmath>
+#include <cstring>
+
+#include "../../../zazzVSTPlugins/Shared/Reverbs/SmallRoomReverb.h"
+
+//==============================================================================
+// 4 or 8 SmallRoomReverb instances processed together, one lane per channel.
+// Early reflection taps and allpasses have no feedback shorter than a block,
+// so they run on whole blocks of each lane's own delay line. The recursive
+// damping filters keep SoA state and run over all lanes at once, 4 / 8 wide.
+//
+// Each lane has decorrelation variation. Variations 0 - 4 match SmallRoomReverb
+// channels 0 - 4, variations 5 - 9 use the same patterns with opposite sign,
+// so 7.1.4 beds can run as two instances without repeating any pattern.
+template <int Lanes>
+class MultiLaneSmallRoomReverb
+{
+	static_assert(Lanes == 4 || Lanes == 8, "MultiLaneSmallRoomReverb supports 4 or 8 lanes");
+
+public:
+	MultiLaneSmallRoomReverb() = default;
+	~MultiLaneSmallRoomReverb() = default;
+
+	static constexpr int LANES = Lanes;
+	static constexpr int VARIATIONS = 10;
+	static constexpr int BLOCK_SIZE = 64;
+	static constexpr int N_ALLPASSES = SmallRoomReverb::N_ALLPASSES;
+	static constexpr int N_REFLECTIONS = RoomEarlyReflectionsSimple::N_DELAY_LINES;
+
+	// variations has to hold Lanes values, nullptr uses variation = lane
+	inline void init(const int sampleRate, const int* variations = nullptr)
+	{
+		m_sampleRateMS = 0.001f * (float)sampleRate;
+		m_samplePeriod = 1.0f / static_cast<float>(sampleRate);
+
+		// Early reflections delays wrap at the same size as in SmallRoomReverb,
+		// buffer has room for one more block on top of that.
+		// Mirrored variations make allpasses up to (1 + G3) times longer.
+		const int ERsize = getPowerOfTwo((int)((float)sampleRate * 0.001f * 80.0f));
+		m_ERdelayMask = ERsize - 1;
+
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			m_variation[lane] = (variations != nullptr ? variations[lane] : lane) % VARIATIONS;
+			m_earlyReflections[lane].init(ERsize + BLOCK_SIZE);
+
+			for (int allpass = 0; allpass < N_ALLPASSES; allpass++)
+			{
+				const int size = SmallRoomReverb::BUFFER_MINIMUM_SIZE + 2 + (int)((1.0f + SmallRoomReverb::G3) * SmallRoomReverb::ALLPASS_DELAY_TIMES_MS[allpass] * m_sampleRateMS);
+				m_allpass[allpass][lane].init(size);
+			}
+		}
+
+		reset();
+	}
+	inline void set(const float earlyReflectionsPredelay, const float earlyReflectionsSize, const float earlyReflectionsDamping, const float earlyReflectionsWidth, const float earlyReflectionsGain,
+					const float lateReflectionsPredelay, const float lateReflectionsSize, const float lateReflectionsDamping, const float lateReflectionsWidth, const float lateReflectionsGain) noexcept
+	{
+		m_ERgain = earlyReflectionsGain;
+		const float LRgainCompensation = juce::Decibels::decibelsToGain(6.0f);
+		m_LRgain = lateReflectionsGain * LRgainCompensation;
+
+		// Set early reflections
+		const int predelaySize = (int)(m_sampleRateMS * earlyReflectionsPredelay);
+		const int reflectionsSize = (int)(Math::remap(earlyReflectionsSize, 0.0f, 1.0f, 5.0f, 60.0f) * m_sampleRateMS);
+		const float ERwidth = earlyReflectionsWidth * earlyReflectionsWidth;
+
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			const int variation = m_variation[lane];
+			const auto& WIDTH_VARIATION = RoomEarlyReflectionsSimple::WIDTH[variation % 5];
+			const float sign = variation < 5 ? 1.0f : -1.0f;
+
+			for (int i = 0; i < N_REFLECTIONS; i++)
+			{
+				const int delay = static_cast<int>(predelaySize + reflectionsSize * (RoomEarlyReflectionsSimple::delayTimesFactor[i] + ERwidth * sign * WIDTH_VARIATION[i]));
+				m_ERdelay[lane][i] = delay & m_ERdelayMask;
+			}
+		}
+
+		// Set late reflections
+		m_LRPredelaySize = (1 + (int)(m_sampleRateMS * lateReflectionsPredelay)) & m_ERdelayMask;
+
+		const auto timeFactor = (0.05f + 0.95f * lateReflectionsSize) * m_sampleRateMS;
+		const auto LRwidth = lateReflectionsWidth * lateReflectionsWidth * lateReflectionsWidth;
+		m_allpassMinimumDelay = BLOCK_SIZE;
+
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			const int variation = m_variation[lane];
+			const auto& WIDTH_VARIATION = SmallRoomReverb::ALLPASS_DELAY_WIDTH[variation % 5];
+			const float sign = variation < 5 ? 1.0f : -1.0f;
+
+			for (int allpass = 0; allpass < N_ALLPASSES; allpass++)
+			{
+				// AllPassFilter2 reads before write, feedback loop is one sample longer than its size
+				const int delay = 1 + SmallRoomReverb::BUFFER_MINIMUM_SIZE + (int)(timeFactor * SmallRoomReverb::ALLPASS_DELAY_TIMES_MS[allpass] * (1.0f - LRwidth * sign * WIDTH_VARIATION[allpass]));
+				m_allpassDelay[lane][allpass] = delay;
+				m_allpassMinimumDelay = std::min(m_allpassMinimumDelay, delay);
+			}
+		}
+
+		// Set damping filters, same as LowPassBiquadFilter::set() and OnePoleLowPassFilter::setCoef()
+		const auto ERdamping = sqrtf(earlyReflectionsDamping);
+		const float ERDampingFrequency = 16000.0f - ERdamping * 14000.0f;
+		const float ERDampingQ = 0.707f - ERdamping * 0.207;
+
+		const float omega = M_PI2 * ERDampingFrequency * m_samplePeriod;
+		const float sn = sin(omega);
+		const float cs = cos(omega);
+		const float alpha = sn / (2.0f * ERDampingQ);
+
+		const float normalize = 1.0f / (1.0f + alpha);
+		m_ERb1 = (1.0f - cs) * normalize;
+		m_ERb0 = 0.5f * m_ERb1;
+		m_ERa1 = (2.0f * cs) * normalize;
+		m_ERa2 = (alpha - 1.0f) * normalize;
+
+		m_LRa0 = 1.0f - 0.9f * lateReflectionsDamping;
+	}
+
+	// Lane i processes buffers[i] in place. Lanes without buffer are skipped.
+	inline void process(float* const* buffers, const int buffersCount, const int samples) noexcept
+	{
+		const int count = buffersCount < Lanes ? buffersCount : Lanes;
+
+		for (int start = 0; start < samples; start += BLOCK_SIZE)
+		{
+			const int blockSamples = std::min(BLOCK_SIZE, samples - start);
+			processBlock(buffers, count, start, blockSamples);
+		}
+	}
+	inline void reset() noexcept
+	{
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			m_ERx1[lane] = 0.0f;
+			m_ERx2[lane] = 0.0f;
+			m_ERy1[lane] = 0.0f;
+			m_ERy2[lane] = 0.0f;
+			m_LRlast[lane] = 0.0f;
+		}
+	}
+	inline void release() noexcept
+	{
+		reset();
+
+		for (int lane = 0; lane < Lanes; lane++)
+		{
+			m_earlyReflections[lane].release();
+
+			for (int allpass = 0; allpass < N_ALLPASSES; allpass++)
+			{
+				m_allpass[allpass][lane].release();
+			}
+
+			m_variation[lane] = 0;
+		}
+
+		m_ERb0 = 0.0f;
+		m_ERb1 = 0.0f;
+		m_ERa1 = 0.0f;
+		m_ERa2 = 0.0f;
+		m_LRa0 = 0.0f;
+
+		m_sampleRateMS = 48.0f;
+		m_samplePeriod = 2.08e-5f;
+		m_ERgain = 1.0f;
+		m_LRgain = 1.0f;
+		m_ERdelayMask = 0;
+		m_LRPredelaySize = 0;
+		m_allpassMinimumDelay = 1;
+	}
+
+private:
+	static inline int getPowerOfTwo(const int size) noexcept
+	{
+		int n = 1;
+		while (n < size)
+		{
+			n <<= 1;
+		}
+
+		return n;
+	}
+
+	inline void processBlock(float* const* buffers, const int count, const int start, const int samples) noexcept
+	{
+		alignas(32) float ER[Lanes][BLOCK_SIZE];
+		alignas(32) float LR[Lanes][BLOCK_SIZE];
+		alignas(32) float ERframes[BLOCK_SIZE][Lanes];
+		alignas(32) float LRframes[BLOCK_SIZE][Lanes];
+		alignas(32) float tap[BLOCK_SIZE];
+
+		// Early reflections taps and late reflections predelay, whole block per lane
+		for (int lane = 0; lane < count; lane++)
+		{
+			auto& earlyReflections = m_earlyReflections[lane];
+			earlyReflections.writeBlock(buffers[lane] + start, samples);
+
+			float* ERlane = ER[lane];
+			std::fill(ERlane, ERlane + samples, 0.0f);
+
+			for (int i = 0; i < N_REFLECTIONS; i++)
+			{
+				earlyReflections.addDelayBlock(m_ERdelay[lane][i], RoomEarlyReflectionsSimple::delayGains[i], ERlane, samples);
+			}
+
+			earlyReflections.readDelayBlock(m_LRPredelaySize, LR[lane], samples);
+		}
+
+		// Damping filters, all lanes per sample
+		for (int sample = 0; sample < samples; sample++)
+		{
+			for (int lane = 0; lane < count; lane++)
+			{
+				ERframes[sample][lane] = ER[lane][sample];
+				LRframes[sample][lane] = LR[lane][sample];
+			}
+			for (int lane = count; lane < Lanes; lane++)
+			{
+				ERframes[sample][lane] = 0.0f;
+				LRframes[sample][lane] = 0.0f;
+			}
+		}
+
+		processDampingFilters(ERframes, LRframes, samples);
+
+		for (int lane = 0; lane < count; lane++)
+		{
+			for (int sample = 0; sample < samples; sample++)
+			{
+				ER[lane][sample] = ERframes[sample][lane];
+				LR[lane][sample] = LRframes[sample][lane];
+			}
+		}
+
+		// Serial allpass filters, chunks shorter than the shortest feedback loop have no dependency inside
+		for (int lane = 0; lane < count; lane++)
+		{
+			for (int chunkStart = 0; chunkStart < samples; chunkStart += m_allpassMinimumDelay)
+			{
+				const int chunkSamples = std::min(m_allpassMinimumDelay, samples - chunkStart);
+				float* LRchunk = LR[lane] + chunkStart;
+
+				for (int allpass = 0; allpass < N_ALLPASSES; allpass++)
+				{
+					auto& buffer = m_allpass[allpass][lane];
+					buffer.readDelayBlock(m_allpassDelay[lane][allpass] - chunkSamples, tap, chunkSamples);
+
+					for (int sample = 0; sample < chunkSamples; sample++)
+					{
+						const float in = LRchunk[sample];
+						LRchunk[sample] = 0.5f * (tap[sample] - in);
+						tap[sample] = in + 0.5f * tap[sample];
+					}
+
+					buffer.writeBlock(tap, chunkSamples);
+				}
+			}
+		}
+
+		// Out
+		for (int lane = 0; lane < count; lane++)
+		{
+			float* out = buffers[lane] + start;
+			for (int sample = 0; sample < samples; sample++)
+			{
+				out[sample] = m_ERgain * ER[lane][sample] + m_LRgain * LR[lane][sample];
+			}
+		}
+	}
+
+	// Early reflections low pass biquad and late reflections one pole low pass,
+	// same formulas as LowPassBiquadFilter::process() and OnePoleLowPassFilter::process()
+	inline void processDampingFilters(float (*ERframes)[Lanes], float (*LRframes)[Lanes], const int samples) noexcept
+	{
+#if defined(__AVX__)
+		if constexpr (Lanes == 8)
+		{
+			const __m256 b0 = _mm256_set1_ps(m_ERb0);
+			const __m256 b1 = _mm256_set1_ps(m_ERb1);
+			const __m256 a1 = _mm256_set1_ps(m_ERa1);
+			const __m256 a2 = _mm256_set1_ps(m_ERa2);
+			const __m256 a0 = _mm256_set1_ps(m_LRa0);
+
+			__m256 x1 = _mm256_load_ps(m_ERx1);
+			__m256 x2 = _mm256_load_ps(m_ERx2);
+			__m256 y1 = _mm256_load_ps(m_ERy1);
+			__m256 y2 = _mm256_load_ps(m_ERy2);
+			__m256 last = _mm256_load_ps(m_LRlast);
+
+			for (int sample = 0; sample < samples; sample++)
+			{
+				const __m256 in = _mm256_load_ps(ERframes[sample]);
+				const __m256 out = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(b0, _mm256_add_ps(in, x2)), _mm256_mul_ps(b1, x1)), _mm256_mul_ps(a1, y1)), _mm256_mul_ps(a2, y2));
+
+				x2 = x1;
+				x1 = in;
+				y2 = y1;
+				y1 = out;
+
+				last = _mm256_add_ps(_mm256_mul_ps(a0, _mm256_sub_ps(_mm256_load_ps(LRframes[sample]), last)), last);
+
+				_mm256_store_ps(ERframes[sample], out);
+				_mm256_store_ps(LRframes[sample], last);
+			}
+
+			_mm256_store_ps(m_ERx1, x1);
+			_mm256_store_ps(m_ERx2, x2);
+			_mm256_store_ps(m_ERy1, y1);
+			_mm256_store_ps(m_ERy2, y2);
+			_mm256_store_ps(m_LRlast, last);
+			return;
+		}
+#endif
+
+#if JUCE_USE_SSE_INTRINSICS
+		// Process 4 lanes per iteration
+		for (int lane = 0; lane < Lanes; lane += 4)
+		{
+			const __m128 b0 = _mm_set1_ps(m_ERb0);
+			const __m128 b1 = _mm_set1_ps(m_ERb1);
+			const __m128 a1 = _mm_set1_ps(m_ERa1);
+			const __m128 a2 = _mm_set1_ps(m_ERa2);
+			const __m128 a0 = _mm_set1_ps(m_LRa0);
+
+			__m128 x1 = _mm_load_ps(m_ERx1 + lane);
+			__m128 x2 = _mm_load_ps(m_ERx2 + lane);
+			__m128 y1 = _mm_load_ps(m_ERy1 + lane);
+			__m128 y2 = _mm_load_ps(m_ERy2 + lane);
+			__m128 last = _mm_load_ps(m_LRlast + lane);
+
+			for (int sample = 0; sample < samples; sample++)
+			{
+				const __m128 in = _mm_load_ps(ERframes[sample] + lane);
+				const __m128 out = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b0, _mm_add_ps(in, x2)), _mm_mul_ps(b1, x1)), _mm_mul_ps(a1, y1)), _mm_mul_ps(a2, y2));
+
+				x2 = x1;
+				x1 = in;
+				y2 = y1;
+				y1 = out;
+
+				last = _mm_add_ps(_mm_mul_ps(a0, _mm_sub_ps(_mm_load_ps(LRframes[sample] + lane), last)), last);
+
+				_mm_store_ps(ERframes[sample] + lane, out);
+				_mm_store_ps(LRframes[sample] + lane, last);
+			}
+
+			_mm_store_ps(m_ERx1 + lane, x1);
+			_mm_store_ps(m_ERx2 + lane, x2);
+			_mm_store_ps(m_ERy1 + lane, y1);
+			_mm_store_ps(m_ERy2 + lane, y2);
+			_mm_store_ps(m_LRlast + lane, last);
+		}
+#elif JUCE_USE_ARM_NEON
+		// Process 4 lanes per iteration
+		for (int lane = 0; lane < Lanes; lane += 4)
+		{
+			const float32x4_t b0 = vdupq_n_f32(m_ERb0);
+			const float32x4_t b1 = vdupq_n_f32(m_ERb1);
+			const float32x4_t a1 = vdupq_n_f32(m_ERa1);
+			const float32x4_t a2 = vdupq_n_f32(m_ERa2);
+			const float32x4_t a0 = vdupq_n_f32(m_LRa0);
+
+			float32x4_t x1 = vld1q_f32(m_ERx1 + lane);
+			float32x4_t x2 = vld1q_f32(m_ERx2 + lane);
+			float32x4_t y1 = vld1q_f32(m_ERy1 + lane);
+			float32x4_t y2 = vld1q_f32(m_ERy2 + lane);
+			float32x4_t last = vld1q_f32(m_LRlast + lane);
+
+			for (int sample = 0; sample < samples; sample++)
+			{
+				const float32x4_t in = vld1q_f32(ERframes[sample] + lane);
+				const float32x4_t out = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(b0, vaddq_f32(in, x2)), vmulq_f32(b1, x1)), vmulq_f32(a1, y1)), vmulq_f32(a2, y2));
+
+				x2 = x1;
+				x1 = in;
+				y2 = y1;
+				y1 = out;
+
+				last = vaddq_f32(vmulq_f32(a0, vsubq_f32(vld1q_f32(LRframes[sample] + lane), last)), last);
+
+				vst1q_f32(ERframes[sample] + lane, out);
+				vst1q_f32(LRframes[sample] + lane, last);
+			}
+
+			vst1q_f32(m_ERx1 + lane, x1);
+			vst1q_f32(m_ERx2 + lane, x2);
+			vst1q_f32(m_ERy1 + lane, y1);
+			vst1q_f32(m_ERy2 + lane, y2);
+			vst1q_f32(m_LRlast + lane, last);
+		}
+#else
+		for (int sample = 0; sample < samples; sample++)
+		{
+			for (int lane = 0; lane < Lanes; lane++)
+			{
+				const float in = ERframes[sample][lane];
+				const float out = m_ERb0 * (in + m_ERx2[lane]) + m_ERb1 * m_ERx1[lane] + m_ERa1 * m_ERy1[lane] + m_ERa2 * m_ERy2[lane];
+
+				m_ERx2[lane] = m_ERx1[lane];
+				m_ERx1[lane] = in;
+				m_ERy2[lane] = m_ERy1[lane];
+				m_ERy1[lane] = out;
+
+				m_LRlast[lane] = m_LRa0 * (LRframes[sample][lane] - m_LRlast[lane]) + m_LRlast[lane];
+
+				ERframes[sample][lane] = out;
+				LRframes[sample][lane] = m_LRlast[lane];
+			}
+		}
+#endif
+	}
+
+	CircularBuffer m_earlyReflections[Lanes];
+	CircularBuffer m_allpass[N_ALLPASSES][Lanes];
+
+	int m_ERdelay[Lanes][N_REFLECTIONS] = {};
+	int m_allpassDelay[Lanes][N_ALLPASSES] = {};
+	int m_variation[Lanes] = {};
+
+	// Early reflections low pass biquad state
+	alignas(32) float m_ERx1[Lanes] = {};
+	alignas(32) float m_ERx2[Lanes] = {};
+	alignas(32) float m_ERy1[Lanes] = {};
+	alignas(32) float m_ERy2[Lanes] = {};
+
+	// Late reflections one pole low pass state
+	alignas(32) float m_LRlast[Lanes] = {};
+
+	float m_ERb0 = 0.0f;
+	float m_ERb1 = 0.0f;
+	float m_ERa1 = 0.0f;
+	float m_ERa2 = 0.0f;
+	float m_LRa0 = 0.0f;
+
+	float m_sampleRateMS = 48.0f;
+	float m_samplePeriod = 2.08e-5f;
+	float m_ERgain = 1.0f;
+	float m_LRgain = 1.0f;
+	int m_ERdelayMask = 0;
+	int m_LRPredelaySize = 0;
+	int m_allpassMinimumDelay = 1;
+};
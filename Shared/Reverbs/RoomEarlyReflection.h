@@ -64,7 +64,7 @@ public:
 
 	inline void init(const int size, const int sampleRate, const int channel)
 	{
-		__super::init(size);
+		CircularBuffer::init(size);
 
 		m_channel = channel;
 
@@ -115,7 +115,7 @@ public:
 	};
 	inline void release()
 	{
-		__super::release();
+		CircularBuffer::release();
 
 		for (int i = 0; i < N_DELAY_LINES; i++)
 		{
@@ -179,7 +179,7 @@ public:
 	};
 	inline void release()
 	{
-		__super::release();
+		CircularBuffer::release();
 
 		for (int i = 0; i < N_DELAY_LINES; i++)
 		{
@@ -222,7 +222,7 @@ public:
 
 	inline void init(const int size, const int channel) noexcept
 	{
-		__super::init(size);
+		CircularBuffer::init(size);
 
 		m_channel = channel;
 	};
@@ -250,7 +250,7 @@ public:
 	};
 	inline void release()
 	{
-		__super::release();
+		CircularBuffer::release();
 
 		for (int i = 0; i < N_DELAY_LINES; i++)
 		{
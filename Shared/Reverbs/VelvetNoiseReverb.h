@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
 #include "../../../zazzVSTPlugins/Shared/Utilities/CircularBuffers.h"
@@ -35,6 +36,7 @@ public:
 	static constexpr int VNC_COUNT = 16;
 	static constexpr int VNC_SEGMENT_COUNT = 136; // = 1 + 2 + 3 + ... + 16
 	static constexpr int VNC_MAX_SIZE = 64;
+	static constexpr int BLOCK_SIZE = 128;
 	static constexpr float kOneOverSegmentCount = 1.0f / static_cast<float>(VNC_SEGMENT_COUNT);
 	static constexpr float kLog1000 = 6.90775527898f; // log(1000)
 
@@ -44,18 +46,31 @@ public:
 		VNC() = default;
 		~VNC() = default;
 
-		//! Holds indexes to positive values in velvet noise IR for given region
+		//! Holds indexes to positive values in velvet noise IR for given region, sorted
 		int m_positiveIdx[VNC_MAX_SIZE];
-		//! Holds indexes to negative values in velvet noise IR for given region
+		//! Holds indexes to negative values in velvet noise IR for given region, sorted
 		int m_negativeIdx[VNC_MAX_SIZE];
 	};
 
+	//! Everything set() derives from length, predelay, decay, density and seed
+	struct Taps
+	{
+	public:
+		Taps() = default;
+		~Taps() = default;
+
+		VNC m_VNC[VNC_COUNT] = {};
+		float m_gains[VNC_COUNT] = {};
+		int m_VNCSize = VNC_MAX_SIZE;
+	};
+
 	inline void init(const int sampleRate, const float lengthSeconds)
 	{
 		m_sampleRate = sampleRate;
 		
+		// Block reads need block size on top of the longest tap
 		const int size = (int)(lengthSeconds * (float)sampleRate);
-		m_buffer.init(size);
+		m_buffer.init(size + BLOCK_SIZE);
 	
 		// Filters
 		for (int i = 0; i < VNC_COUNT; i++)
@@ -66,7 +81,37 @@ public:
 	}
 	inline void set(const float lengthSeconds, const float preDelaySeconds, const float decayFactor, const float density, const long seed, const float low, const float high)
 	{
-		m_VNCSize = 4 + (int)((float)(VNC_MAX_SIZE - 4) * density);
+		generateTaps(m_taps, m_sampleRate, lengthSeconds, preDelaySeconds, decayFactor, density, seed);
+		setFilters(low, high);
+	}
+	// Copies tap table built by generateTaps(), possibly on another thread
+	inline void setTaps(const Taps& taps) noexcept
+	{
+		m_taps = taps;
+	}
+	inline void setFilters(const float low, const float high)
+	{
+		const float highPassQ = 0.5f + low * 0.5f;
+		const float lowPassQ = 0.5f + high * 0.7f;
+
+		const float highPassA = 20.0f + 100.0f * (1.0f - low);
+		const float highPassB = 0.47f * (1.0f - low);
+
+		const float lowPassA = 8000.0f + 8000.0f * high;
+		const float lowPassB = 0.6f * high - 1.3f;
+
+		for (int i = 0; i < VNC_COUNT; i++)
+		{
+			const float highFrequency = highPassA * powf(static_cast<float>(i + 1), highPassB);
+			const float lowPassFrequency = lowPassA * powf(static_cast<float>(i + 1), lowPassB);
+			m_highPass[i].setHighPass(highFrequency, highPassQ);
+			m_lowPass[i].setLowPass(lowPassFrequency, lowPassQ);
+		}
+	}
+	// Does not touch any reverb state and does not allocate, can run on any thread
+	static void generateTaps(Taps& taps, const int sampleRate, const float lengthSeconds, const float preDelaySeconds, const float decayFactor, const float density, const long seed)
+	{
+		taps.m_VNCSize = 4 + (int)((float)(VNC_MAX_SIZE - 4) * density);
 		
 		// Generate exponantialy decaying gains
 		const float decayRate = kLog1000 * decayFactor;
@@ -75,16 +120,16 @@ public:
 		for (int i = 0; i < VNC_COUNT; i++)
 		{
 			time += (float)i * kOneOverSegmentCount;
-			m_gains[i] = expf(-decayRate * time);
+			taps.m_gains[i] = expf(-decayRate * time);
 		}
 
 		// Add lead in to the IR
-		m_gains[0] = 0.5f * m_gains[0];
+		taps.m_gains[0] = 0.5f * taps.m_gains[0];
 
 		// Devide inpulse response to segments with non-uniform lenght		
-		const float size = lengthSeconds * (float)m_sampleRate;
+		const float size = lengthSeconds * (float)sampleRate;
 		const int segmentSize = (int)(size / (float)VNC_SEGMENT_COUNT);
-		const int predelaySize = (int)(preDelaySeconds * (float)m_sampleRate);
+		const int predelaySize = (int)(preDelaySeconds * (float)sampleRate);
 
 		int segmentIdx[VNC_COUNT + 1];
 		segmentIdx[0] = predelaySize + 1;
@@ -103,34 +148,20 @@ public:
 		// Rest of the segments
 		for (int i = 0; i < VNC_COUNT; i++)
 		{
-			auto& vnc = m_VNC[i];
+			auto& vnc = taps.m_VNC[i];
 
 			const int currSegmentOffset = segmentIdx[i];
 			const int currSegmentSize = segmentIdx[i + 1] - currSegmentOffset;
 			
-			for (int j = 0; j < m_VNCSize; j++)
+			for (int j = 0; j < taps.m_VNCSize; j++)
 			{
 				vnc.m_positiveIdx[j] = currSegmentOffset + (int)(noiseGenerator.process() * currSegmentSize);
 				vnc.m_negativeIdx[j] = currSegmentOffset + (int)(noiseGenerator.process() * currSegmentSize);
 			}
-		}
 
-		// Filters
-		const float highPassQ = 0.5f + low * 0.5f;
-		const float lowPassQ = 0.5f + high * 0.7f;
-
-		const float highPassA = 20.0f + 100.0f * (1.0f - low);
-		const float highPassB = 0.47f * (1.0f - low);
-
-		const float lowPassA = 8000.0f + 8000.0f * high;
-		const float lowPassB = 0.6f * high - 1.3f;
-
-		for (int i = 0; i < VNC_COUNT; i++)
-		{
-			const float highFrequency = highPassA * powf(static_cast<float>(i + 1), highPassB);
-			const float lowPassFrequency = lowPassA * powf(static_cast<float>(i + 1), lowPassB);
-			m_highPass[i].setHighPass(highFrequency, highPassQ);
-			m_lowPass[i].setLowPass(lowPassFrequency, lowPassQ);
+			// Neighbouring taps read overlapping memory in block process()
+			std::sort(vnc.m_positiveIdx, vnc.m_positiveIdx + taps.m_VNCSize);
+			std::sort(vnc.m_negativeIdx, vnc.m_negativeIdx + taps.m_VNCSize);
 		}
 	}
 	inline float process(const float in) noexcept
@@ -141,12 +172,12 @@ public:
 
 		for (int i = 0; i < VNC_COUNT; i++)
 		{
-			auto& vnc = m_VNC[i];
+			auto& vnc = m_taps.m_VNC[i];
 			
 			float positiveValue = 0.0f;
 			float negativeValue = 0.0f;
 
-			for (int j = 0; j < m_VNCSize; j++)
+			for (int j = 0; j < m_taps.m_VNCSize; j++)
 			{
 				positiveValue += m_buffer.readDelay(vnc.m_positiveIdx[j]);
 				negativeValue += m_buffer.readDelay(vnc.m_negativeIdx[j]);
@@ -156,34 +187,74 @@ public:
 			temp = m_lowPass[i].processDF1(temp);
 			temp = m_highPass[i].processDF1(temp);
 
-			out += m_gains[i] * temp;
+			out += m_taps.m_gains[i] * temp;
 		}
 
 		return out;
 	}
+	// Sparse convolution, every tap adds a contiguous span of the input history to the whole block.
+	// Segment filters run once over the block. Output equals process() up to summation order.
+	// In and out can be the same buffer.
+	inline void process(const float* in, float* out, const int samples) noexcept
+	{
+		for (int start = 0; start < samples; start += BLOCK_SIZE)
+		{
+			const int count = std::min(BLOCK_SIZE, samples - start);
+
+			m_buffer.writeBlock(in + start, count);
+			std::fill(m_blockOut, m_blockOut + count, 0.0f);
+
+			for (int i = 0; i < VNC_COUNT; i++)
+			{
+				auto& vnc = m_taps.m_VNC[i];
+
+				std::fill(m_blockSegment, m_blockSegment + count, 0.0f);
+
+				for (int j = 0; j < m_taps.m_VNCSize; j++)
+				{
+					m_buffer.addDelayBlock(vnc.m_positiveIdx[j], m_blockSegment, count);
+				}
+				for (int j = 0; j < m_taps.m_VNCSize; j++)
+				{
+					m_buffer.subtractDelayBlock(vnc.m_negativeIdx[j], m_blockSegment, count);
+				}
+
+				m_lowPass[i].processBlockDF1(m_blockSegment, count);
+				m_highPass[i].processBlockDF1(m_blockSegment, count);
+
+				const float gain = m_taps.m_gains[i];
+				for (int sample = 0; sample < count; sample++)
+				{
+					m_blockOut[sample] += gain * m_blockSegment[sample];
+				}
+			}
+
+			std::copy(m_blockOut, m_blockOut + count, out + start);
+		}
+	}
 	inline void release()
 	{
 		m_buffer.release();
 
 		for (int i = 0; i < VNC_COUNT; i++)
 		{
-			m_gains[i] = 0.0f;
+			m_taps.m_gains[i] = 0.0f;
 			m_lowPass[i].release();
 			m_highPass[i].release();
 		}
 
 		m_sampleRate = 48000;
-		m_VNCSize = VNC_MAX_SIZE;
+		m_taps.m_VNCSize = VNC_MAX_SIZE;
 	}
 
 private:
 	CircularBuffer m_buffer;
 
-	VNC m_VNC[VNC_COUNT] = {};
+	Taps m_taps;
 	BiquadFilter m_lowPass[VNC_COUNT] = {};
 	BiquadFilter m_highPass[VNC_COUNT] = {};
 	
-	float m_gains[VNC_COUNT];
+	float m_blockSegment[BLOCK_SIZE];
+	float m_blockOut[BLOCK_SIZE];
 	int m_sampleRate = 48000;
-	int m_VNCSize = VNC_MAX_SIZE;
 };
\ No newline at end of file
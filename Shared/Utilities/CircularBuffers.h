@@ -23,6 +23,15 @@ public:
 	CircularBuffer() = default;
 	~CircularBuffer() { clearBuffer(); }
 
+	// Fractional delay interpolation used by readDelays() and readDelayBlock()
+	enum class Interpolation
+	{
+		Linear,			// Same as readDelayLinearInterpolation()
+		TriLinear,		// Same as readDelayTriLinearInterpolation()
+		Hermite,		// 4-point, 3rd-order Hermite (Catmull-Rom)
+		Lagrange		// 4-point, 3rd-order Lagrange
+	};
+
 	//! Initialize circular buffer to maximum size
 	inline void init(const unsigned int circularBufferSize, const unsigned int linearBufferSize = 0u)
 	{
@@ -105,6 +114,14 @@ public:
 	{  
 		return m_circularBuffer[(m_head + m_readOffset) & m_bitMask];
 	};
+	// Zeroes stored samples, size and delay stay
+	inline void reset() noexcept
+	{
+		if (m_circularBuffer != nullptr)
+		{
+			memset(m_circularBuffer, 0, (m_bitMask + 1 + m_linearBufferSize) * sizeof(float));
+		}
+	}
 	inline void release()
 	{
 		clearBuffer();
@@ -164,7 +181,259 @@ public:
 		return (c2 * weight + c1) * weight + c0;
 	}
 
+	//==========================================================================
+	// Block operations, every block is copied in at most two contiguous spans.
+	// Block and delay together must fit into the buffer: count + delay <= power of two size.
+
+	//! Writes count samples, same as calling write() for each of them
+	inline void writeBlock(const float* input, const int count) noexcept
+	{
+		jassert(count <= m_bitMask + 1);
+
+		const int start = (m_head + 1) & m_bitMask;
+		const int firstSpan = std::min(count, m_bitMask + 1 - start);
+
+		std::memcpy(m_circularBuffer + start, input, firstSpan * sizeof(float));
+		std::memcpy(m_circularBuffer, input + firstSpan, (count - firstSpan) * sizeof(float));
+
+		m_head = (m_head + count) & m_bitMask;
+	}
+	//! Call after writeBlock(). output[i] is what readDelay(delay) returned right after writing input[i].
+	inline void readDelayBlock(const int delay, float* output, const int count) const noexcept
+	{
+		jassert(count + delay <= m_bitMask + 1);
+
+		const int start = (m_head - delay - count + 1) & m_bitMask;
+		const int firstSpan = std::min(count, m_bitMask + 1 - start);
+
+		std::memcpy(output, m_circularBuffer + start, firstSpan * sizeof(float));
+		std::memcpy(output + firstSpan, m_circularBuffer, (count - firstSpan) * sizeof(float));
+	}
+	//! Call after writeBlock(). Same as readDelayBlock(), but adds to output. Sparse FIR tap.
+	inline void addDelayBlock(const int delay, float* output, const int count) const noexcept
+	{
+		jassert(count + delay <= m_bitMask + 1);
+
+		const int start = (m_head - delay - count + 1) & m_bitMask;
+		const int firstSpan = std::min(count, m_bitMask + 1 - start);
+
+		const float* first = m_circularBuffer + start;
+		for (int i = 0; i < firstSpan; i++)
+		{
+			output[i] += first[i];
+		}
+
+		float* second = output + firstSpan;
+		for (int i = 0; i < count - firstSpan; i++)
+		{
+			second[i] += m_circularBuffer[i];
+		}
+	}
+	//! Call after writeBlock(). Same as addDelayBlock(), tap scaled by gain.
+	inline void addDelayBlock(const int delay, const float gain, float* output, const int count) const noexcept
+	{
+		jassert(count + delay <= m_bitMask + 1);
+
+		const int start = (m_head - delay - count + 1) & m_bitMask;
+		const int firstSpan = std::min(count, m_bitMask + 1 - start);
+
+		const float* first = m_circularBuffer + start;
+		for (int i = 0; i < firstSpan; i++)
+		{
+			output[i] += gain * first[i];
+		}
+
+		float* second = output + firstSpan;
+		for (int i = 0; i < count - firstSpan; i++)
+		{
+			second[i] += gain * m_circularBuffer[i];
+		}
+	}
+	//! Call after writeBlock(). Same as readDelayBlock(), but subtracts from output.
+	inline void subtractDelayBlock(const int delay, float* output, const int count) const noexcept
+	{
+		jassert(count + delay <= m_bitMask + 1);
+
+		const int start = (m_head - delay - count + 1) & m_bitMask;
+		const int firstSpan = std::min(count, m_bitMask + 1 - start);
+
+		const float* first = m_circularBuffer + start;
+		for (int i = 0; i < firstSpan; i++)
+		{
+			output[i] -= first[i];
+		}
+
+		float* second = output + firstSpan;
+		for (int i = 0; i < count - firstSpan; i++)
+		{
+			second[i] -= m_circularBuffer[i];
+		}
+	}
+	//! Reads count fractional taps relative to the youngest sample
+	template <Interpolation interpolation>
+	inline void readDelays(const float* delays, float* output, const int count) const noexcept
+	{
+		gather<interpolation>(delays, output, count, 0);
+	}
+	//! Call after writeBlock(). Time varying delay, output[i] is read with delays[i] right after writing input[i].
+	template <Interpolation interpolation>
+	inline void readDelayBlock(const float* delays, float* output, const int count) const noexcept
+	{
+		gather<interpolation>(delays, output, count, 1);
+	}
+
 private:
+	// Offset of the youngest of 4 interpolation points from delay index
+	template <Interpolation interpolation>
+	static constexpr int getYoungestPointOffset()
+	{
+		return interpolation == Interpolation::TriLinear ? 2 : 1;
+	}
+
+	// y0 is the younger and y1 the older neighbour of fractional delay, ym1 and y2 are outer points
+	template <Interpolation interpolation, typename T>
+	static inline T interpolate(const T ym1, const T y0, const T y1, const T y2, const T weight) noexcept
+	{
+		if constexpr (interpolation == Interpolation::Linear)
+		{
+			return y0 + weight * (y1 - y0);
+		}
+		else if constexpr (interpolation == Interpolation::TriLinear)
+		{
+			// Same point order and formula as readDelayTriLinearInterpolation()
+			const T ym1py2 = ym1 + y2;
+			const T c1 = T(1.5f) * y1 - T(0.5f) * (y0 + ym1py2);
+			const T c2 = T(0.5f) * (ym1py2 - y0 - y1);
+
+			return (c2 * weight + c1) * weight + y0;
+		}
+		else if constexpr (interpolation == Interpolation::Hermite)
+		{
+			const T c1 = T(0.5f) * (y1 - ym1);
+			const T c2 = ym1 - T(2.5f) * y0 + T(2.0f) * y1 - T(0.5f) * y2;
+			const T c3 = T(0.5f) * (y2 - ym1) + T(1.5f) * (y0 - y1);
+
+			return ((c3 * weight + c2) * weight + c1) * weight + y0;
+		}
+		else
+		{
+			const T wp1 = weight + T(1.0f);
+			const T wm1 = weight - T(1.0f);
+			const T wm2 = weight - T(2.0f);
+
+			const T hm1 = T(-1.0f / 6.0f) * weight * wm1 * wm2;
+			const T h0 = T(0.5f) * wp1 * wm1 * wm2;
+			const T h1 = T(-0.5f) * wp1 * weight * wm2;
+			const T h2 = T(1.0f / 6.0f) * wp1 * weight * wm1;
+
+			return hm1 * ym1 + h0 * y0 + h1 * y1 + h2 * y2;
+		}
+	}
+
+	// Tap i reads at youngest sample - (count - 1 - i) * blockStep - delays[i], blockStep is 0 or 1
+	template <Interpolation interpolation>
+	inline void gather(const float* delays, float* output, const int count, const int blockStep) const noexcept
+	{
+		constexpr int offset = getYoungestPointOffset<interpolation>();
+		int i = 0;
+
+#if JUCE_USE_SSE_INTRINSICS
+		// Index and weight math in SIMD, 4 loads per point since SSE has no gather
+		alignas(16) int index[4];
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 delay = _mm_loadu_ps(delays + i);
+			const __m128i delayTrunc = _mm_cvttps_epi32(delay);
+			const __m128 weight = _mm_sub_ps(delay, _mm_cvtepi32_ps(delayTrunc));
+
+			const __m128i blockOffset = _mm_and_si128(_mm_setr_epi32(count - 1 - i, count - 2 - i, count - 3 - i, count - 4 - i), _mm_set1_epi32(-blockStep));
+			const __m128i readIndex = _mm_sub_epi32(_mm_sub_epi32(_mm_set1_epi32(m_head), delayTrunc), blockOffset);
+			_mm_store_si128(reinterpret_cast<__m128i*>(index), readIndex);
+
+			const auto load = [this, &index](const int pointOffset)
+			{
+				return _mm_setr_ps(m_circularBuffer[(index[0] + pointOffset) & m_bitMask],
+								   m_circularBuffer[(index[1] + pointOffset) & m_bitMask],
+								   m_circularBuffer[(index[2] + pointOffset) & m_bitMask],
+								   m_circularBuffer[(index[3] + pointOffset) & m_bitMask]);
+			};
+
+			__m128 out;
+			if constexpr (interpolation == Interpolation::Linear)
+			{
+				const __m128 y0 = load(0);
+				const __m128 y1 = load(-1);
+				out = _mm_add_ps(y0, _mm_mul_ps(weight, _mm_sub_ps(y1, y0)));
+			}
+			else
+			{
+				out = interpolateSSE<interpolation>(load(offset), load(offset - 1), load(offset - 2), load(offset - 3), weight);
+			}
+
+			_mm_storeu_ps(output + i, out);
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			const int delayTrunc = (int)delays[i];
+			const float weight = delays[i] - (float)delayTrunc;
+			const int readIndex = m_head - delayTrunc - (count - 1 - i) * blockStep;
+
+			if constexpr (interpolation == Interpolation::Linear)
+			{
+				output[i] = interpolate<interpolation>(0.0f, m_circularBuffer[readIndex & m_bitMask], m_circularBuffer[(readIndex - 1) & m_bitMask], 0.0f, weight);
+			}
+			else
+			{
+				output[i] = interpolate<interpolation>(m_circularBuffer[(readIndex + offset) & m_bitMask],
+													   m_circularBuffer[(readIndex + offset - 1) & m_bitMask],
+													   m_circularBuffer[(readIndex + offset - 2) & m_bitMask],
+													   m_circularBuffer[(readIndex + offset - 3) & m_bitMask],
+													   weight);
+			}
+		}
+	}
+
+#if JUCE_USE_SSE_INTRINSICS
+	template <Interpolation interpolation>
+	static inline __m128 interpolateSSE(const __m128 ym1, const __m128 y0, const __m128 y1, const __m128 y2, const __m128 weight) noexcept
+	{
+		const auto c = [](const float value) { return _mm_set1_ps(value); };
+
+		if constexpr (interpolation == Interpolation::TriLinear)
+		{
+			const __m128 ym1py2 = _mm_add_ps(ym1, y2);
+			const __m128 c1 = _mm_sub_ps(_mm_mul_ps(c(1.5f), y1), _mm_mul_ps(c(0.5f), _mm_add_ps(y0, ym1py2)));
+			const __m128 c2 = _mm_mul_ps(c(0.5f), _mm_sub_ps(_mm_sub_ps(ym1py2, y0), y1));
+
+			return _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(c2, weight), c1), weight), y0);
+		}
+		else if constexpr (interpolation == Interpolation::Hermite)
+		{
+			const __m128 c1 = _mm_mul_ps(c(0.5f), _mm_sub_ps(y1, ym1));
+			const __m128 c2 = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(ym1, _mm_mul_ps(c(2.5f), y0)), _mm_mul_ps(c(2.0f), y1)), _mm_mul_ps(c(0.5f), y2));
+			const __m128 c3 = _mm_add_ps(_mm_mul_ps(c(0.5f), _mm_sub_ps(y2, ym1)), _mm_mul_ps(c(1.5f), _mm_sub_ps(y0, y1)));
+
+			return _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(c3, weight), c2), weight), c1), weight), y0);
+		}
+		else
+		{
+			const __m128 wp1 = _mm_add_ps(weight, c(1.0f));
+			const __m128 wm1 = _mm_sub_ps(weight, c(1.0f));
+			const __m128 wm2 = _mm_sub_ps(weight, c(2.0f));
+
+			const __m128 hm1 = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(c(-1.0f / 6.0f), weight), wm1), wm2);
+			const __m128 h0 = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(c(0.5f), wp1), wm1), wm2);
+			const __m128 h1 = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(c(-0.5f), wp1), weight), wm2);
+			const __m128 h2 = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(c(1.0f / 6.0f), wp1), weight), wm1);
+
+			return _mm_add_ps(_mm_add_ps(_mm_mul_ps(hm1, ym1), _mm_mul_ps(h0, y0)), _mm_add_ps(_mm_mul_ps(h1, y1), _mm_mul_ps(h2, y2)));
+		}
+	}
+#endif
+
 	inline int GetPowerOfTwo(int i)
 	{
 		jassert(i > 0);
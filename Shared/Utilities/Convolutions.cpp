@@ -1,35 +1,408 @@
 #include "Convolutions.h"
 #include <string.h>
 
+//==============================================================================
+void UniformPartitionedConvolution::init(const int blockSize, const int maxImpulseResponseLength, const bool distributed)
+{
+	jassert(juce::isPowerOfTwo(blockSize));
+
+	m_blockSize = blockSize;
+	m_fftSize = 2 * blockSize;
+	m_bins = blockSize + 1;
+	m_maxPartitionsCount = std::max(1, (maxImpulseResponseLength + blockSize - 1) / blockSize);
+	m_partitionsCount = 0;
+	m_firstPartition = 0;
+	m_distributed = distributed;
+
+	m_fft = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(m_fftSize)));
+	m_fftBuffer.assign(2 * m_fftSize, 0.0f);
+
+	m_inputBuffer.assign(m_fftSize, 0.0f);
+	m_outputBuffer.assign(m_blockSize, 0.0f);
+	m_nextOutputBuffer.assign(m_blockSize, 0.0f);
+
+	m_partitionsRe.assign(m_maxPartitionsCount * m_bins, 0.0f);
+	m_partitionsIm.assign(m_maxPartitionsCount * m_bins, 0.0f);
+	m_delayLineRe.assign(m_maxPartitionsCount * m_bins, 0.0f);
+	m_delayLineIm.assign(m_maxPartitionsCount * m_bins, 0.0f);
+	m_accumulatorRe.assign(m_bins, 0.0f);
+	m_accumulatorIm.assign(m_bins, 0.0f);
+
+	reset();
+}
+
+void UniformPartitionedConvolution::setImpulseResponse(const float* impulseResponse, const int length, const int delay)
+{
+	const int totalLength = delay + length;
+	m_partitionsCount = std::min(m_maxPartitionsCount, (totalLength + m_blockSize - 1) / m_blockSize);
+
+	// Partitions fully inside delay are zero, they are not transformed nor multiplied
+	m_firstPartition = std::min(m_partitionsCount, delay / m_blockSize);
+
+	// Partition p holds samples [p * blockSize, (p + 1) * blockSize) of delay zeros + impulse response
+	for (int partition = m_firstPartition; partition < m_partitionsCount; partition++)
+	{
+		std::fill(m_fftBuffer.begin(), m_fftBuffer.end(), 0.0f);
+
+		for (int sample = 0; sample < m_blockSize; sample++)
+		{
+			const int index = partition * m_blockSize + sample - delay;
+			if (index >= 0 && index < length)
+			{
+				m_fftBuffer[sample] = impulseResponse[index];
+			}
+		}
+
+		m_fft->performRealOnlyForwardTransform(m_fftBuffer.data(), true);
+
+		float* re = m_partitionsRe.data() + partition * m_bins;
+		float* im = m_partitionsIm.data() + partition * m_bins;
+		for (int bin = 0; bin < m_bins; bin++)
+		{
+			re[bin] = m_fftBuffer[2 * bin];
+			im[bin] = m_fftBuffer[2 * bin + 1];
+		}
+	}
+}
+
+void UniformPartitionedConvolution::process(const float* input, float* output, const int samples) noexcept
+{
+	int done = 0;
+
+	while (done < samples)
+	{
+		const int chunk = std::min(samples - done, m_blockSize - m_fifoPosition);
+
+		// Input first, input and output can be the same buffer
+		std::memcpy(m_inputBuffer.data() + m_blockSize + m_fifoPosition, input + done, chunk * sizeof(float));
+		std::memcpy(output + done, m_outputBuffer.data() + m_fifoPosition, chunk * sizeof(float));
+
+		m_fifoPosition += chunk;
+		done += chunk;
+
+		if (m_fifoPosition == m_blockSize)
+		{
+			if (m_distributed)
+			{
+				// Finish previous block, its output plays during next block period
+				runSteps(m_stepsCount);
+				std::swap(m_outputBuffer, m_nextOutputBuffer);
+				startBlock();
+			}
+			else
+			{
+				startBlock();
+				runSteps(m_stepsCount);
+				std::swap(m_outputBuffer, m_nextOutputBuffer);
+			}
+
+			m_fifoPosition = 0;
+		}
+		else if (m_distributed)
+		{
+			// Keep up with block period
+			runSteps(m_stepsCount * m_fifoPosition / m_blockSize);
+		}
+	}
+}
+
+float UniformPartitionedConvolution::process(const float in) noexcept
+{
+	float out = in;
+	process(&out, &out, 1);
+	return out;
+}
+
+void UniformPartitionedConvolution::startBlock() noexcept
+{
+	m_step = 0;
+
+	if (m_partitionsCount == 0)
+	{
+		m_stepsCount = 0;
+		std::fill(m_nextOutputBuffer.begin(), m_nextOutputBuffer.end(), 0.0f);
+		std::memmove(m_inputBuffer.data(), m_inputBuffer.data() + m_blockSize, m_blockSize * sizeof(float));
+		return;
+	}
+
+	// FFT, one step per partition, IFFT
+	m_stepsCount = 2 + m_partitionsCount - m_firstPartition;
+
+	// Last two blocks, input buffer keeps filling while steps run
+	std::memcpy(m_fftBuffer.data(), m_inputBuffer.data(), m_fftSize * sizeof(float));
+	std::fill(m_fftBuffer.begin() + m_fftSize, m_fftBuffer.end(), 0.0f);
+	std::memmove(m_inputBuffer.data(), m_inputBuffer.data() + m_blockSize, m_blockSize * sizeof(float));
+}
+
+void UniformPartitionedConvolution::runSteps(const int steps) noexcept
+{
+	while (m_step < steps)
+	{
+		runStep();
+		m_step++;
+	}
+}
+
+void UniformPartitionedConvolution::runStep() noexcept
+{
+	if (m_step == 0)
+	{
+		// Spectrum of last two blocks
+		m_fft->performRealOnlyForwardTransform(m_fftBuffer.data(), true);
+
+		float* delayLineRe = m_delayLineRe.data() + m_delayLinePosition * m_bins;
+		float* delayLineIm = m_delayLineIm.data() + m_delayLinePosition * m_bins;
+		for (int bin = 0; bin < m_bins; bin++)
+		{
+			delayLineRe[bin] = m_fftBuffer[2 * bin];
+			delayLineIm[bin] = m_fftBuffer[2 * bin + 1];
+		}
+
+		std::fill(m_accumulatorRe.begin(), m_accumulatorRe.end(), 0.0f);
+		std::fill(m_accumulatorIm.begin(), m_accumulatorIm.end(), 0.0f);
+	}
+	else if (m_step < m_stepsCount - 1)
+	{
+		// Complex multiply accumulate, one partition with its input spectrum
+		const int partition = m_firstPartition + m_step - 1;
+		const int slot = (m_delayLinePosition - partition + m_maxPartitionsCount) % m_maxPartitionsCount;
+		const float* xRe = m_delayLineRe.data() + slot * m_bins;
+		const float* xIm = m_delayLineIm.data() + slot * m_bins;
+		const float* hRe = m_partitionsRe.data() + partition * m_bins;
+		const float* hIm = m_partitionsIm.data() + partition * m_bins;
+		float* accumulatorRe = m_accumulatorRe.data();
+		float* accumulatorIm = m_accumulatorIm.data();
+
+		for (int bin = 0; bin < m_bins; bin++)
+		{
+			accumulatorRe[bin] += xRe[bin] * hRe[bin] - xIm[bin] * hIm[bin];
+			accumulatorIm[bin] += xRe[bin] * hIm[bin] + xIm[bin] * hRe[bin];
+		}
+	}
+	else
+	{
+		for (int bin = 0; bin < m_bins; bin++)
+		{
+			m_fftBuffer[2 * bin] = m_accumulatorRe[bin];
+			m_fftBuffer[2 * bin + 1] = m_accumulatorIm[bin];
+		}
+
+		m_fft->performRealOnlyInverseTransform(m_fftBuffer.data());
+
+		// Overlap-save, second half is valid
+		std::memcpy(m_nextOutputBuffer.data(), m_fftBuffer.data() + m_blockSize, m_blockSize * sizeof(float));
+
+		m_delayLinePosition = (m_delayLinePosition + 1) % m_maxPartitionsCount;
+	}
+}
+
+void UniformPartitionedConvolution::reset() noexcept
+{
+	std::fill(m_inputBuffer.begin(), m_inputBuffer.end(), 0.0f);
+	std::fill(m_outputBuffer.begin(), m_outputBuffer.end(), 0.0f);
+	std::fill(m_nextOutputBuffer.begin(), m_nextOutputBuffer.end(), 0.0f);
+	std::fill(m_delayLineRe.begin(), m_delayLineRe.end(), 0.0f);
+	std::fill(m_delayLineIm.begin(), m_delayLineIm.end(), 0.0f);
+
+	m_delayLinePosition = 0;
+	m_fifoPosition = 0;
+	m_step = 0;
+	m_stepsCount = 0;
+}
+
+void UniformPartitionedConvolution::release()
+{
+	m_fft.reset();
+	m_fftBuffer.clear();
+	m_inputBuffer.clear();
+	m_outputBuffer.clear();
+	m_partitionsRe.clear();
+	m_partitionsIm.clear();
+	m_delayLineRe.clear();
+	m_delayLineIm.clear();
+	m_accumulatorRe.clear();
+	m_accumulatorIm.clear();
+	m_nextOutputBuffer.clear();
+
+	m_blockSize = 0;
+	m_fftSize = 0;
+	m_bins = 0;
+	m_maxPartitionsCount = 0;
+	m_partitionsCount = 0;
+	m_firstPartition = 0;
+	m_delayLinePosition = 0;
+	m_fifoPosition = 0;
+	m_step = 0;
+	m_stepsCount = 0;
+}
+
+//==============================================================================
+void NonUniformPartitionedConvolution::init(const int maxImpulseResponseLength, const int headLength, const int maxBlockSize)
+{
+	m_headLength = headLength;
+	m_headTaps = 0;
+	m_head.assign(headLength, 0.0f);
+	m_headInput.assign(headLength - 1 + CHUNK_SIZE, 0.0f);
+	m_levelOutput.assign(CHUNK_SIZE, 0.0f);
+
+	m_levels.clear();
+
+	int offset = headLength;
+	int block = headLength;
+	while (offset < maxImpulseResponseLength)
+	{
+		// First level has to run immediately, next levels start late enough to run distributed
+		const bool distributed = offset >= 2 * block;
+		const int latency = distributed ? 2 * block : block;
+		jassert(offset >= latency);
+
+		// Level ends where next level can start
+		const int nextBlock = std::min(4 * block, maxBlockSize);
+		const int end = (nextBlock == block) ? maxImpulseResponseLength : std::max(2 * nextBlock, offset + block);
+
+		auto level = std::make_unique<Level>();
+		level->offset = offset;
+		level->length = std::min(end, maxImpulseResponseLength) - offset;
+
+		// Impulse response is delayed by offset - latency to compensate level latency
+		level->convolution.init(block, offset - latency + level->length, distributed);
+
+		offset += level->length;
+		block = nextBlock;
+
+		m_levels.push_back(std::move(level));
+	}
+}
+
+void NonUniformPartitionedConvolution::setImpulseResponse(const float* impulseResponse, const int length)
+{
+	m_headTaps = std::min(m_headLength, length);
+	std::fill(m_head.begin(), m_head.end(), 0.0f);
+	std::copy(impulseResponse, impulseResponse + m_headTaps, m_head.begin());
+
+	for (auto& level : m_levels)
+	{
+		const int levelLength = juce::jlimit(0, level->length, length - level->offset);
+		const int delay = level->offset - level->convolution.getLatencyInSamples();
+
+		if (levelLength > 0)
+		{
+			level->convolution.setImpulseResponse(impulseResponse + level->offset, levelLength, delay);
+		}
+		else
+		{
+			level->convolution.setImpulseResponse(impulseResponse, 0);
+		}
+	}
+}
+
+void NonUniformPartitionedConvolution::process(const float* input, float* output, const int samples) noexcept
+{
+	for (int start = 0; start < samples; start += CHUNK_SIZE)
+	{
+		processChunk(input + start, output + start, std::min(CHUNK_SIZE, samples - start));
+	}
+}
+
+float NonUniformPartitionedConvolution::process(const float in) noexcept
+{
+	float out = in;
+	processChunk(&out, &out, 1);
+	return out;
+}
+
+void NonUniformPartitionedConvolution::processChunk(const float* input, float* output, const int samples) noexcept
+{
+	const int history = m_headLength - 1;
+	float* x = m_headInput.data() + history;
+
+	// Input first, input and output can be the same buffer
+	std::memcpy(x, input, samples * sizeof(float));
+
+	// Head, direct form. Taps in outer loop, inner loop runs over contiguous samples.
+	std::fill(output, output + samples, 0.0f);
+	for (int tap = 0; tap < m_headTaps; tap++)
+	{
+		const float coefficient = m_head[tap];
+		const float* delayed = x - tap;
+
+		for (int sample = 0; sample < samples; sample++)
+		{
+			output[sample] += coefficient * delayed[sample];
+		}
+	}
+
+	// Tail
+	float* levelOutput = m_levelOutput.data();
+	for (auto& level : m_levels)
+	{
+		level->convolution.process(x, levelOutput, samples);
+
+		for (int sample = 0; sample < samples; sample++)
+		{
+			output[sample] += levelOutput[sample];
+		}
+	}
+
+	std::memmove(m_headInput.data(), m_headInput.data() + samples, history * sizeof(float));
+}
+
+void NonUniformPartitionedConvolution::reset() noexcept
+{
+	std::fill(m_headInput.begin(), m_headInput.end(), 0.0f);
+
+	for (auto& level : m_levels)
+	{
+		level->convolution.reset();
+	}
+}
+
+void NonUniformPartitionedConvolution::release()
+{
+	m_levels.clear();
+	m_head.clear();
+	m_headInput.clear();
+	m_levelOutput.clear();
+
+	m_headLength = 0;
+	m_headTaps = 0;
+}
+
+//==============================================================================
 Convolution::Convolution()
 {
 }
 
 void Convolution::init(int size)
 {
-	m_buffer.init(size);
 	m_bufferSize = size;
+	m_impulseResponse.reserve(size);
+	m_convolution.init(size);
 }
 
 void Convolution::clear()
 {
-	m_buffer.clear();
+	m_convolution.reset();
 }
 
-void Convolution::setImpulseResponse(std::vector<float> impulseResponse)
+void Convolution::setImpulseResponse(const std::vector<float>& impulseResponse)
 {
 	m_impulseResponse = impulseResponse;
+	setImpulseResponseLenght(static_cast<int>(m_impulseResponse.size()));
 }
 
-float Convolution::process(float in)
+void Convolution::setImpulseResponseLenght(int impulseResponseLenght)
 {
-	m_buffer.writeSample(in);
+	m_impulseResponseSize = std::min({ impulseResponseLenght, m_bufferSize, static_cast<int>(m_impulseResponse.size()) });
+	m_convolution.setImpulseResponse(m_impulseResponse.data(), m_impulseResponseSize);
+}
 
-	float out = 0.0f;
-	for (int i = 0; i < m_impulseResponseSize; i++)
-	{
-		out += m_buffer.readDelay(m_impulseResponseSize - i) * m_impulseResponse[i];
-	}
+float Convolution::process(float in)
+{
+	return m_convolution.process(in);
+}
 
-	return out;
-}
\ No newline at end of file
+void Convolution::process(const float* input, float* output, const int samples)
+{
+	m_convolution.process(input, output, samples);
+}
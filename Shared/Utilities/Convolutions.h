@@ -1,6 +1,123 @@
-#include "CircularBuffers.h"
+#pragma once
+
+#include <memory>
 #include <vector>
 
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+  Uniformly partitioned overlap-save FFT convolution.
+
+  Impulse response is split into partitions of blockSize samples, their spectra
+  are multiplied with a frequency domain delay line of past input spectra.
+  One FFT + one IFFT of size 2 * blockSize per blockSize samples.
+  Partitions made only of delay zeros are skipped.
+
+  Latency is blockSize samples, all work runs when a block is complete.
+  Distributed mode has latency 2 * blockSize, work of a block (FFT, one step per
+  partition, IFFT) is spread over the following block period.
+ */
+class UniformPartitionedConvolution
+{
+public:
+	UniformPartitionedConvolution() = default;
+	~UniformPartitionedConvolution() = default;
+
+	// blockSize has to be power of two. Allocates, call from prepareToPlay().
+	void init(const int blockSize, const int maxImpulseResponseLength, const bool distributed = false);
+	// Impulse response is preceded by delay zeros. Does not allocate if it fits maxImpulseResponseLength.
+	void setImpulseResponse(const float* impulseResponse, const int length, const int delay = 0);
+	void process(const float* input, float* output, const int samples) noexcept;
+	float process(const float in) noexcept;
+	void reset() noexcept;
+	void release();
+
+	int getLatencyInSamples() const noexcept { return m_distributed ? 2 * m_blockSize : m_blockSize; };
+	int getBlockSize() const noexcept { return m_blockSize; };
+	int getPartitionsCount() const noexcept { return m_partitionsCount; };
+
+private:
+	void startBlock() noexcept;
+	void runSteps(const int steps) noexcept;
+	void runStep() noexcept;
+
+	std::unique_ptr<juce::dsp::FFT> m_fft;
+	std::vector<float> m_fftBuffer;					// Interleaved complex, 2 * fftSize
+
+	std::vector<float> m_inputBuffer;				// Previous block + current block
+	std::vector<float> m_outputBuffer;				// Output of last processed block
+	std::vector<float> m_nextOutputBuffer;			// Output of block in progress
+
+	// Split complex spectra, partition p starts at p * m_bins
+	std::vector<float> m_partitionsRe;
+	std::vector<float> m_partitionsIm;
+	std::vector<float> m_delayLineRe;
+	std::vector<float> m_delayLineIm;
+	std::vector<float> m_accumulatorRe;
+	std::vector<float> m_accumulatorIm;
+
+	int m_blockSize = 0;
+	int m_fftSize = 0;
+	int m_bins = 0;
+	int m_maxPartitionsCount = 0;
+	int m_partitionsCount = 0;
+	int m_firstPartition = 0;						// Partitions before it are delay zeros
+	int m_delayLinePosition = 0;
+	int m_fifoPosition = 0;
+	int m_step = 0;									// Steps of block in progress done
+	int m_stepsCount = 0;
+	bool m_distributed = false;
+};
+
+//==============================================================================
+/**
+  Zero latency convolution with non-uniform partitioning.
+
+  First headLength samples of the impulse response are convolved directly in time domain,
+  the rest by UniformPartitionedConvolution levels with block size growing 4x per level
+  up to maxBlockSize. First level runs each block immediately, next levels start at
+  2 * blockSize and run distributed, so FFT, multiply and IFFT of large blocks are
+  spread over several process() calls.
+ */
+class NonUniformPartitionedConvolution
+{
+public:
+	NonUniformPartitionedConvolution() = default;
+	~NonUniformPartitionedConvolution() = default;
+
+	// headLength and maxBlockSize have to be power of two. Allocates, call from prepareToPlay().
+	void init(const int maxImpulseResponseLength, const int headLength = 64, const int maxBlockSize = 8192);
+	void setImpulseResponse(const float* impulseResponse, const int length);
+	void process(const float* input, float* output, const int samples) noexcept;
+	float process(const float in) noexcept;
+	void reset() noexcept;
+	void release();
+
+	int getLatencyInSamples() const noexcept { return 0; };
+
+private:
+	static constexpr int CHUNK_SIZE = 256;
+
+	struct Level
+	{
+		UniformPartitionedConvolution convolution;
+		int offset = 0;								// First impulse response sample handled by this level
+		int length = 0;
+	};
+
+	void processChunk(const float* input, float* output, const int samples) noexcept;
+
+	std::vector<std::unique_ptr<Level>> m_levels;
+	std::vector<float> m_head;
+	std::vector<float> m_headInput;					// Head history + current chunk
+	std::vector<float> m_levelOutput;
+
+	int m_headLength = 0;
+	int m_headTaps = 0;
+};
+
+//==============================================================================
 class Convolution
 {
 public:
@@ -8,13 +125,14 @@ public:
 
 	void init(int size);
 	void clear();
-	void setImpulseResponse(std::vector<float> impulseResponse);
-	inline void setImpulseResponseLenght(int impulseResponseLenght) { m_impulseResponseSize = (impulseResponseLenght > m_bufferSize) ? m_bufferSize : impulseResponseLenght; };
+	void setImpulseResponse(const std::vector<float>& impulseResponse);
+	void setImpulseResponseLenght(int impulseResponseLenght);
 	float process(float in);
-	
+	void process(const float* input, float* output, const int samples);
+
 protected:
-	CircularBuffer m_buffer = {};
+	NonUniformPartitionedConvolution m_convolution;
 	int m_bufferSize = 0;
 	std::vector<float> m_impulseResponse;
 	int m_impulseResponseSize = 0;
-};
\ No newline at end of file
+};
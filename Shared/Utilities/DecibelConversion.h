@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "../../../zazzVSTPlugins/Shared/Utilities/Math.h"
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Gain <-> dB conversion policies for dynamics gain computers.
+// All policies return -100 dB for gain below -100 dB and 0 gain for -100 dB and below.
+//
+// Maximum error against Exact in -100 dB to +24 dB range:
+//		Approx:	gainTodB 1.1e-4 dB,	dBToGain 3.5e-5 dB
+//		Table:	gainTodB 2.3e-5 dB,	dBToGain 2.0e-5 dB
+namespace DecibelConversion
+{
+	//==============================================================================
+	// juce::Decibels
+	struct Exact
+	{
+		static __forceinline float gainTodB(const float gain) noexcept
+		{
+			return juce::Decibels::gainToDecibels(gain);
+		}
+		static __forceinline float dBToGain(const float dB) noexcept
+		{
+			return juce::Decibels::decibelsToGain(dB);
+		}
+	};
+
+	//==============================================================================
+	// Polynomial log2 and exp2
+	struct Approx
+	{
+		static __forceinline float gainTodB(const float gain) noexcept
+		{
+			constexpr float LOG2_TO_DB = 6.020599913279624f;		// 20 * log10(2)
+			return gain > MINIMUM_GAIN ? LOG2_TO_DB * Math::log2ApproxPositive(gain) : -100.0f;
+		}
+		static __forceinline float dBToGain(const float dB) noexcept
+		{
+			constexpr float DB_TO_LOG2 = 0.1660964047443681f;		// log2(10) / 20
+			return dB > -100.0f ? Math::pow2Approx(DB_TO_LOG2 * dB) : 0.0f;
+		}
+
+	private:
+		static constexpr float MINIMUM_GAIN = 1e-5f;
+	};
+
+	//==============================================================================
+	// Linearly interpolated log2 of mantissa and exp2 of fraction, 256 segments each
+	struct Table
+	{
+		static __forceinline float gainTodB(const float gain) noexcept
+		{
+			if (gain <= MINIMUM_GAIN)
+			{
+				return -100.0f;
+			}
+
+			uint32_t bits;
+			std::memcpy(&bits, &gain, sizeof(float));
+
+			// Top 8 mantissa bits select segment, remaining 15 bits interpolate
+			const int exponent = (int)(bits >> 23) - 127;
+			const uint32_t index = (bits >> 15) & 0xFFu;
+			const float fraction = (float)(bits & 0x7FFFu) * (1.0f / 32768.0f);
+
+			const float* log2 = s_tables.m_log2;
+			const float value = (float)exponent + log2[index] + fraction * (log2[index + 1] - log2[index]);
+
+			return LOG2_TO_DB * value;
+		}
+		static __forceinline float dBToGain(const float dB) noexcept
+		{
+			if (dB <= -100.0f)
+			{
+				return 0.0f;
+			}
+
+			const float value = DB_TO_LOG2 * dB;
+			const int truncated = (int)value;
+			const int integer = truncated - (value < (float)truncated ? 1 : 0);
+			const float position = (value - (float)integer) * (float)SIZE;
+			const int index = std::min((int)position, SIZE - 1);		// value - integer may round up to 1.0f
+			const float fraction = position - (float)index;
+
+			const float* pow2 = s_tables.m_pow2;
+			float gain = pow2[index] + fraction * (pow2[index + 1] - pow2[index]);
+
+			uint32_t bits;
+			std::memcpy(&bits, &gain, sizeof(float));
+			bits += (uint32_t)integer << 23;
+			std::memcpy(&gain, &bits, sizeof(float));
+
+			return gain;
+		}
+
+	private:
+		static constexpr int SIZE = 256;
+		static constexpr float MINIMUM_GAIN = 1e-5f;
+		static constexpr float LOG2_TO_DB = 6.020599913279624f;
+		static constexpr float DB_TO_LOG2 = 0.1660964047443681f;
+
+		struct Tables
+		{
+			Tables()
+			{
+				for (int i = 0; i <= SIZE; i++)
+				{
+					const double x = (double)i / (double)SIZE;
+					m_log2[i] = (float)std::log2(1.0 + x);
+					m_pow2[i] = (float)std::exp2(x);
+				}
+			}
+
+			float m_log2[SIZE + 1];
+			float m_pow2[SIZE + 1];
+		};
+
+		// Filled during static initialization, before any audio thread runs
+		static inline const Tables s_tables{};
+	};
+}
@@ -20,23 +20,100 @@
 #include <JuceHeader.h>
 #include "juce_dsp/juce_dsp.h"
 
+#include <atomic>
+
 #include "../../../zazzVSTPlugins/Shared/Utilities/Math.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/SampleFifo.h"
 #include "../../../zazzVSTPlugins/Shared/GUI/SpectrumAnalyzerComponent.h"
 
+//==============================================================================
+/**
+ * Band levels of the latest fftSize samples.
+ *
+ * Audio thread only copies samples into a lock-free fifo with push().
+ * GUI thread calls update() from its timer, FFT and band averaging run there,
+ * so scope data is written and read on the same thread. init() and release()
+ * only request a reset, update() performs it.
+ */
 class FrequencySpectrum
 {
 public:
 	FrequencySpectrum() : m_forwardFFT(fftOrder), m_window(fftSize, juce::dsp::WindowingFunction<float>::hann)
 	{
+		// Allocated once, editor can read it any time
+		m_sampleFifo.init(FIFO_SIZE);
 	}
+
+	// Samples kept for GUI, 340 ms at 192 kHz
+	static constexpr int FIFO_SIZE = 1 << 16;
 	~FrequencySpectrum() = default;
 
+	// Audio thread, prepareToPlay(). GUI thread applies it in next update().
 	inline void init(const int sampleRate)
 	{
-		m_sampleRate = sampleRate;
+		m_sampleRate.store(sampleRate);
+		m_resetRequested.store(true);
+	};
+	// Audio thread
+	inline void push(const float* samples, const int count) noexcept
+	{
+		m_sampleFifo.push(samples, count);
+	}
+	// GUI thread. Consumes pushed samples, scope data holds the latest complete frame.
+	inline void update() noexcept
+	{
+		if (m_resetRequested.exchange(false))
+		{
+			reset();
+		}
+
+		const int ready = m_sampleFifo.getNumReady();
+		if (m_fifoIndex + ready < fftSize)
+		{
+			m_fifoIndex += m_sampleFifo.pop(m_fifo + m_fifoIndex, ready);
+			return;
+		}
+
+		// Only the latest fftSize samples are analyzed, older frames would not be shown anyway
+		if (ready >= fftSize)
+		{
+			m_sampleFifo.skip(ready - fftSize);
+			m_fifoIndex = 0;
+		}
+		else
+		{
+			const int keep = fftSize - ready;
+			std::memmove(m_fifo, m_fifo + m_fifoIndex - keep, keep * sizeof(float));
+			m_fifoIndex = keep;
+		}
+
+		m_sampleFifo.pop(m_fifo + m_fifoIndex, fftSize - m_fifoIndex);
+
+		juce::zeromem(m_fftData, sizeof(m_fftData));
+		memcpy(m_fftData, m_fifo, sizeof(m_fifo));
+
+		getSpectrum();
+
+		m_fifoIndex = 0;
+	}
+	// Audio thread, releaseResources(). GUI thread applies it in next update().
+	inline void release()
+	{
+		m_resetRequested.store(true);
+	}
+	// GUI thread
+	float(&getScopeData())[scopeSize]
+	{
+		return m_scopeData;
+	}
 
+
+private:
+	// GUI thread, indexes and frame state are only touched here
+	void reset() noexcept
+	{
 		// Get indexes
-		const int bucketFreq = m_sampleRate / fftSize;
+		const int bucketFreq = m_sampleRate.load() / fftSize;
 
 		for (int i = 0; i < scopeSize; i++)
 		{
@@ -53,37 +130,10 @@ public:
 		std::fill(std::begin(m_fifo), std::end(m_fifo), 0.0f);
 		std::fill(std::begin(m_fftData), std::end(m_fftData), 0.0f);
 		std::fill(std::begin(m_scopeData), std::end(m_scopeData), 0.0f);
-	};
-	inline void process(const float sample) noexcept
-	{
-		m_fifo[m_fifoIndex] = sample;
-		m_fifoIndex++;
-
-		if (m_fifoIndex == fftSize)
-		{
-			juce::zeromem(m_fftData, sizeof(m_fftData));
-			memcpy(m_fftData, m_fifo, sizeof(m_fifo));
-
-			getSpectrum();
-
-			m_fifoIndex = 0;
-		}
-	}
-	inline void release()
-	{
-		std::fill(std::begin(m_fifo), std::end(m_fifo), 0.0f);
-		std::fill(std::begin(m_fftData), std::end(m_fftData), 0.0f);
-		std::fill(std::begin(m_scopeData), std::end(m_scopeData), 0.0f);
 
+		m_sampleFifo.clear();
 		m_fifoIndex = 0;
 	}
-	float(&getScopeData())[scopeSize]
-	{
-		return m_scopeData;
-	}
-
-
-private:
 	void getSpectrum()
 	{
 		// first apply a m_windowing function to our data
@@ -119,6 +169,7 @@ private:
 
 	juce::dsp::FFT m_forwardFFT;                      
 	juce::dsp::WindowingFunction<float> m_window;     
+	SampleFifo m_sampleFifo;
 
 	float m_fifo[fftSize];                            
 	float m_fftData[2 * fftSize];                     
@@ -128,5 +179,6 @@ private:
 	const int frequencies[scopeSize + 1] = { 100, 200, 300, 400, 500, 600, 700, 800, 1000, 2000, 4000, 6000, 8000, 10000, 12000, 16000, 20000 };
 	
 	int m_fifoIndex = 0;
-	int m_sampleRate = 48000;
+	std::atomic<int> m_sampleRate{ 48000 };
+	std::atomic<bool> m_resetRequested{ true };
 };
\ No newline at end of file
@@ -18,6 +18,8 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace Math
 {
@@ -85,6 +87,68 @@ namespace Math
 		return Y;
 	}
 
+	//==============================================================================
+	// Fast approximation to log2() for positive normal value, max error 1.7e-5
+	// Y = P(M - 1) + E, value = M * 2^E, M in [1, 2), P is 5th order polynomial
+	__forceinline float log2ApproxPositive(const float value) noexcept
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(float));
+
+		const int E = (int)(bits >> 23) - 127;
+		bits = (bits & 0x007FFFFFu) | 0x3F800000u;
+
+		float M;
+		std::memcpy(&M, &bits, sizeof(float));
+		const float F = M - 1.0f;
+
+		float Y = 0.0430049578f;
+		Y *= F;
+		Y += -0.187488605f;
+		Y *= F;
+		Y += 0.409470299f;
+		Y *= F;
+		Y += -0.706486449f;
+		Y *= F;
+		Y += 1.44149241f;
+		Y *= F;
+		Y += 1.65146709e-5f;
+		Y += (float)E;
+
+		return Y;
+	}
+
+	//==============================================================================
+	// This is a fast approximation to exp2() for value in (-126.0f, 127.0f)
+	// 2^value = 2^N * P(F), F in [-0.5, 0.5], P is 5th order Taylor polynomial
+	__forceinline float pow2Approx(const float value) noexcept
+	{
+		// Round to nearest, truncation corrected for negative values
+		const float rounded = value + 0.5f;
+		const int truncated = (int)rounded;
+		const int N = truncated - (rounded < (float)truncated ? 1 : 0);
+		const float F = value - (float)N;
+
+		float Y = 1.33335581e-3f;
+		Y *= F;
+		Y += 9.61812911e-3f;
+		Y *= F;
+		Y += 5.55041087e-2f;
+		Y *= F;
+		Y += 2.40226507e-1f;
+		Y *= F;
+		Y += 6.93147181e-1f;
+		Y *= F;
+		Y += 1.0f;
+
+		uint32_t bits;
+		std::memcpy(&bits, &Y, sizeof(float));
+		bits += (uint32_t)N << 23;
+		std::memcpy(&Y, &bits, sizeof(float));
+
+		return Y;
+	}
+
 	//==============================================================================
 	// log10f is exactly log2(x) / log2(10.0f)
 	__forceinline float log10Approx(const float value) noexcept
@@ -96,7 +160,7 @@ namespace Math
 	// powf(10.f,x) is exactly exp(log(10.0f)*x)
 	__forceinline float pow10(const float value) noexcept
 	{
-		return std::expf(2.302585092994046f * value);
+		return std::exp(2.302585092994046f * value);
 	}
 
 	//==============================================================================
@@ -158,19 +222,19 @@ namespace Math
 	//==============================================================================
 	__forceinline float melToFrequency(const float mel) noexcept
 	{
-		return 700.0f * (std::expf(mel / 1127.0f) - 1.0f);
+		return 700.0f * (std::exp(mel / 1127.0f) - 1.0f);
 	}
 
 	//==============================================================================
 	__forceinline float shiftFrequency(float frequency, float semitones) noexcept
 	{
-		return frequency * std::exp2f(semitones / 12.0f);
+		return frequency * std::exp2(semitones / 12.0f);
 	}
 
 	//==============================================================================
 	__forceinline float noteToFrequency(int midiNoteNumber) noexcept
 	{
-		return 440.0f * std::exp2f((float)(midiNoteNumber - 69) / 12.0f);
+		return 440.0f * std::exp2((float)(midiNoteNumber - 69) / 12.0f);
 	}
 	//==============================================================================
 	__forceinline bool almostEquals(const float a, const float b, const float epsilon = 0.001f) noexcept
@@ -72,8 +72,16 @@ public:
 	static std::vector<Point3D> CreateFibonacciSphere(int numPoints)
 	{
 		std::vector<Point3D> points;
-		points.reserve(numPoints);
+		points.resize(numPoints);
 
+		CreateFibonacciSphere(points.data(), numPoints);
+
+		return points;
+	}
+
+	// Fills numPoints points, does not allocate
+	static void CreateFibonacciSphere(Point3D* points, int numPoints)
+	{
 		// Calculate the golden angle in radians
 		const float goldenAngle = M_PI * (3.0f - std::sqrt(5.0f));
 
@@ -89,10 +97,8 @@ public:
 			float x = radius * std::cos(theta);
 			float z = radius * std::sin(theta);
 
-			points.push_back({ x, y, z });
+			points[i] = { x, y, z };
 		}
-
-		return points;
 	}
 
 	//==============================================================================
@@ -122,6 +128,14 @@ public:
 	//==============================================================================
 	// Get distances to intersections between box and rays from Fibonacci sphere
 	static void GetDistances(std::vector<float>& distances, const float lenght, const float width, const float height, Point3D spherePosition, int rayCount)
+	{
+		std::vector<Point3D> points = Math3D::CreateFibonacciSphere(rayCount);
+
+		GetDistances(distances.data(), points.data(), lenght, width, height, spherePosition, rayCount);
+	}
+
+	// Same as above for precomputed Fibonacci sphere points, does not allocate
+	static void GetDistances(float* distances, const Point3D* points, const float lenght, const float width, const float height, Point3D spherePosition, int rayCount)
 	{
 		Point3D mins, maxs;
 		mins.x = -0.5f * lenght;
@@ -132,19 +146,12 @@ public:
 		maxs.y = 0.5f * width;
 		maxs.z = 0.5f * height;
 
-		std::vector<Point3D> points = Math3D::CreateFibonacciSphere(rayCount);
-
-		// TODO: Remove this hack
 		for (int i = 0; i < rayCount; i++)
 		{
-			points[i].x = points[i].x * 100.0f;
-			points[i].y = points[i].y * 100.0f;
-			points[i].z = points[i].z * 100.0f;
-		}
+			// TODO: Remove this hack
+			const Point3D outerPoint = Math3D::multiply(points[i], 100.0f);
 
-		for (int i = 0; i < rayCount; i++)
-		{
-			Point3D p = Math3D::GetIntersection(points[i], spherePosition, mins, maxs);
+			Point3D p = Math3D::GetIntersection(outerPoint, spherePosition, mins, maxs);
 			distances[i] = Math3D::lenght(p);
 		}
 	}
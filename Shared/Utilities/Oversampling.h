@@ -17,71 +17,551 @@
 
 #pragma once
 
+#include <JuceHeader.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstring>
+#include <vector>
+
+//==============================================================================
+// Linear phase 2x stage.
+// Half-band FIR has every second tap zero except the center one, so only the even
+// polyphase branch needs convolution, the odd branch is a plain delay.
+// Taps are symmetric, each coefficient is applied to a pair of samples.
+class HalfBandFIR
+{
+public:
+	HalfBandFIR() = default;
+	~HalfBandFIR() = default;
+
+	// transition: half of transition band width, relative to the high sample rate (0 - 0.25)
+	// maxSamples: maximum number of low sample rate samples per call
+	inline void init(const float transition, const float attenuationdB, const int maxSamples)
+	{
+		design(transition, attenuationdB);
+
+		const int history = 2 * m_halfLength - 1;
+		m_upInput.assign(history + maxSamples, 0.0f);
+		m_upEven.assign(maxSamples, 0.0f);
+		m_downEven.assign(history + maxSamples, 0.0f);
+		m_downOdd.assign(m_halfLength + maxSamples, 0.0f);
+	};
+	inline void upsample(const float* input, float* output, const int samples) noexcept
+	{
+		const int history = 2 * m_halfLength - 1;
+		float* x = m_upInput.data() + history;
+		float* even = m_upEven.data();
+
+		std::memcpy(x, input, samples * sizeof(float));
+
+		// Even branch, taps in outer loop so inner loop runs over contiguous samples
+		std::memset(even, 0, samples * sizeof(float));
+		for (int tap = 0; tap < m_halfLength; tap++)
+		{
+			const float coefficient = 2.0f * m_coefficients[tap];
+			const float* x1 = x - tap;
+			const float* x2 = x - history + tap;
+
+			for (int sample = 0; sample < samples; sample++)
+			{
+				even[sample] += coefficient * (x1[sample] + x2[sample]);
+			}
+		}
+
+		// Odd branch is center tap only
+		const float* delayed = x - (m_halfLength - 1);
+		for (int sample = 0; sample < samples; sample++)
+		{
+			output[2 * sample] = even[sample];
+			output[2 * sample + 1] = delayed[sample];
+		}
+
+		std::memmove(m_upInput.data(), m_upInput.data() + samples, history * sizeof(float));
+	};
+	// samples: number of output samples. Can run in place.
+	inline void downsample(const float* input, float* output, const int samples) noexcept
+	{
+		const int history = 2 * m_halfLength - 1;
+		float* even = m_downEven.data() + history;
+		float* odd = m_downOdd.data() + m_halfLength;
+
+		for (int sample = 0; sample < samples; sample++)
+		{
+			even[sample] = input[2 * sample];
+			odd[sample] = input[2 * sample + 1];
+		}
+
+		const float* delayed = odd - m_halfLength;
+		for (int sample = 0; sample < samples; sample++)
+		{
+			output[sample] = 0.5f * delayed[sample];
+		}
+
+		for (int tap = 0; tap < m_halfLength; tap++)
+		{
+			const float coefficient = m_coefficients[tap];
+			const float* x1 = even - tap;
+			const float* x2 = even - history + tap;
+
+			for (int sample = 0; sample < samples; sample++)
+			{
+				output[sample] += coefficient * (x1[sample] + x2[sample]);
+			}
+		}
+
+		std::memmove(m_downEven.data(), m_downEven.data() + samples, history * sizeof(float));
+		std::memmove(m_downOdd.data(), m_downOdd.data() + samples, m_halfLength * sizeof(float));
+	};
+	// Up + down latency in low sample rate samples
+	inline float getLatency() const noexcept
+	{
+		return static_cast<float>(2 * m_halfLength - 1);
+	};
+	inline void reset() noexcept
+	{
+		std::fill(m_upInput.begin(), m_upInput.end(), 0.0f);
+		std::fill(m_downEven.begin(), m_downEven.end(), 0.0f);
+		std::fill(m_downOdd.begin(), m_downOdd.end(), 0.0f);
+	};
+	inline void release()
+	{
+		m_coefficients.clear();
+		m_upInput.clear();
+		m_upEven.clear();
+		m_downEven.clear();
+		m_downOdd.clear();
+		m_halfLength = 1;
+	};
 
-#include "../../../zazzVSTPlugins/Shared/Filters/HighOrderBiquadFilter.h"
-#include "../../../zazzVSTPlugins/Shared/Utilities/AudioBuffer.h"
+private:
+	// Kaiser windowed sinc, cutoff at quarter of sample rate
+	inline void design(const float transition, const float attenuationdB)
+	{
+		// Kaiser length estimate, transition band is 2 * transition wide
+		const double taps = (attenuationdB - 7.95) / (14.36 * 2.0 * transition) + 1.0;
+		m_halfLength = std::max(2, static_cast<int>(std::ceil((taps + 1.0) / 4.0)));
+
+		const double beta = attenuationdB > 50.0f ? 0.1102 * (attenuationdB - 8.7) : 0.5842 * std::pow(attenuationdB - 21.0, 0.4) + 0.07886 * (attenuationdB - 21.0);
+		const int length = 4 * m_halfLength - 1;
+		const int center = 2 * m_halfLength - 1;
+		const double i0Beta = besselI0(beta);
+
+		// Store non zero taps h[0], h[2], ... h[center - 1]
+		m_coefficients.resize(m_halfLength);
+		for (int tap = 0; tap < m_halfLength; tap++)
+		{
+			const int n = 2 * tap;
+			const double offset = static_cast<double>(n - center);
+			const double sinc = std::sin(0.5 * 3.141592653589793 * offset) / (3.141592653589793 * offset);
+			const double ratio = 2.0 * static_cast<double>(n) / static_cast<double>(length - 1) - 1.0;
+			const double window = besselI0(beta * std::sqrt(1.0 - ratio * ratio)) / i0Beta;
 
+			m_coefficients[tap] = static_cast<float>(sinc * window);
+		}
+
+		// Normalize DC gain of even branch to 0.5, center tap gives the other half
+		double sum = 0.0;
+		for (const float coefficient : m_coefficients)
+		{
+			sum += 2.0 * coefficient;
+		}
+
+		for (auto& coefficient : m_coefficients)
+		{
+			coefficient = static_cast<float>(coefficient * 0.5 / sum);
+		}
+	};
+	inline static double besselI0(const double x)
+	{
+		double sum = 1.0;
+		double term = 1.0;
+		const double halfX = 0.5 * x;
+
+		for (int k = 1; k < 50; k++)
+		{
+			term *= (halfX / k) * (halfX / k);
+			sum += term;
+
+			if (term < 1e-12 * sum)
+			{
+				break;
+			}
+		}
+
+		return sum;
+	};
+
+	std::vector<float> m_coefficients;
+	std::vector<float> m_upInput;
+	std::vector<float> m_upEven;
+	std::vector<float> m_downEven;
+	std::vector<float> m_downOdd;
+	int m_halfLength = 1;
+};
+
+//==============================================================================
+// Minimum phase 2x stage.
+// Polyphase IIR half-band, two parallel chains of first order all-pass filters
+// running at low sample rate. Coefficients designed as elliptic half-band
+// (Valenzuela & Constantinides), same approach as JUCE filterHalfBandPolyphaseIIR.
+class HalfBandIIR
+{
+public:
+	HalfBandIIR() = default;
+	~HalfBandIIR() = default;
+
+	static constexpr int MAX_COEFFICIENTS = 16;
+
+	inline void init(const float transition, const float attenuationdB)
+	{
+		design(transition, attenuationdB);
+		reset();
+	};
+	inline void upsample(const float* input, float* output, const int samples) noexcept
+	{
+		process<false>(input, output, samples);
+	};
+	// samples: number of output samples. Can run in place.
+	inline void downsample(const float* input, float* output, const int samples) noexcept
+	{
+		process<true>(input, output, samples);
+	};
+	// Up + down group delay at DC in low sample rate samples
+	inline float getLatency() const noexcept
+	{
+		// First order all-pass (a + z^-1) / (1 + a z^-1) has DC group delay (1 - a) / (1 + a).
+		// Paths run at low rate. Up odd phase is half a sample late, down takes the odd phase half a sample early, they cancel.
+		double delay = 0.0;
+
+		for (int i = 0; i < m_coefficientsCount; i++)
+		{
+			const double a = m_coefficients[i];
+			delay += (1.0 - a) / (1.0 + a);
+		}
+
+		return static_cast<float>(delay);
+	};
+	inline void reset() noexcept
+	{
+		m_up = {};
+		m_down = {};
+	};
+	inline void release() noexcept
+	{
+		reset();
+		m_coefficients = {};
+		m_coefficientsCount = 0;
+	};
+
+private:
+	struct State
+	{
+		std::array<float, MAX_COEFFICIENTS> x1 = {};
+		std::array<float, MAX_COEFFICIENTS> y1 = {};
+	};
+
+	// Coefficients count is a template argument, so both all-pass chains are fully unrolled
+	// and their states stay in registers for the whole block.
+	template <bool Down, int Count = MAX_COEFFICIENTS>
+	inline void process(const float* input, float* output, const int samples) noexcept
+	{
+		if (m_coefficientsCount == Count)
+		{
+			processChains<Down, Count>(Down ? m_down : m_up, input, output, samples);
+		}
+		else if constexpr (Count > 1)
+		{
+			process<Down, Count - 1>(input, output, samples);
+		}
+	};
+
+	// Path 0 uses coefficients 0, 2, 4..., path 1 uses 1, 3, 5...
+	template <bool Down, int Count>
+	inline void processChains(State& state, const float* input, float* output, const int samples) noexcept
+	{
+		float a[Count];
+		float x1[Count];
+		float y1[Count];
+
+		for (int i = 0; i < Count; i++)
+		{
+			a[i] = m_coefficients[i];
+			x1[i] = state.x1[i];
+			y1[i] = state.y1[i];
+		}
+
+		for (int sample = 0; sample < samples; sample++)
+		{
+			// Up: both paths get the same input, each gives one output sample
+			// Down: path 0 gets the newer sample, path 1 the older one
+			float even = Down ? input[2 * sample + 1] : input[sample];
+			float odd = Down ? input[2 * sample] : input[sample];
+
+			for (int i = 0; i < Count; i += 2)
+			{
+				const float outEven = a[i] * (even - y1[i]) + x1[i];
+				x1[i] = even;
+				y1[i] = outEven;
+				even = outEven;
+
+				if (i + 1 < Count)
+				{
+					const float outOdd = a[i + 1] * (odd - y1[i + 1]) + x1[i + 1];
+					x1[i + 1] = odd;
+					y1[i + 1] = outOdd;
+					odd = outOdd;
+				}
+			}
+
+			if (Down)
+			{
+				output[sample] = 0.5f * (even + odd);
+			}
+			else
+			{
+				output[2 * sample] = even;
+				output[2 * sample + 1] = odd;
+			}
+		}
+
+		for (int i = 0; i < Count; i++)
+		{
+			state.x1[i] = x1[i];
+			state.y1[i] = y1[i];
+		}
+	};
+
+	inline void design(const float transition, const float attenuationdB)
+	{
+		constexpr double pi = 3.141592653589793;
+
+		// Transition parameters
+		double k = std::tan((1.0 - 4.0 * transition) * pi / 4.0);
+		k *= k;
+		const double kksqrt = std::pow(1.0 - k * k, 0.25);
+		const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+		const double e4 = e * e * e * e;
+		const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+		// Order from stop band attenuation
+		const double attenuation = std::pow(10.0, -attenuationdB / 10.0);
+		const double a = attenuation / (1.0 - attenuation);
+		int order = static_cast<int>(std::ceil(std::log(a * a / 16.0) / std::log(q)));
+		order = std::max(3, order | 1);
+
+		m_coefficientsCount = std::min(MAX_COEFFICIENTS, (order - 1) / 2);
+		order = 2 * m_coefficientsCount + 1;
+
+		for (int i = 0; i < m_coefficientsCount; i++)
+		{
+			const int c = i + 1;
+
+			double numerator = 0.0;
+			double sign = 1.0;
+			for (int j = 0; j < 100; j++)
+			{
+				const double term = sign * std::pow(q, j * (j + 1)) * std::sin((2 * j + 1) * c * pi / order);
+				numerator += term;
+				sign = -sign;
+
+				if (std::fabs(term) < 1e-100)
+					break;
+			}
+
+			double denominator = 0.0;
+			sign = -1.0;
+			for (int j = 1; j < 100; j++)
+			{
+				const double term = sign * std::pow(q, j * j) * std::cos(2 * j * c * pi / order);
+				denominator += term;
+				sign = -sign;
+
+				if (std::fabs(term) < 1e-100)
+					break;
+			}
+
+			const double ww = numerator * std::pow(q, 0.25) / (denominator + 0.5);
+			const double wwsq = ww * ww;
+			const double x = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+
+			m_coefficients[i] = static_cast<float>((1.0 - x) / (1.0 + x));
+		}
+	};
+
+	std::array<float, MAX_COEFFICIENTS> m_coefficients = {};
+	State m_up;
+	State m_down;
+	int m_coefficientsCount = 0;
+};
+
+//==============================================================================
+// 2x, 4x, 8x or 16x oversampling, cascade of half-band stages. Single channel.
+// Usage per block: oversample() -> process getOversampeBuffer() -> downsample()
 class Oversampling
 {
 public:
 	Oversampling() {};
 
-	inline void init(const int sampleRate, const int oversamplingRation, const int samples)
+	enum class Phase
 	{
-		m_samples = samples;
-		m_oversampleSamples = oversamplingRation * samples;
-		m_oversamplingRatio = oversamplingRation;
-		
-		m_buffer.init(m_oversampleSamples);
-		
-		// Set downsample filter
-		m_downsampleFilter.init(sampleRate * oversamplingRation);
-		m_downsampleFilter.setLowPass(10000.0f, 1.0);
-	}
-	inline void oversample(float* inputBuffer)
+		Linear,
+		Minimum
+	};
+
+	static constexpr int MAX_STAGES = 4;
+
+	// oversamplingRatio has to be 2, 4, 8 or 16. samples is the maximum block size.
+	inline void init(const int sampleRate, const int oversamplingRatio, const int samples, const Phase phase = Phase::Minimum)
 	{
-		for (int sample = 0; sample < m_samples; sample++)
+		jassert(juce::isPowerOfTwo(oversamplingRatio) && oversamplingRatio >= 2 && oversamplingRatio <= (1 << MAX_STAGES));
+
+		m_stagesCount = 1;
+		while ((1 << m_stagesCount) < oversamplingRatio && m_stagesCount < MAX_STAGES)
 		{
-			m_buffer.m_buffer[sample * m_oversamplingRatio] = inputBuffer[sample];
-			m_buffer.m_buffer[sample * m_oversamplingRatio + 1] = inputBuffer[sample];
+			m_stagesCount++;
+		}
+
+		m_oversamplingRatio = 1 << m_stagesCount;
+		m_samples = samples;
+		m_oversampleSamples = m_oversamplingRatio * samples;
+		m_sampleRate = sampleRate;
+		m_phase = phase;
+
+		for (int stage = 0; stage < m_stagesCount; stage++)
+		{
+			// Pass band up to PASS_BAND * base sample rate, stop band starts where images of it would land.
+			// First stage is the steep one, later stages get much wider transition bands.
+			const float passBand = PASS_BAND / static_cast<float>(2 << stage);
+			const float transition = 0.25f - passBand;
+			const int stageInputSamples = samples << stage;
+
+			m_linearStages[stage].init(transition, ATTENUATION_DB, stageInputSamples);
+			m_minimumStages[stage].init(transition, ATTENUATION_DB);
+			m_buffers[stage].assign(2 * stageInputSamples, 0.0f);
 		}
 	};
-	inline void downsample(float* outputBuffer)
+	// Up to getMaxSamples(), split larger host blocks. Longer blocks are clamped.
+	inline void oversample(const float* inputBuffer, int samples) noexcept
 	{
-		for (int overSample = 0; overSample < m_oversampleSamples; overSample++)
+		jassert(samples <= m_samples);
+		samples = std::min(samples, m_samples);
+
+		const float* input = inputBuffer;
+		for (int stage = 0; stage < m_stagesCount; stage++)
 		{
-			m_buffer.m_buffer[overSample] = m_downsampleFilter.processDF1(m_buffer.m_buffer[overSample]);
+			const int stageSamples = samples << stage;
+			float* output = m_buffers[stage].data();
+
+			if (m_phase == Phase::Linear)
+				m_linearStages[stage].upsample(input, output, stageSamples);
+			else
+				m_minimumStages[stage].upsample(input, output, stageSamples);
+
+			input = output;
 		}
 
-		for (int sample = 0; sample < m_samples; sample++)
+		m_oversampleSamples = m_oversamplingRatio * samples;
+	};
+	inline void downsample(float* outputBuffer, int samples) noexcept
+	{
+		jassert(samples <= m_samples);
+		samples = std::min(samples, m_samples);
+
+		for (int stage = m_stagesCount - 1; stage >= 0; stage--)
 		{
-			outputBuffer[sample] = m_buffer.m_buffer[sample * m_oversamplingRatio];
+			const int stageSamples = samples << stage;
+			const float* input = m_buffers[stage].data();
+			float* output = stage > 0 ? m_buffers[stage - 1].data() : outputBuffer;
+
+			if (m_phase == Phase::Linear)
+				m_linearStages[stage].downsample(input, output, stageSamples);
+			else
+				m_minimumStages[stage].downsample(input, output, stageSamples);
+		}
+	};
+	inline void oversample(float* inputBuffer)
+	{
+		oversample(inputBuffer, m_samples);
+	};
+	inline void downsample(float* outputBuffer)
+	{
+		downsample(outputBuffer, m_samples);
+	};
+	inline void reset() noexcept
+	{
+		for (int stage = 0; stage < MAX_STAGES; stage++)
+		{
+			m_linearStages[stage].reset();
+			m_minimumStages[stage].reset();
+			std::fill(m_buffers[stage].begin(), m_buffers[stage].end(), 0.0f);
 		}
 	};
 	inline void release()
 	{
-		m_buffer.release();
+		for (int stage = 0; stage < MAX_STAGES; stage++)
+		{
+			m_linearStages[stage].release();
+			m_minimumStages[stage].release();
+			m_buffers[stage].clear();
+		}
 
 		m_oversamplingRatio = 2;
+		m_stagesCount = 1;
 		m_samples = 0;
 		m_oversampleSamples = 0;
-
 	};
 	inline float* getOversampeBuffer()
 	{
-		return m_buffer.m_buffer;
+		return m_buffers[m_stagesCount - 1].data();
 	};
 	inline int getOversampeBufferSize()
 	{
 		return m_oversampleSamples;
 	};
+	inline int getMaxSamples() const noexcept
+	{
+		return m_samples;
+	};
+	inline int getOversamplingRatio() const noexcept
+	{
+		return m_oversamplingRatio;
+	};
+	inline int getOversampledSampleRate() const noexcept
+	{
+		return m_oversamplingRatio * m_sampleRate;
+	};
+	// Round trip latency in base sample rate samples
+	inline float getLatency() const noexcept
+	{
+		float latency = 0.0f;
+
+		for (int stage = 0; stage < m_stagesCount; stage++)
+		{
+			const float stageLatency = (m_phase == Phase::Linear) ? m_linearStages[stage].getLatency() : m_minimumStages[stage].getLatency();
+			latency += stageLatency / static_cast<float>(1 << stage);
+		}
+
+		return latency;
+	};
+	inline int getLatencyInSamples() const noexcept
+	{
+		return static_cast<int>(std::round(getLatency()));
+	};
 
 private:
-	AudioBuffer m_buffer;
-	BiquadFilter m_downsampleFilter;
-	
+	static constexpr float PASS_BAND = 0.455f;		// Relative to base sample rate, 20 kHz at 44.1 kHz
+	static constexpr float ATTENUATION_DB = 100.0f;
+
+	std::array<HalfBandFIR, MAX_STAGES> m_linearStages;
+	std::array<HalfBandIIR, MAX_STAGES> m_minimumStages;
+	std::array<std::vector<float>, MAX_STAGES> m_buffers;
+	Phase m_phase = Phase::Minimum;
+
 	int m_oversamplingRatio = 2;
+	int m_stagesCount = 1;
+	int m_sampleRate = 48000;
 	int m_samples = 0;								// Stores original buffer size
 	int m_oversampleSamples = 0;
-};
\ No newline at end of file
+};
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+//==============================================================================
+// Block rate copy of APVTS parameters with per parameter change flags.
+// Count is the size of the processor's Parameters enum, up to 64 parameters.
+//
+// Usage:	m_parameters.init(apvts, paramsNames);						// constructor
+//			if (m_parameters.update())									// processBlock
+//				if (m_parameters.hasChanged({ Parameters::Time, Parameters::Size }))
+//					... rebuild what depends on time and size ...
+//
+// First update() after init() or invalidate() reports every parameter as changed.
+template <int Count>
+class ParameterSnapshot
+{
+	static_assert(Count > 0 && Count <= 64, "ParameterSnapshot supports 1 to 64 parameters");
+
+public:
+	ParameterSnapshot() = default;
+	~ParameterSnapshot() = default;
+
+	static constexpr int COUNT = Count;
+
+	template <typename APVTS>
+	inline void init(APVTS& apvts, const std::string* names)
+	{
+		for (int i = 0; i < Count; i++)
+		{
+			m_parameters[i] = apvts.getRawParameterValue(names[i]);
+			jassert(m_parameters[i] != nullptr);
+		}
+
+		invalidate();
+	};
+	// Loads all parameters, returns true if any of them changed since the last update
+	inline bool update() noexcept
+	{
+		uint64_t changed = m_invalidated ? ALL : 0u;
+		m_invalidated = false;
+
+		for (int i = 0; i < Count; i++)
+		{
+			const float value = m_parameters[i]->load(std::memory_order_relaxed);
+
+			if (value != m_values[i])
+			{
+				m_values[i] = value;
+				changed |= getBit(i);
+			}
+		}
+
+		m_changed = changed;
+		return changed != 0u;
+	};
+	// Next update() reports all parameters as changed, use after prepareToPlay()
+	inline void invalidate() noexcept
+	{
+		m_invalidated = true;
+	};
+
+	inline float get(const int parameter) const noexcept
+	{
+		return m_values[parameter];
+	};
+	inline bool hasChanged(const int parameter) const noexcept
+	{
+		return (m_changed & getBit(parameter)) != 0u;
+	};
+	inline bool hasChanged(std::initializer_list<int> parameters) const noexcept
+	{
+		uint64_t mask = 0u;
+		for (const int parameter : parameters)
+		{
+			mask |= getBit(parameter);
+		}
+
+		return (m_changed & mask) != 0u;
+	};
+
+private:
+	static constexpr uint64_t ALL = Count == 64 ? ~uint64_t(0) : (uint64_t(1) << Count) - 1u;
+
+	static constexpr uint64_t getBit(const int parameter) noexcept
+	{
+		return uint64_t(1) << parameter;
+	};
+
+	std::atomic<float>* m_parameters[Count] = {};
+	float m_values[Count] = {};
+	uint64_t m_changed = 0u;
+	bool m_invalidated = true;
+};
@@ -15,114 +15,452 @@
  * along with this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
-#pragma
+#pragma once
+
+#include <memory>
+#include <vector>
 
 #include <JuceHeader.h>
 #include "juce_dsp/juce_dsp.h"
 
 #include "../../../zazzVSTPlugins/Shared/Utilities/Math.h"
 
+//==============================================================================
+/**
+ * Monophonic pitch tracker. Last SIZE input samples are analysed every HOP samples.
+ *
+ * FFT:		loudest bin in frequency range, refined by parabolic interpolation of log
+ *			magnitudes and by phase advance since previous hop (phase vocoder).
+ *			Confidence is energy of the peak main lobe relative to energy in range.
+ * YIN:		cumulative mean normalized difference function, confidence is 1 - d'(tau).
+ * McLeod:	normalized square difference function, confidence is clarity n(tau).
+ *
+ * YIN and McLeod need only two periods of the lowest frequency, so they work with
+ * smaller SIZE and lower latency than FFT. Their autocorrelation is computed by
+ * 2 * SIZE FFT. All buffers are allocated in init(), process() does not allocate.
+ */
 class PitchDetection
 {
 public:
-	static const int FFT_ORDER = 12;
-	static const int FFT_SIZE = 1 << FFT_ORDER;
-	
-	PitchDetection() : m_forwardFFT(FFT_ORDER), m_window(FFT_SIZE, juce::dsp::WindowingFunction<float>::hann)
+	enum class Type
 	{
-	}
+		FFT,
+		YIN,
+		McLeod
+	};
+
+	struct Pitch
+	{
+		float frequency;
+		float confidence;
+	};
+
+	static const int FFT_ORDER = 12;
+	static const int FFT_ORDER_MIN = 8;
+	static const int FFT_ORDER_MAX = 15;
+	static const int HOP_SIZE = 1024;
+
+	PitchDetection() = default;
 	~PitchDetection() = default;
 
-	inline void init(const int sampleRate) noexcept
+	inline void init(const int sampleRate, const int fftOrder = FFT_ORDER, const int hopSize = HOP_SIZE)
 	{
+		jassert(fftOrder >= FFT_ORDER_MIN && fftOrder <= FFT_ORDER_MAX);
+
 		m_sampleRate = sampleRate;
+		m_size = 1 << fftOrder;
+		m_hopSize = juce::jlimit(1, m_size, hopSize);
+
+		m_fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+		m_autocorrelationFFT = std::make_unique<juce::dsp::FFT>(fftOrder + 1);
 
-		// Set arrays to zero
-		std::fill(std::begin(m_fifo), std::end(m_fifo), 0.0f);
-		std::fill(std::begin(m_fftData), std::end(m_fftData), 0.0f);
+		m_window.resize(m_size);
+		juce::dsp::WindowingFunction<float>::fillWindowingTables(m_window.data(), (size_t)m_size, juce::dsp::WindowingFunction<float>::hann, false);
+
+		m_history.resize(m_size);
+		m_frame.resize(m_size);
+		m_fftData.resize(4 * m_size);
+		m_spectrumLast.resize(m_size + 2);
+		m_lag.resize(m_size / 2 + 2);
+
+		reset();
+	};
+	inline void setType(const Type type)
+	{
+		if (type != m_type)
+		{
+			m_type = type;
+			m_hasSpectrumLast = false;
+		}
 	};
-	inline void set(const float frequencyMin, const float frequencyMax)
+	// Frequency is held when confidence is below minimumConfidence
+	inline void set(const float frequencyMin, const float frequencyMax, const float minimumConfidence = 0.0f)
 	{
-		const int bucketFrequency = m_sampleRate / FFT_SIZE;
-		
-		m_bucketIndexMin = static_cast<int>(frequencyMin) / bucketFrequency;
-		m_bucketIndexMax = static_cast<int>(frequencyMax) / bucketFrequency;
-	}
+		m_frequencyMin = frequencyMin;
+		m_frequencyMax = frequencyMax;
+		m_minimumConfidence = minimumConfidence;
+	};
 	inline void process(const float sample) noexcept
 	{
-		m_fifo[m_fifoIndex] = sample;
-		m_fifoIndex++;
+		m_history[m_writeIndex] = sample;
+		m_writeIndex = (m_writeIndex + 1) & (m_size - 1);
 
-		if (m_fifoIndex == FFT_SIZE)
+		if (++m_hopIndex == m_hopSize)
 		{
-			juce::zeromem(m_fftData, sizeof(m_fftData));
-			memcpy(m_fftData, m_fifo, sizeof(m_fifo));
-
-			_getFrequency();
-
-			m_fifoIndex = 0;
+			m_hopIndex = 0;
+			analyse();
 		}
-	}
+	};
+	inline void reset() noexcept
+	{
+		std::fill(m_history.begin(), m_history.end(), 0.0f);
+		std::fill(m_spectrumLast.begin(), m_spectrumLast.end(), 0.0f);
+
+		m_writeIndex = 0;
+		m_hopIndex = 0;
+		m_hasSpectrumLast = false;
+		m_confidence = 0.0f;
+	};
 	inline void release() noexcept
 	{
-		std::fill(std::begin(m_fifo), std::end(m_fifo), 0.0f);
-		std::fill(std::begin(m_fftData), std::end(m_fftData), 0.0f);
+		m_fft.reset();
+		m_autocorrelationFFT.reset();
 
-		m_fifoIndex = 0;
+		m_window.clear();
+		m_history.clear();
+		m_frame.clear();
+		m_fftData.clear();
+		m_spectrumLast.clear();
+		m_lag.clear();
+
+		m_writeIndex = 0;
+		m_hopIndex = 0;
 		m_sampleRate = 48000;
-	}
-	inline float getFrequency()
+	};
+	inline float getFrequency() const noexcept
 	{
 		return m_frequency;
-	}
+	};
+	inline float getConfidence() const noexcept
+	{
+		return m_confidence;
+	};
+	inline Pitch getPitch() const noexcept
+	{
+		return { m_frequency, m_confidence };
+	};
+	inline int getLatency() const noexcept
+	{
+		return m_size;
+	};
 
 private:
-	inline void _getFrequency() noexcept
+	static constexpr float MINIMUM_GAIN = 0.000251f;			// -72 dB
+	static constexpr float MCLEOD_KEY_MAXIMUM = 0.9f;
+	static constexpr float YIN_THRESHOLD = 0.15f;
+
+	inline void analyse() noexcept
+	{
+		// Oldest sample first
+		const int tail = m_size - m_writeIndex;
+		std::copy(m_history.begin() + m_writeIndex, m_history.end(), m_frame.begin());
+		std::copy(m_history.begin(), m_history.begin() + m_writeIndex, m_frame.begin() + tail);
+
+		float energy = 0.0f;
+		for (const float sample : m_frame)
+		{
+			energy += sample * sample;
+		}
+
+		// Ignore, if amplitude is too low. Sine with amplitude A has energy A^2 / 2 * SIZE
+		if (energy < 0.5f * MINIMUM_GAIN * MINIMUM_GAIN * (float)m_size)
+		{
+			m_hasSpectrumLast = false;
+			m_confidence = 0.0f;
+			return;
+		}
+
+		Pitch pitch{ 0.0f, 0.0f };
+
+		if (m_type == Type::FFT)
+		{
+			pitch = getPitchFFT();
+		}
+		else
+		{
+			computeAutocorrelation(energy);
+			pitch = m_type == Type::YIN ? getPitchYIN() : getPitchMcLeod();
+		}
+
+		m_confidence = pitch.confidence;
+
+		if (pitch.confidence > 0.0f && pitch.confidence >= m_minimumConfidence)
+		{
+			m_frequency = pitch.frequency;
+		}
+	};
+
+	//==============================================================================
+	inline Pitch getPitchFFT() noexcept
 	{
-		// Apply windowing function
-		m_window.multiplyWithWindowingTable(m_fftData, FFT_SIZE);
+		float* data = m_fftData.data();
 
-		// Perform FFT
-		m_forwardFFT.performFrequencyOnlyForwardTransform(m_fftData);
+		for (int i = 0; i < m_size; i++)
+		{
+			data[i] = m_window[i] * m_frame[i];
+		}
+		std::fill(data + m_size, data + 2 * m_size, 0.0f);
 
-		// Get maximum index
-		int maxIndex = m_bucketIndexMin;
-		float maxValue = m_fftData[m_bucketIndexMin];
+		m_fft->performRealOnlyForwardTransform(data, true);
 
-		for (int i = m_bucketIndexMin; i < m_bucketIndexMax; i++)
+		const float binFrequency = (float)m_sampleRate / (float)m_size;
+		const int binMin = juce::jlimit(1, m_size / 2 - 1, (int)(m_frequencyMin / binFrequency));
+		const int binMax = juce::jlimit(binMin, m_size / 2 - 1, (int)(m_frequencyMax / binFrequency) + 1);
+
+		// Get maximum bin
+		int maxIndex = binMin;
+		float maxPower = 0.0f;
+		float powerSum = 0.0f;
+
+		for (int i = binMin; i <= binMax; i++)
 		{
-			const float value = m_fftData[i];
-			if (value > maxValue)
+			const float power = getPower(data, i);
+			powerSum += power;
+
+			if (power > maxPower)
 			{
-				maxValue = value;
+				maxPower = power;
 				maxIndex = i;
 			}
 		}
 
-		// Ignore, if amplitude is too low
-		if (maxValue < Math::dBToGain(-72.0f))
+		// Hann main lobe is 4 bins wide, sine with amplitude A has peak magnitude A * SIZE / 4
+		const float peakGain = 4.0f * std::sqrt(maxPower) / (float)m_size;
+		if (peakGain < MINIMUM_GAIN)
 		{
-			return;
+			m_hasSpectrumLast = false;
+			return { 0.0f, 0.0f };
+		}
+
+		// Parabolic interpolation of log magnitudes, Gaussian fit of the main lobe
+		const float powerLeft = getPower(data, maxIndex - 1);
+		const float powerRight = getPower(data, maxIndex + 1);
+		const float offset = Math::quadraticInterpolationOffset(0.5f * std::log(powerLeft + 1e-20f), 0.5f * std::log(maxPower + 1e-20f), 0.5f * std::log(powerRight + 1e-20f));
+		float bin = (float)maxIndex + offset;
+
+		// Phase vocoder, unambiguous for frequency up to SIZE / (2 * HOP) bins from bin centre
+		if (m_hasSpectrumLast && 2 * m_hopSize <= m_size)
+		{
+			const float phase = std::atan2(data[2 * maxIndex + 1], data[2 * maxIndex]);
+			const float phaseLast = std::atan2(m_spectrumLast[2 * maxIndex + 1], m_spectrumLast[2 * maxIndex]);
+			const float phaseExpected = juce::MathConstants<float>::twoPi * (float)maxIndex * (float)m_hopSize / (float)m_size;
+
+			float deviation = phase - phaseLast - phaseExpected;
+			deviation -= juce::MathConstants<float>::twoPi * std::floor((deviation + juce::MathConstants<float>::pi) / juce::MathConstants<float>::twoPi);
+
+			const float binPhase = (float)maxIndex + deviation * (float)m_size / (juce::MathConstants<float>::twoPi * (float)m_hopSize);
+
+			// Transients and frequency jumps break phase continuity
+			if (std::fabs(binPhase - bin) < 0.5f)
+			{
+				bin = binPhase;
+			}
 		}
 
-		// Convert maximum inde to frequency
-		const int bucketFrequency = m_sampleRate / FFT_SIZE;
+		std::copy(data, data + m_size + 2, m_spectrumLast.begin());
+		m_hasSpectrumLast = true;
 
-		m_frequency = static_cast<float>(maxIndex * bucketFrequency + bucketFrequency / 2);
+		const float lobePower = maxPower + powerLeft + powerRight;
+		const float confidence = powerSum > 0.0f ? Math::clamp(lobePower / powerSum, 0.0f, 1.0f) : 0.0f;
 
-		// TODO: Interpolate between maximum and largest neighbour
-	}
+		return { bin * binFrequency, confidence };
+	};
+
+	inline static float getPower(const float* spectrum, const int index) noexcept
+	{
+		const float real = spectrum[2 * index];
+		const float imag = spectrum[2 * index + 1];
+		return real * real + imag * imag;
+	};
+
+	//==============================================================================
+	// r(tau) = sum x[j] * x[j + tau], stored in m_fftData[0, SIZE)
+	// m(tau) = sum x[j]^2 + x[j + tau]^2, stored in m_lag[tau]
+	inline void computeAutocorrelation(const float energy) noexcept
+	{
+		float* data = m_fftData.data();
+
+		std::copy(m_frame.begin(), m_frame.end(), data);
+		std::fill(data + m_size, data + 4 * m_size, 0.0f);
+
+		m_autocorrelationFFT->performRealOnlyForwardTransform(data, true);
+
+		for (int i = 0; i <= m_size; i++)
+		{
+			data[2 * i] = getPower(data, i);
+			data[2 * i + 1] = 0.0f;
+		}
+
+		m_autocorrelationFFT->performRealOnlyInverseTransform(data);
+
+		const int lagMax = getLagMax();
+		float m = 2.0f * energy;
+		m_lag[0] = m;
+
+		for (int tau = 1; tau <= lagMax + 1; tau++)
+		{
+			const float a = m_frame[m_size - tau];
+			const float b = m_frame[tau - 1];
+			m -= a * a + b * b;
+			m_lag[tau] = m;
+		}
+	};
+
+	inline int getLagMin() const noexcept
+	{
+		return juce::jmax(2, (int)((float)m_sampleRate / m_frequencyMax));
+	};
+	inline int getLagMax() const noexcept
+	{
+		return juce::jlimit(getLagMin() + 1, m_size / 2, (int)((float)m_sampleRate / m_frequencyMin) + 1);
+	};
+
+	//==============================================================================
+	inline Pitch getPitchYIN() noexcept
+	{
+		const float* r = m_fftData.data();
+		float* d = m_lag.data();
+
+		const int lagMin = getLagMin();
+		const int lagMax = getLagMax();
+
+		// Cumulative mean normalized difference d'(tau), in place of m(tau)
+		float sum = 0.0f;
+		d[0] = 1.0f;
+
+		for (int tau = 1; tau <= lagMax + 1; tau++)
+		{
+			const float difference = juce::jmax(0.0f, d[tau] - 2.0f * r[tau]);
+			sum += difference;
+			d[tau] = sum > 0.0f ? difference * (float)tau / sum : 1.0f;
+		}
+
+		// First dip below threshold, global minimum otherwise
+		int lag = -1;
+		for (int tau = lagMin; tau <= lagMax; tau++)
+		{
+			if (d[tau] < YIN_THRESHOLD)
+			{
+				while (tau < lagMax && d[tau + 1] < d[tau])
+				{
+					tau++;
+				}
+
+				lag = tau;
+				break;
+			}
+		}
+
+		if (lag < 0)
+		{
+			lag = lagMin;
+			for (int tau = lagMin + 1; tau <= lagMax; tau++)
+			{
+				if (d[tau] < d[lag])
+				{
+					lag = tau;
+				}
+			}
+		}
+
+		const float offset = Math::quadraticInterpolationOffset(d[lag - 1], d[lag], d[lag + 1]);
+		const float confidence = Math::clamp(1.0f - d[lag], 0.0f, 1.0f);
+
+		return { (float)m_sampleRate / ((float)lag + offset), confidence };
+	};
+
+	//==============================================================================
+	inline Pitch getPitchMcLeod() noexcept
+	{
+		const float* r = m_fftData.data();
+		float* n = m_lag.data();
+
+		const int lagMin = getLagMin();
+		const int lagMax = getLagMax();
+
+		// Normalized square difference n(tau), in place of m(tau)
+		for (int tau = 0; tau <= lagMax + 1; tau++)
+		{
+			n[tau] = n[tau] > 0.0f ? 2.0f * r[tau] / n[tau] : 0.0f;
+		}
+
+		// Highest maximum of every positive lobe after the first negative one
+		float nMax = 0.0f;
+		int tau = 1;
+		while (tau <= lagMax && n[tau] > 0.0f)
+		{
+			tau++;
+		}
+
+		const int lobesStart = tau;
+		for (; tau <= lagMax; tau++)
+		{
+			if (tau >= lagMin && n[tau] > n[tau - 1] && n[tau] >= n[tau + 1])
+			{
+				nMax = juce::jmax(nMax, n[tau]);
+			}
+		}
+
+		if (nMax <= 0.0f)
+		{
+			return { 0.0f, 0.0f };
+		}
+
+		// First key maximum close to the highest one
+		const float keyThreshold = MCLEOD_KEY_MAXIMUM * nMax;
+		int lag = -1;
+
+		for (tau = juce::jmax(lobesStart, lagMin); tau <= lagMax; tau++)
+		{
+			if (n[tau] >= keyThreshold && n[tau] > n[tau - 1] && n[tau] >= n[tau + 1])
+			{
+				lag = tau;
+				break;
+			}
+		}
+
+		if (lag < 0)
+		{
+			return { 0.0f, 0.0f };
+		}
+
+		const float offset = Math::quadraticInterpolationOffset(n[lag - 1], n[lag], n[lag + 1]);
+		const float confidence = Math::clamp(Math::quadraticInterpolationValue(n[lag - 1], n[lag], n[lag + 1]), 0.0f, 1.0f);
+
+		return { (float)m_sampleRate / ((float)lag + offset), confidence };
+	};
 
-	juce::dsp::FFT m_forwardFFT;
-	juce::dsp::WindowingFunction<float> m_window;
+	std::unique_ptr<juce::dsp::FFT> m_fft;
+	std::unique_ptr<juce::dsp::FFT> m_autocorrelationFFT;
 
-	float m_fifo[FFT_SIZE];
-	float m_fftData[2 * FFT_SIZE];
+	std::vector<float> m_window;
+	std::vector<float> m_history;
+	std::vector<float> m_frame;
+	std::vector<float> m_fftData;
+	std::vector<float> m_spectrumLast;
+	std::vector<float> m_lag;
 
-	float m_frequency;
+	Type m_type = Type::FFT;
+	float m_frequency = 440.0f;
+	float m_confidence = 0.0f;
+	float m_frequencyMin = 20.0f;
+	float m_frequencyMax = 2000.0f;
+	float m_minimumConfidence = 0.0f;
 
-	int m_fifoIndex = 0;
-	int m_bucketIndexMin = 0;
-	int m_bucketIndexMax = FFT_SIZE / 2;
+	int m_size = 1 << FFT_ORDER;
+	int m_hopSize = HOP_SIZE;
+	int m_writeIndex = 0;
+	int m_hopIndex = 0;
 	int m_sampleRate = 48000;
-};
\ No newline at end of file
+	bool m_hasSpectrumLast = false;
+};
@@ -15,7 +15,7 @@
  * along with this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
-#pragma
+#pragma once
 
 #include <vector>
 
@@ -134,14 +134,14 @@ inline void _getFrequency(int minDistanceSemitones = 1) noexcept
 			break;
 
 		const int index = peak.index;
-		const float freq = (index + 0.5f) * bucketHz;
+		const float freq = index * bucketHz;
 
 		bool tooClose = false;
 		if (minDistanceSemitones > 0)
 		{
 			for (int selIndex : selectedBins)
 			{
-				float selFreq = (selIndex + 0.5f) * bucketHz;
+				float selFreq = selIndex * bucketHz;
 				float semitoneDiff = 12.0f * std::log2(freq / selFreq);
 				if (std::abs(semitoneDiff) < minDistanceSemitones)
 				{
@@ -310,7 +310,7 @@ private:
 		for (const auto& peak : peaks)
 		{			
 			const int index = peak.index;
-			const float freq = (index + 0.5f) * bucketHz;
+			const float freq = index * bucketHz;
 			
 			// Limit low frequency bins
 			if (freq < 20.0f)
@@ -330,7 +330,7 @@ private:
 			{
 				for (int selIndex : selectedBins)
 				{
-					float selFreq = (selIndex + 0.5f) * bucketHz;
+					float selFreq = selIndex * bucketHz;
 					float semitoneDiff = 12.0f * std::log2(freq / selFreq);
 					if (std::abs(semitoneDiff) < minDistanceSemitones)
 					{
@@ -346,11 +346,27 @@ private:
 			float avgMag = m_accumMagnitude[index] / m_accumCount[index];
 			float gain = (2.0f * avgMag) / FFT_SIZE;
 
-			m_spectrum.push_back({ freq, gain });
+			m_spectrum.push_back({ getRefinedFrequency(index, bucketHz), gain });
 			selectedBins.push_back(index);
 		}
 	}
 
+	// Parabolic interpolation of averaged log magnitudes around peak bin, bin k is centred at k * bucketHz
+	inline float getRefinedFrequency(const int index, const float bucketHz) const noexcept
+	{
+		if (index < 1 || index >= FFT_SIZE / 2 - 1 || m_accumCount[index] == 0)
+		{
+			return index * bucketHz;
+		}
+
+		const float count = (float)m_accumCount[index];
+		const float left = std::log(m_accumMagnitude[index - 1] / count + 1e-20f);
+		const float centre = std::log(m_accumMagnitude[index] / count + 1e-20f);
+		const float right = std::log(m_accumMagnitude[index + 1] / count + 1e-20f);
+
+		return ((float)index + Math::quadraticInterpolationOffset(left, centre, right)) * bucketHz;
+	}
+
 	juce::dsp::FFT m_forwardFFT;
 	juce::dsp::WindowingFunction<float> m_window;
 
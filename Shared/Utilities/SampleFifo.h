@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2025 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <cstring>
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+ * Single producer, single consumer lock-free sample queue.
+ *
+ * Audio thread pushes blocks of samples, GUI thread pops them. Both sides only copy
+ * memory, juce::AbstractFifo keeps read and write positions in atomics.
+ * Samples that do not fit are dropped, push never blocks and never allocates.
+ */
+class SampleFifo
+{
+public:
+	SampleFifo() = default;
+	~SampleFifo() = default;
+
+	// Not realtime safe, call before audio processing starts
+	inline void init(const int capacity)
+	{
+		m_fifo.setTotalSize(capacity + 1);
+		m_buffer.assign(capacity + 1, 0.0f);
+		m_fifo.reset();
+	}
+	// Producer
+	inline int push(const float* samples, const int count) noexcept
+	{
+		int start1, size1, start2, size2;
+		m_fifo.prepareToWrite(count, start1, size1, start2, size2);
+
+		if (size1 > 0)
+		{
+			std::memcpy(m_buffer.data() + start1, samples, size1 * sizeof(float));
+		}
+		if (size2 > 0)
+		{
+			std::memcpy(m_buffer.data() + start2, samples + size1, size2 * sizeof(float));
+		}
+
+		m_fifo.finishedWrite(size1 + size2);
+		return size1 + size2;
+	}
+	// Consumer
+	inline int pop(float* samples, const int count) noexcept
+	{
+		int start1, size1, start2, size2;
+		m_fifo.prepareToRead(count, start1, size1, start2, size2);
+
+		if (size1 > 0)
+		{
+			std::memcpy(samples, m_buffer.data() + start1, size1 * sizeof(float));
+		}
+		if (size2 > 0)
+		{
+			std::memcpy(samples + size1, m_buffer.data() + start2, size2 * sizeof(float));
+		}
+
+		m_fifo.finishedRead(size1 + size2);
+		return size1 + size2;
+	}
+	// Consumer
+	inline int getNumReady() const noexcept
+	{
+		return m_fifo.getNumReady();
+	}
+	// Consumer, drops oldest count samples
+	inline void skip(const int count) noexcept
+	{
+		m_fifo.finishedRead(std::min(count, m_fifo.getNumReady()));
+	}
+	// Consumer, drops everything pushed so far
+	inline void clear() noexcept
+	{
+		m_fifo.finishedRead(m_fifo.getNumReady());
+	}
+	inline void release()
+	{
+		m_fifo.setTotalSize(1);
+		m_buffer.clear();
+	}
+
+private:
+	juce::AbstractFifo m_fifo{ 1 };
+	std::vector<float> m_buffer;
+};
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+
+//==============================================================================
+/**
+ * Single writer, single reader lock-free handoff of the latest value.
+ *
+ * Writer fills getWriteBuffer() and publishes it, reader picks up the newest
+ * published value with update(). Values published in between are skipped.
+ * Each side owns one of three slots, the third one is swapped with a single
+ * atomic exchange, so neither side ever waits or allocates.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() = default;
+	~TripleBuffer() = default;
+
+	// Writer
+	inline T& getWriteBuffer() noexcept
+	{
+		return m_buffers[m_write];
+	}
+	// Writer, makes getWriteBuffer() content visible to the reader
+	inline void publish() noexcept
+	{
+		m_write = m_shared.exchange(m_write | NEW_DATA, std::memory_order_acq_rel) & INDEX_MASK;
+	}
+	// Reader, returns true if a new value was published since the last update()
+	inline bool update() noexcept
+	{
+		if ((m_shared.load(std::memory_order_relaxed) & NEW_DATA) == 0)
+		{
+			return false;
+		}
+
+		m_read = m_shared.exchange(m_read, std::memory_order_acq_rel) & INDEX_MASK;
+		return true;
+	}
+	// Reader
+	inline const T& getReadBuffer() const noexcept
+	{
+		return m_buffers[m_read];
+	}
+
+private:
+	static constexpr int INDEX_MASK = 3;
+	static constexpr int NEW_DATA = 4;
+
+	T m_buffers[3] = {};
+	std::atomic<int> m_shared{ 1 };
+	int m_write = 0;
+	int m_read = 2;
+};
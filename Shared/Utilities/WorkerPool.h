@@ -0,0 +1,408 @@
+/*
+ * Copyright (C) 2026 Filip Cenzak (filip.c@centrum.cz)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+	#include <immintrin.h>
+#endif
+
+#if JUCE_WINDOWS
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+	#include <dispatch/dispatch.h>
+#else
+	#include <cerrno>
+	#include <semaphore.h>
+#endif
+
+//==============================================================================
+/**
+ * Spreads independent tasks of one audio block (channels, bands, sample ranges)
+ * over pre-spawned helper threads.
+ *
+ * run() publishes the task with a single atomic store and takes part in the work,
+ * helpers claim task indexes with compare-exchange. run() returns when all tasks
+ * are done, so a helper that claimed a task holds up the audio thread until it
+ * finishes it. Helpers are therefore started as realtime threads and join the host
+ * audio workgroup, if the host provides one. A helper that can not get realtime
+ * priority is not started.
+ *
+ * Idle helpers spin for a short while after each block and then sleep on their own
+ * semaphore. run() wakes a sleeping helper with a single semaphore post, the audio
+ * thread never takes a lock. Nothing on the run() path allocates.
+ *
+ * Pools without helpers, single tasks and blocks shorter than the minimum block size
+ * run serially. Meant for wide buses only, see MINIMUM_BUS_WIDTH.
+ */
+class WorkerPool
+{
+public:
+	WorkerPool() = default;
+	~WorkerPool() { release(); }
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	using Task = void (*)(void* context, const int index);
+
+	static constexpr int MAX_THREADS = 15;
+	static constexpr int MINIMUM_BLOCK_SIZE = 64;
+
+	// Narrower buses do not have enough independent work to pay for the handoff
+	static constexpr int MINIMUM_BUS_WIDTH = 6;
+
+	// Helper threads for count tasks, the calling thread runs tasks too
+	static inline int getDefaultThreadsCount(const int count) noexcept
+	{
+		const int cores = static_cast<int>(std::thread::hardware_concurrency());
+		const int threads = std::min(count, cores) - 1;
+		return std::max(0, std::min(threads, MAX_THREADS));
+	}
+
+	// Not realtime safe, starts threads. Call from prepareToPlay(), threads 0 runs everything serially.
+	inline void init(const int threads, const double sampleRate, const int samplesPerBlock, const int minimumBlockSize = MINIMUM_BLOCK_SIZE)
+	{
+		release();
+
+		m_minimumBlockSize = minimumBlockSize;
+		m_exit.store(false);
+		m_speedup.store(1.0f);
+
+		{
+			const juce::SpinLock::ScopedLockType lock(m_workgroupLock);
+			m_workgroup = m_pendingWorkgroup;
+		}
+
+		int threadsCount = std::max(0, std::min(threads, MAX_THREADS));
+
+		// Workgroup limits threads doing audio work, audio thread is one of them
+		const int workgroupThreads = m_workgroup ? static_cast<int>(m_workgroup.getMaxParallelThreadCount()) : 0;
+		if (workgroupThreads > 0)
+		{
+			threadsCount = std::min(threadsCount, workgroupThreads - 1);
+		}
+
+		const auto options = juce::Thread::RealtimeOptions{}.withApproximateAudioProcessingTime(samplesPerBlock, sampleRate);
+
+		for (int thread = 0; thread < threadsCount; thread++)
+		{
+			auto helper = std::make_unique<Helper>(*this);
+			if (!helper->startRealtimeThread(options))
+			{
+				break;
+			}
+
+			m_helpers.push_back(std::move(helper));
+		}
+
+		m_threadsCount.store(static_cast<int>(m_helpers.size()));
+	}
+	// Not realtime safe, stops threads
+	inline void release()
+	{
+		if (m_helpers.empty())
+		{
+			return;
+		}
+
+		m_threadsCount.store(0);
+		m_exit.store(true, std::memory_order_seq_cst);
+		wakeHelpers();
+
+		for (auto& helper : m_helpers)
+		{
+			helper->stopThread(-1);
+		}
+
+		m_helpers.clear();
+	}
+	// Only stores the workgroup, helpers started by the next init() join it.
+	// Call from AudioProcessor::audioWorkgroupContextChanged().
+	inline void setAudioWorkgroup(const juce::AudioWorkgroup& workgroup)
+	{
+		const juce::SpinLock::ScopedLockType lock(m_workgroupLock);
+		m_pendingWorkgroup = workgroup;
+	}
+
+	// Runs task(context, index) for index 0 to count - 1 and returns when all of them are done.
+	// Tasks must not depend on each other. samples is the block size used for serial fallback.
+	inline void run(const int count, const int samples, Task task, void* context) noexcept
+	{
+		if (m_helpers.empty() || count < 2 || samples < m_minimumBlockSize)
+		{
+			for (int index = 0; index < count; index++)
+			{
+				task(context, index);
+			}
+
+			return;
+		}
+
+		const auto start = now();
+
+		m_task.store(task, std::memory_order_relaxed);
+		m_context.store(context, std::memory_order_relaxed);
+		m_count.store(count, std::memory_order_relaxed);
+		m_pending.store(count, std::memory_order_relaxed);
+		m_busyTime.store(0, std::memory_order_relaxed);
+
+		// Publish, index 0 of the new generation
+		m_generation++;
+		m_claim.store(static_cast<uint64_t>(m_generation) << 32, std::memory_order_seq_cst);
+
+		wakeHelpers();
+
+		runTasks(m_generation);
+
+		// Barrier, helpers only finish what they already claimed
+		for (int spin = 0; m_pending.load(std::memory_order_acquire) > 0; spin++)
+		{
+			if (spin < BARRIER_SPINS)
+			{
+				pause();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		// Close the generation, late helpers can not claim anything from it
+		m_claim.store((static_cast<uint64_t>(m_generation) << 32) | CLOSED, std::memory_order_release);
+
+		const auto wallTime = static_cast<float>(now() - start);
+		const auto busyTime = static_cast<float>(m_busyTime.load(std::memory_order_relaxed));
+		if (wallTime > 0.0f)
+		{
+			const float speedup = m_speedup.load(std::memory_order_relaxed);
+			m_speedup.store(speedup + SPEEDUP_SMOOTHING * (busyTime / wallTime - speedup), std::memory_order_relaxed);
+		}
+	}
+	// Lambda or functor called as function(index)
+	template <typename Function>
+	inline void run(const int count, const int samples, Function& function) noexcept
+	{
+		run(count, samples, [](void* context, const int index) { (*static_cast<Function*>(context))(index); }, &function);
+	}
+
+	// Task time summed over all threads divided by run() time, smoothed. Serial runs do not update it.
+	inline float getSpeedup() const noexcept
+	{
+		return m_speedup.load(std::memory_order_relaxed);
+	}
+	// Safe to call from any thread
+	inline int getThreadsCount() const noexcept
+	{
+		return m_threadsCount.load(std::memory_order_relaxed);
+	}
+
+private:
+	// Counting semaphore, post() does not take a lock
+	class Semaphore
+	{
+	public:
+#if JUCE_WINDOWS
+		Semaphore() : m_handle(CreateSemaphoreW(nullptr, 0, LONG_MAX, nullptr)) {}
+		~Semaphore() { CloseHandle(m_handle); }
+
+		inline void post() noexcept { ReleaseSemaphore(m_handle, 1, nullptr); }
+		inline void wait() noexcept { WaitForSingleObject(m_handle, INFINITE); }
+
+	private:
+		HANDLE m_handle;
+#elif JUCE_MAC || JUCE_IOS
+		Semaphore() : m_semaphore(dispatch_semaphore_create(0)) {}
+		~Semaphore() { dispatch_release(m_semaphore); }
+
+		inline void post() noexcept { dispatch_semaphore_signal(m_semaphore); }
+		inline void wait() noexcept { dispatch_semaphore_wait(m_semaphore, DISPATCH_TIME_FOREVER); }
+
+	private:
+		dispatch_semaphore_t m_semaphore;
+#else
+		Semaphore() { sem_init(&m_semaphore, 0, 0); }
+		~Semaphore() { sem_destroy(&m_semaphore); }
+
+		inline void post() noexcept { sem_post(&m_semaphore); }
+		inline void wait() noexcept
+		{
+			while (sem_wait(&m_semaphore) != 0 && errno == EINTR)
+			{
+			}
+		}
+
+	private:
+		sem_t m_semaphore;
+#endif
+
+		Semaphore(const Semaphore&) = delete;
+		Semaphore& operator=(const Semaphore&) = delete;
+	};
+
+	class Helper : public juce::Thread
+	{
+	public:
+		Helper(WorkerPool& pool) : juce::Thread("WorkerPool helper"), m_pool(pool) {}
+
+		void run() override
+		{
+			// m_workgroup only changes in init(), while helpers are stopped
+			juce::WorkgroupToken token;
+			m_pool.m_workgroup.join(token);
+
+			m_pool.workerLoop(*this);
+		}
+
+		// Set by the helper before it waits, cleared by whoever posts
+		std::atomic<bool> m_sleeping{ false };
+		Semaphore m_wake;
+
+	private:
+		WorkerPool& m_pool;
+	};
+
+	static constexpr uint64_t INDEX_MASK = 0xFFFFFFFFu;
+	static constexpr uint64_t CLOSED = INDEX_MASK;
+	static constexpr int BARRIER_SPINS = 4096;
+	static constexpr int64_t SPIN_TIME_NS = 20000;
+	static constexpr float SPEEDUP_SMOOTHING = 0.05f;
+
+	static inline int64_t now() noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	static inline void pause() noexcept
+	{
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+		_mm_pause();
+#else
+		std::this_thread::yield();
+#endif
+	}
+
+	// Claims and runs tasks of one generation until none is left
+	inline void runTasks(const uint32_t generation) noexcept
+	{
+		uint64_t claim = m_claim.load(std::memory_order_acquire);
+
+		while (static_cast<uint32_t>(claim >> 32) == generation)
+		{
+			const uint64_t index = claim & INDEX_MASK;
+			if (index >= static_cast<uint64_t>(m_count.load(std::memory_order_relaxed)))
+			{
+				return;
+			}
+
+			if (m_claim.compare_exchange_weak(claim, claim + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				// Generation can not change before this task is done, task and context are still valid
+				const auto start = now();
+				m_task.load(std::memory_order_relaxed)(m_context.load(std::memory_order_relaxed), static_cast<int>(index));
+				m_busyTime.fetch_add(now() - start, std::memory_order_relaxed);
+
+				m_pending.fetch_sub(1, std::memory_order_release);
+				claim = m_claim.load(std::memory_order_acquire);
+			}
+		}
+	}
+
+	// Posts to every helper that is going to sleep, each sleep gets exactly one post
+	inline void wakeHelpers() noexcept
+	{
+		for (auto& helper : m_helpers)
+		{
+			if (helper->m_sleeping.load(std::memory_order_seq_cst) && helper->m_sleeping.exchange(false, std::memory_order_acq_rel))
+			{
+				helper->m_wake.post();
+			}
+		}
+	}
+
+	inline void workerLoop(Helper& helper) noexcept
+	{
+		uint32_t generation = static_cast<uint32_t>(m_claim.load(std::memory_order_acquire) >> 32);
+
+		while (!m_exit.load(std::memory_order_acquire))
+		{
+			// Spin, then sleep until the next generation is published
+			const auto spinEnd = now() + SPIN_TIME_NS;
+			uint32_t published = generation;
+
+			for (int spin = 0; !m_exit.load(std::memory_order_relaxed); spin++)
+			{
+				published = static_cast<uint32_t>(m_claim.load(std::memory_order_acquire) >> 32);
+				if (published != generation)
+				{
+					break;
+				}
+
+				if ((spin & 63) != 0 || now() < spinEnd)
+				{
+					pause();
+					continue;
+				}
+
+				// Publishing stores m_claim then reads m_sleeping, the helper stores m_sleeping then reads m_claim,
+				// so one of them sees the other. Waits unless nothing was published and cancelling wins over a post.
+				helper.m_sleeping.store(true, std::memory_order_seq_cst);
+
+				const bool woken = m_exit.load(std::memory_order_seq_cst) || static_cast<uint32_t>(m_claim.load(std::memory_order_seq_cst) >> 32) != generation;
+				if (!woken || !helper.m_sleeping.exchange(false, std::memory_order_acq_rel))
+				{
+					helper.m_wake.wait();
+				}
+			}
+
+			generation = published;
+			runTasks(generation);
+		}
+	}
+
+	std::vector<std::unique_ptr<Helper>> m_helpers;
+	juce::AudioWorkgroup m_workgroup;
+	juce::AudioWorkgroup m_pendingWorkgroup;
+	juce::SpinLock m_workgroupLock;
+
+	// Generation in upper 32 bits, next task index in lower 32 bits
+	std::atomic<uint64_t> m_claim{ 0 };
+	std::atomic<Task> m_task{ nullptr };
+	std::atomic<void*> m_context{ nullptr };
+	std::atomic<int> m_count{ 0 };
+	std::atomic<int> m_pending{ 0 };
+	std::atomic<int64_t> m_busyTime{ 0 };
+	std::atomic<float> m_speedup{ 1.0f };
+	std::atomic<bool> m_exit{ false };
+	std::atomic<int> m_threadsCount{ 0 };
+
+	uint32_t m_generation = 0;
+	int m_minimumBlockSize = MINIMUM_BLOCK_SIZE;
+};
@@ -24,6 +24,8 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <atomic>
 
 class ZeroCrossingOffline
 {
@@ -43,6 +45,11 @@ public:
 		AmplitudeAdaptiveFilter,
 	};
 
+	// Called from process() every PROGRESS_INTERVAL samples with progress [0, 1] and crossings found so far.
+	// Return false to cancel, process() then returns with the crossings found until then.
+	using ProgressCallback = std::function<bool(const float progress, const std::vector<int>& crossings)>;
+	static const int PROGRESS_INTERVAL = 1 << 16;
+
 	void init(const int sampleRate)
 	{
 		m_sampleRate = sampleRate;
@@ -68,6 +75,19 @@ public:
 	{
 		m_minimumLengthMultiplier = multiplier;
 	}
+	// FFT detection threads, 1 is serial, 0 uses all cores. Detected crossings do not depend on it.
+	void setThreadsCount(const int threadsCount)
+	{
+		m_threadsCount = threadsCount;
+	}
+	void setProgressCallback(ProgressCallback progressCallback)
+	{
+		m_progressCallback = std::move(progressCallback);
+	}
+	bool wasCancelled() const
+	{
+		return m_cancelled;
+	}
 	const std::vector<float>& getLastFilteredBuffer() const
 	{
 		return m_lastFilteredBuffer;
@@ -79,6 +99,7 @@ public:
 	void process(const juce::AudioBuffer<float>& audioBuffer, std::vector<int>& regions)
 	{
 		regions.clear();
+		m_cancelled = false;
 
 		const auto samples = audioBuffer.getNumSamples();
 		if (samples == 0)
@@ -105,9 +126,47 @@ public:
 		{
 			processAmplitudeAdaptiveDetection(sumBuffer, regions);
 		}
+
+		if (!m_cancelled)
+		{
+			reportProgress(1.0f, regions);
+		}
 	}
 
 private:
+	bool reportProgress(const float progress, const std::vector<int>& regions)
+	{
+		if (m_progressCallback && !m_progressCallback(progress, regions))
+		{
+			m_cancelled = true;
+		}
+
+		return !m_cancelled;
+	}
+
+	// True every PROGRESS_INTERVAL samples if progress was reported and detection was cancelled
+	bool isCancelledAt(const int sample, const int samples, const float progressStart, const float progressRange, const std::vector<int>& regions)
+	{
+		if ((sample & (PROGRESS_INTERVAL - 1)) != 0)
+		{
+			return false;
+		}
+
+		return !reportProgress(progressStart + progressRange * (float)sample / (float)samples, regions);
+	}
+
+	// Same for parallel ranges. Range 0 runs on the calling thread and reports progress of its part,
+	// other ranges only check for cancellation.
+	bool isCancelledInRange(const int range, const int sample, const int samples, const float progressStart, const float progressRange, const std::vector<int>& regions)
+	{
+		if (range == 0)
+		{
+			return isCancelledAt(sample, samples, progressStart, progressRange, regions);
+		}
+
+		return (sample & (PROGRESS_INTERVAL - 1)) == 0 && m_cancelled;
+	}
+
 	void processAmplitudeDetection(const juce::AudioBuffer<float>& buffer, std::vector<int>& regions)
 	{
 		const auto samples = buffer.getNumSamples();
@@ -125,6 +184,11 @@ private:
 
 		for (int sample = 1; sample < samples; sample++)
 		{
+			if (isCancelledAt(sample, samples, 0.0f, 1.0f, regions))
+			{
+				return;
+			}
+
 			float in = pBuffer[sample];
 
 			if (in > m_threshold)
@@ -140,7 +204,7 @@ private:
 			if (inLast < 0.0f && in >= 0.0f && sinceLast > SINCE_LAST_MIN && wasPositive && wasNegative)
 			{
 				// Choose sample closer to 0
-				if (std::fabsf(inLast) > std::fabsf(in))
+				if (std::fabs(inLast) > std::fabs(in))
 				{
 					regions.push_back(sample);
 				}
@@ -171,7 +235,7 @@ private:
 		std::vector<float> dominantFrequencies;
 		
 		//zazzDSP::Spectrum::calculateDominantFrequencies(buffer, m_sampleRate, dominantFrequencies, frameCenterSamples, &phaseTrajectory, true, timeBinsPerSecond, FFT_ORDER);
-		zazzDSP::Spectrum::calculateDominantFrequenciesWithIQInterpolation(buffer, m_sampleRate, dominantFrequencies, frameCenterSamples, &phaseTrajectory, timeBinsPerSecond, FFT_ORDER);
+		zazzDSP::Spectrum::calculateDominantFrequenciesWithIQInterpolation(buffer, m_sampleRate, dominantFrequencies, frameCenterSamples, &phaseTrajectory, timeBinsPerSecond, FFT_ORDER, 3, m_threadsCount);
 
 		if (phaseTrajectory.empty() || phaseTrajectory.size() == 0)
 		{
@@ -179,6 +243,11 @@ private:
 			return;
 		}
 
+		if (!reportProgress(0.5f, regions))
+		{
+			return;
+		}
+
 		// Calculate block size for phase interpolation
 		const int m_timeBinsCount = zazzDSP::Spectrum::calculateNumTimeBins(samples, m_sampleRate, timeBinsPerSecond);
 		const float blockSize = (float)samples / (float)m_timeBinsCount;
@@ -251,67 +320,91 @@ private:
 			return currentPhase;
 			};
 
-		// Step 1: Create phase audio buffer with interpolated phase values for every sample
+		// Steps 1 - 3 run on consecutive sample ranges, possibly on multiple threads.
+		// Step 3 only collects crossing candidates, minimum distance between crossings is applied serially
+		// in step 4, so detected crossings do not depend on threads count.
 		m_phaseAudioBuffer.setSize(1, samples, false, true);
 		auto* phasePtr = m_phaseAudioBuffer.getWritePointer(0);
 
-		for (int sample = 0; sample < samples; ++sample)
+		// Step 1: Create phase audio buffer with interpolated phase values for every sample
+		// Step 2: Normalize phase buffer for visualization (remap to [-1, 1])
+		zazzDSP::Parallel::forRanges(samples, m_threadsCount, PROGRESS_INTERVAL, [&](const int range, const int first, const int last)
 		{
-			float sampleBlockPosition = (float)sample / blockSize;
-			int frameIdx = (int)sampleBlockPosition;
-			frameIdx = std::max(0, std::min(frameIdx, (int)phaseTrajectory.size() - 1));
+			for (int sample = first; sample < last; ++sample)
+			{
+				if (isCancelledInRange(range, sample - first, last - first, 0.5f, 0.25f, regions))
+				{
+					return;
+				}
 
-			phasePtr[sample] = interpolatePhaseLinear(frameIdx, (float)sample);
-		}
+				float sampleBlockPosition = (float)sample / blockSize;
+				int frameIdx = (int)sampleBlockPosition;
+				frameIdx = std::max(0, std::min(frameIdx, (int)phaseTrajectory.size() - 1));
+
+				const float phase = interpolatePhaseLinear(frameIdx, (float)sample);
+				phasePtr[sample] = phase / PI;  // [-π, π] → [-1, 1]
+			}
+		});
 
-		// Step 2: Normalize phase buffer for visualization (remap to [-1, 1]) in-place
-		for (int i = 0; i < samples; ++i)
+		if (m_cancelled)
 		{
-			phasePtr[i] = phasePtr[i] / PI;  // [-π, π] → [-1, 1]
+			return;
 		}
 
-		// Step 3: Detect zero crossings using normalized phase buffer [-1, 1]
-		int sinceLast = 0;
+		// Step 3: Find zero crossing candidates using normalized phase buffer [-1, 1]
 		const int SINCE_LAST_MIN = (int)m_minimumSamplesBetweenCrossings;
 
 		// Normalize threshold to [-1, 1] range for phase buffer comparison
 		const float normalizedThreshold = m_fftPhaseThresholdRadians / PI;
 
-		float lastPhase = phasePtr[0];
+		// Threshold at ±1 (normalized ±π) means phase wrapping detection
+		const bool detectPhaseWrapping = fabsf(1.0f - fabsf(normalizedThreshold)) < 0.1f;
 
-		for (int sample = 1; sample < samples; ++sample)
+		std::vector<std::vector<int>> candidates(zazzDSP::Parallel::getRangesCount(samples, m_threadsCount, PROGRESS_INTERVAL));
+
+		zazzDSP::Parallel::forRanges(samples, m_threadsCount, PROGRESS_INTERVAL, [&](const int range, const int first, const int last)
 		{
-			float currentPhase = phasePtr[sample];
+			auto& rangeCandidates = candidates[range];
 
-			// Detect upward zero crossing: phase crosses threshold from below to above
-			if (fabsf(1.0f - fabsf(normalizedThreshold)) < 0.1f)
+			for (int sample = std::max(1, first); sample < last; ++sample)
 			{
-				// Threshold at ±1 (normalized ±π, phase wrapping detection)
-				if (lastPhase > currentPhase && sinceLast > SINCE_LAST_MIN)
+				if (isCancelledInRange(range, sample - first, last - first, 0.75f, 0.25f, regions))
 				{
-					regions.push_back(sample);
-					sinceLast = 0;
+					return;
 				}
-				else
+
+				const float lastPhase = phasePtr[sample - 1];
+				const float currentPhase = phasePtr[sample];
+
+				// Detect upward zero crossing: phase crosses threshold from below to above
+				const bool isCrossing = detectPhaseWrapping ? lastPhase > currentPhase : lastPhase < normalizedThreshold && currentPhase >= normalizedThreshold;
+
+				if (isCrossing)
 				{
-					sinceLast++;
+					rangeCandidates.push_back(sample);
 				}
 			}
-			else
+		});
+
+		if (m_cancelled)
+		{
+			return;
+		}
+
+		// Step 4: Keep candidates further than SINCE_LAST_MIN from previous crossing.
+		// Samples since last crossing start at 0 for sample 1, same as sample 0 was a crossing.
+		int lastCrossing = 0;
+
+		for (const auto& rangeCandidates : candidates)
+		{
+			for (const int sample : rangeCandidates)
 			{
-				// Standard threshold crossing
-				if (lastPhase < normalizedThreshold && currentPhase >= normalizedThreshold && sinceLast > SINCE_LAST_MIN)
+				if (sample - lastCrossing - 1 > SINCE_LAST_MIN)
 				{
 					regions.push_back(sample);
-					sinceLast = 0;
-				}
-				else
-				{
-					sinceLast++;
+					lastCrossing = sample;
 				}
 			}
-
-			lastPhase = currentPhase;
 		}
 
 		// Ensure we have at least one marker - use first detected crossing or sample 0 as fallback
@@ -334,14 +427,22 @@ private:
 		// Step 1: Calculate initial dominant frequencies from original buffer (for filtering)
 		std::vector<float> dominantFrequencies;
 		std::vector<int> frameCenterSamples;
-		zazzDSP::Spectrum::calculateDominantFrequencies(buffer, m_sampleRate, dominantFrequencies, frameCenterSamples, false, BINS_PER_SECOND);
+		zazzDSP::Spectrum::calculateDominantFrequencies(buffer, m_sampleRate, dominantFrequencies, frameCenterSamples, nullptr, false, BINS_PER_SECOND);
+
+		if (!reportProgress(0.25f, regions))
+		{
+			return;
+		}
 
 		// Step 2: Initialize filtered buffer with original data
 		m_lastFilteredBuffer.resize(samples);
 		std::copy(pBuffer, pBuffer + samples, m_lastFilteredBuffer.begin());
 
 		// Forward pass: Apply bandpass filter using dominant frequency
-		applyAdaptiveFilter(m_lastFilteredBuffer.data(), samples, dominantFrequencies, frameCenterSamples);
+		if (!applyAdaptiveFilter(m_lastFilteredBuffer.data(), samples, dominantFrequencies, frameCenterSamples, 0.25f, regions))
+		{
+			return;
+		}
 
 		// Step 3: Reverse the filtered buffer
 		std::reverse(m_lastFilteredBuffer.begin(), m_lastFilteredBuffer.end());
@@ -358,7 +459,10 @@ private:
 		}
 
 		// Step 5: Backward pass: Apply filter again (reversed)
-		applyAdaptiveFilter(m_lastFilteredBuffer.data(), samples, reversedDominantFrequencies, reversedFrameCenterSamples);
+		if (!applyAdaptiveFilter(m_lastFilteredBuffer.data(), samples, reversedDominantFrequencies, reversedFrameCenterSamples, 0.5f, regions))
+		{
+			return;
+		}
 
 		// Step 6: Reverse the buffer back
 		std::reverse(m_lastFilteredBuffer.begin(), m_lastFilteredBuffer.end());
@@ -374,6 +478,11 @@ private:
 
 		for (int sample = 1; sample < samples; ++sample)
 		{
+			if (isCancelledAt(sample, samples, 0.75f, 0.25f, regions))
+			{
+				return;
+			}
+
 			float in = m_lastFilteredBuffer[sample];
 
 			if (in > m_threshold)
@@ -409,7 +518,7 @@ private:
 			if (inLast < 0.0f && in >= 0.0f && sinceLast > SINCE_LAST_MIN && wasPositive && wasNegative)
 			{
 				// Choose sample closer to 0
-				if (std::fabsf(inLast) > std::fabsf(in))
+				if (std::fabs(inLast) > std::fabs(in))
 				{
 					regions.push_back(sample);
 				}
@@ -428,11 +537,12 @@ private:
 		}
 	}
 
-	void applyAdaptiveFilter(float* buffer, int samples, const std::vector<float>& dominantFrequencies, const std::vector<int>& frameCenterSamples)
+	// Returns false if cancelled, one pass covers 0.25 of progress starting at progressStart
+	bool applyAdaptiveFilter(float* buffer, int samples, const std::vector<float>& dominantFrequencies, const std::vector<int>& frameCenterSamples, const float progressStart, const std::vector<int>& regions)
 	{
 		if (samples == 0 || dominantFrequencies.empty() || frameCenterSamples.empty())
 		{
-			return;
+			return true;
 		}
 
 		// Create persistent filter objects that maintain state across all samples
@@ -445,6 +555,11 @@ private:
 		// Process each sample with filters tuned to local dominant frequency
 		for (int sample = 0; sample < samples; ++sample)
 		{
+			if (isCancelledAt(sample, samples, progressStart, 0.25f, regions))
+			{
+				return false;
+			}
+
 			// Calculate which frame this sample belongs to based on uniform frame spacing
 			float frameIdx = (float)(sample) / (float)frameDuration - 0.5f;
 
@@ -480,6 +595,8 @@ private:
 
 			buffer[sample] = sample_data;
 		}
+
+		return true;
 	}
 
 	float m_minimumSamplesBetweenCrossings = 240.0f;
@@ -490,4 +607,7 @@ private:
 	float m_minimumLengthMultiplier = 1.0f;
 	std::vector<float> m_lastFilteredBuffer;
 	juce::AudioBuffer<float> m_phaseAudioBuffer;
+	ProgressCallback m_progressCallback;
+	std::atomic<bool> m_cancelled{ false };
+	int m_threadsCount = 1;
 };
\ No newline at end of file
@@ -54,13 +54,28 @@ SmallRoomReverb51AudioProcessorEditor::SmallRoomReverb51AudioProcessorEditor (Sm
 	}
 
 	createCanvas(*this, SLIDERS, N_ROWS);
+
+	startTimerHz(2);
 }
 
 SmallRoomReverb51AudioProcessorEditor::~SmallRoomReverb51AudioProcessorEditor()
 {
+	stopTimer();
 }
 
 //==============================================================================
+void SmallRoomReverb51AudioProcessorEditor::timerCallback()
+{
+	// Show worker threads speedup when 5 channel type runs in parallel
+	juce::String name = "SmallRoomReverb51";
+	if (audioProcessor.getWorkerThreadsCount() > 0)
+	{
+		name << " (x" << juce::String(audioProcessor.getParallelSpeedup(), 2) << ")";
+	}
+
+	m_pluginName.setText(name, juce::dontSendNotification);
+}
+
 void SmallRoomReverb51AudioProcessorEditor::paint (juce::Graphics& g)
 {
 	g.fillAll(ZazzLookAndFeel::BACKGROUND_COLOR);
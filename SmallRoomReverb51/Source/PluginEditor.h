@@ -23,7 +23,7 @@
 #include "../../../zazzVSTPlugins/Shared/GUI/ZazzAudioProcessorEditor.h"
 
 //==============================================================================
-class SmallRoomReverb51AudioProcessorEditor : public juce::AudioProcessorEditor, public ZazzAudioProcessorEditor
+class SmallRoomReverb51AudioProcessorEditor : public juce::AudioProcessorEditor, public ZazzAudioProcessorEditor, public juce::Timer
 {
 public:
     SmallRoomReverb51AudioProcessorEditor (SmallRoomReverb51AudioProcessor&, juce::AudioProcessorValueTreeState&);
@@ -36,6 +36,7 @@ public:
 	static const int N_ROWS = 4;
 	
 	//==============================================================================
+	void timerCallback() override;
 	void paint (juce::Graphics&) override;
     void resized() override;
 
@@ -130,18 +130,41 @@ void SmallRoomReverb51AudioProcessor::prepareToPlay (double sampleRate, int samp
 {
 	const int sr = (int)sampleRate;
 
-	for (int i = 0; i < MAX_CHANNELS; i++)
+	// Only 5.1 bus has enough work to split over two threads
+	const int threads = (getTotalNumOutputChannels() >= WorkerPool::MINIMUM_BUS_WIDTH) ? WorkerPool::getDefaultThreadsCount(2) : 0;
+	m_workerPool.init(threads, sampleRate, samplesPerBlock);
+	m_reverb3.init(sr);
+
+	// Helpers only change here, workgroup changes take effect on the next prepareToPlay
+	m_splitSurround = m_workerPool.getThreadsCount() > 0;
+
+	if (m_splitSurround)
 	{
-		m_reverb[i].init(sr, i);
+		// Ls, Rs keep variations 4, 3 they have in m_reverb5
+		const int surroundVariations[Reverb3::LANES] = { 4, 3, 5, 6 };
+		m_reverbSurround.init(sr, surroundVariations);
+		m_reverb5.release();
+	}
+	else
+	{
+		// Variation 3 is the only one not used by main channels
+		const int reverb5Variations[Reverb5::LANES] = { 0, 1, 2, 4, 3, 5, 6, 7 };
+		m_reverb5.init(sr, reverb5Variations);
+		m_reverbSurround.release();
 	}
 }
 
 void SmallRoomReverb51AudioProcessor::releaseResources()
 {
-	for (int i = 0; i < MAX_CHANNELS; i++)
-	{
-		m_reverb[i].release();
-	}
+	m_workerPool.release();
+	m_reverb5.release();
+	m_reverb3.release();
+	m_reverbSurround.release();
+}
+
+void SmallRoomReverb51AudioProcessor::audioWorkgroupContextChanged(const juce::AudioWorkgroup& workgroup)
+{
+	m_workerPool.setAudioWorkgroup(workgroup);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -169,6 +192,41 @@ bool SmallRoomReverb51AudioProcessor::isBusesLayoutSupported (const BusesLayout&
 }
 #endif
 
+template <typename Reverb>
+void SmallRoomReverb51AudioProcessor::processReverb(Reverb& reverb, float* const* channelBuffers, const int channels, const int samples, const float mix) noexcept
+{
+	constexpr int blockSize = Reverb::BLOCK_SIZE;
+
+	float wet[REVERB5_CHANNELS][blockSize];
+	float* wetBuffers[REVERB5_CHANNELS] = { wet[0], wet[1], wet[2], wet[3], wet[4] };
+
+	for (int start = 0; start < samples; start += blockSize)
+	{
+		const int blockSamples = std::min(blockSize, samples - start);
+
+		for (int channel = 0; channel < channels; channel++)
+		{
+			std::memcpy(wet[channel], channelBuffers[channel] + start, blockSamples * sizeof(float));
+		}
+
+		// Process reverb
+		reverb.process(wetBuffers, channels, blockSamples);
+
+		//Out
+		for (int channel = 0; channel < channels; channel++)
+		{
+			float* channelBuffer = channelBuffers[channel] + start;
+			const float* wetBuffer = wet[channel];
+
+			for (int sample = 0; sample < blockSamples; sample++)
+			{
+				const float in = channelBuffer[sample];
+				channelBuffer[sample] = in - mix * (in - wetBuffer[sample]);
+			}
+		}
+	}
+}
+
 void SmallRoomReverb51AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
 	// Get params
@@ -200,212 +258,163 @@ void SmallRoomReverb51AudioProcessor::processBlock (juce::AudioBuffer<float>& bu
 	}
 
 	// Process
+	constexpr int blockSize = Reverb5::BLOCK_SIZE;
+
+	auto* leftChannelBuffer = buffer.getWritePointer(0);
+	auto* rightChannelBuffer = buffer.getWritePointer(1);
+	auto* centreChannelBuffer = buffer.getWritePointer(2);
+	auto* leftSurroundChannelBuffer = buffer.getWritePointer(4);
+	auto* rightSurroundChannelBuffer = buffer.getWritePointer(5);
+
 	// 5 channel reverb
 	if (type == 1)
 	{
-		for (int channel = 0; channel < channels; channel++)
+		// LFE is not processed
+		if (m_splitSurround)
 		{
-			if (channel == 3)
-			{
-				continue;
-			}
-
-			// Channel pointer
-			auto* channelBuffer = buffer.getWritePointer(channel);
-
-			auto& reverb = m_reverb[channel];
-			reverb.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
+			m_reverb3.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
+				lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
+			m_reverbSurround.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
 				lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
 
-			for (int sample = 0; sample < samples; sample++)
-			{
-				// Read
-				const float in = channelBuffer[sample];
+			float* frontBuffers[] = { leftChannelBuffer, rightChannelBuffer, centreChannelBuffer };
+			float* surroundBuffers[] = { leftSurroundChannelBuffer, rightSurroundChannelBuffer };
 
-				// Process reverb
-				const float out = reverb.process(in);
+			auto processTask = [&](const int task)
+			{
+				if (task == 0)
+				{
+					processReverb(m_reverb3, frontBuffers, 3, samples, mix);
+				}
+				else
+				{
+					processReverb(m_reverbSurround, surroundBuffers, 2, samples, mix);
+				}
+			};
+
+			m_workerPool.run(2, samples, processTask);
+		}
+		else
+		{
+			m_reverb5.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
+				lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
 
-				//Out
-				channelBuffer[sample] = in - mix * (in - out);
-			}
+			float* channelBuffers[REVERB5_CHANNELS] = { leftChannelBuffer, rightChannelBuffer, centreChannelBuffer, leftSurroundChannelBuffer, rightSurroundChannelBuffer };
+			processReverb(m_reverb5, channelBuffers, REVERB5_CHANNELS, samples, mix);
 		}
 	}
-	else if (type == 2)
+	else
 	{
-		auto* leftChannelBuffer = buffer.getWritePointer(0);
-		auto* rightChannelBuffer = buffer.getWritePointer(1);
-		auto* centreChannelBuffer = buffer.getWritePointer(2);
-		auto* LFEChannelBuffer = buffer.getWritePointer(3);
-		auto* leftSurroundChannelBuffer = buffer.getWritePointer(4);
-		auto* rightSurroundChannelBuffer = buffer.getWritePointer(5);
-
-		auto& leftReverb = m_reverb[0];
-		auto& rightReverb = m_reverb[1];
-		auto& backReverb = m_reverb[2];
-
-		leftReverb.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
-			lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
-		rightReverb.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
-			lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
-		backReverb.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
+		m_reverb3.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
 			lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
 
-		for (int sample = 0; sample < samples; sample++)
-		{
-			// Read 5.1
-			const float left = leftChannelBuffer[sample];
-			const float right = rightChannelBuffer[sample];
-			const float centre = centreChannelBuffer[sample];
-			const float leftSurround = leftSurroundChannelBuffer[sample];
-			const float rightSurround = rightSurroundChannelBuffer[sample];
-
-			// Downmix to 3.0
-			float L = 0.5f * left + 0.25f * centre + 0.25f * leftSurround;
-			float R = 0.5f * right + 0.25f * centre + 0.25f * rightSurround;
-			float B = 0.5f * leftSurround + 0.5f * rightSurround;
-
-			// Process
-			L = leftReverb.process(L);
-			R = rightReverb.process(R);
-			B = backReverb.process(B);
-
-			// Upmix to 5.1
-			const float leftUpmix = L;
-			const float rightUpmix = R;
-			const float centreUpmix = 0.5f * L + 0.5f * R;
-			const float leftSurroundUpmix = 0.5f * L + 0.5f * B;
-			const float rightSurroundUpmix = 0.5f * R + 0.5f * B;
-
-			//Out		
-			leftChannelBuffer[sample] = left - mix * (left - leftUpmix);
-			rightChannelBuffer[sample] = right - mix * (right - rightUpmix);
-			centreChannelBuffer[sample] = centre - mix * (centre - centreUpmix);
-			leftSurroundChannelBuffer[sample] = leftSurround - mix * (leftSurround - leftSurroundUpmix);
-			rightSurroundChannelBuffer[sample] = rightSurround - mix * (rightSurround - rightSurroundUpmix);
-		}
-	}
-	else if (type == 3)
-	{		
-		auto* leftChannelBuffer = buffer.getWritePointer(0);
-		auto* rightChannelBuffer = buffer.getWritePointer(1);
-		auto* centreChannelBuffer = buffer.getWritePointer(2);
-		auto* LFEChannelBuffer = buffer.getWritePointer(3);
-		auto* leftSurroundChannelBuffer = buffer.getWritePointer(4);
-		auto* rightSurroundChannelBuffer = buffer.getWritePointer(5);
-
-		auto& leftReverb = m_reverb[0];
-		auto& rightReverb = m_reverb[1];
-		auto& backReverb = m_reverb[2];
-
-		leftReverb.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
-			lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
-		rightReverb.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
-			lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
-		backReverb.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
-			lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
+		float wet[REVERB3_CHANNELS][blockSize];
+		float* wetBuffers[REVERB3_CHANNELS] = { wet[0], wet[1], wet[2] };
 
-		for (int sample = 0; sample < samples; sample++)
+		for (int start = 0; start < samples; start += blockSize)
 		{
-			// Read 5.1
-			const float left = leftChannelBuffer[sample];
-			const float right = rightChannelBuffer[sample];
-			const float centre = centreChannelBuffer[sample];
-			const float leftSurround = leftSurroundChannelBuffer[sample];
-			const float rightSurround = rightSurroundChannelBuffer[sample];
-
-			// Downmix to FOA
-			float gain = 1.0f / sqrtf(5.0f);
-			Ambisonic::BFormat bFormat;
-
-			Ambisonic::encodeToAmbisonics2D(left,			Ambisonic::speakers50Deg[0], bFormat, gain);
-			Ambisonic::encodeToAmbisonics2D(right,			Ambisonic::speakers50Deg[1], bFormat, gain);
-			Ambisonic::encodeToAmbisonics2D(centre,			Ambisonic::speakers50Deg[2], bFormat, gain);
-			Ambisonic::encodeToAmbisonics2D(leftSurround,	Ambisonic::speakers50Deg[3], bFormat, gain);
-			Ambisonic::encodeToAmbisonics2D(rightSurround,	Ambisonic::speakers50Deg[4], bFormat, gain);
-
-			// Process
-			bFormat.W = leftReverb.process(bFormat.W);
-			bFormat.X = rightReverb.process(bFormat.X);
-			bFormat.Y = backReverb.process(bFormat.Y);
-
-			// Upmix to 5.1
-			const float leftUpmix			= Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[0]);
-			const float rightUpmix			= Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[1]);
-			const float centreUpmix			= Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[2]);
-			const float leftSurroundUpmix	= Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[3]);
-			const float rightSurroundUpmix	= Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[4]);
-
-			//Out		
-			leftChannelBuffer[sample] = left - mix * (left - leftUpmix);
-			rightChannelBuffer[sample] = right - mix * (right - rightUpmix);
-			centreChannelBuffer[sample] = centre - mix * (centre - centreUpmix);
-			leftSurroundChannelBuffer[sample] = leftSurround - mix * (leftSurround - leftSurroundUpmix);
-			rightSurroundChannelBuffer[sample] = rightSurround - mix * (rightSurround - rightSurroundUpmix);
-		}
-
-		buffer.applyGain(juce::Decibels::decibelsToGain(-8.0f));
-	}
-	else if (type == 4)
-	{
-	auto* leftChannelBuffer = buffer.getWritePointer(0);
-	auto* rightChannelBuffer = buffer.getWritePointer(1);
-	auto* centreChannelBuffer = buffer.getWritePointer(2);
-	auto* LFEChannelBuffer = buffer.getWritePointer(3);
-	auto* leftSurroundChannelBuffer = buffer.getWritePointer(4);
-	auto* rightSurroundChannelBuffer = buffer.getWritePointer(5);
-
-	auto& leftReverb = m_reverb[0];
-	auto& rightReverb = m_reverb[1];
-	auto& backReverb = m_reverb[2];
+			const int blockSamples = std::min(blockSize, samples - start);
 
-	leftReverb.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
-		lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
-	rightReverb.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
-		lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
-	backReverb.set(earlyReflectionsPredelay, earlyReflectionsMS, earlyReflectionsDamping, earlyReflectionsWidth, earlyReflectionsGain,
-		lateReflectionsPredelay, lateReflectionsSize, lateReflectionsDamping, lateReflectionsWidth, lateReflectionsGain);
+			float* left = leftChannelBuffer + start;
+			float* right = rightChannelBuffer + start;
+			float* centre = centreChannelBuffer + start;
+			float* leftSurround = leftSurroundChannelBuffer + start;
+			float* rightSurround = rightSurroundChannelBuffer + start;
 
-	for (int sample = 0; sample < samples; sample++)
-	{
-		// Read 5.1
-		const float left = leftChannelBuffer[sample];
-		const float right = rightChannelBuffer[sample];
-		const float centre = centreChannelBuffer[sample];
-		const float leftSurround = leftSurroundChannelBuffer[sample];
-		const float rightSurround = rightSurroundChannelBuffer[sample];
-
-		// Downmix to FOA
-		float gain = 1.0f / sqrtf(5.0f);
-		Ambisonic::BFormat bFormat;
-
-		Ambisonic::encodeToAmbisonics2D(left, Ambisonic::speakers50Deg[0], bFormat, gain);
-		Ambisonic::encodeToAmbisonics2D(right, Ambisonic::speakers50Deg[1], bFormat, gain);
-		Ambisonic::encodeToAmbisonics2D(centre, Ambisonic::speakers50Deg[2], bFormat, gain);
-		Ambisonic::encodeToAmbisonics2D(leftSurround, Ambisonic::speakers50Deg[3], bFormat, gain);
-		Ambisonic::encodeToAmbisonics2D(rightSurround, Ambisonic::speakers50Deg[4], bFormat, gain);
-
-		// Process
-		const float W = bFormat.W;
-		bFormat.W = leftReverb.process(W);
-		bFormat.X = rightReverb.process(lateReflectionsWidth * W + (1.0f - lateReflectionsWidth) * bFormat.X);
-		bFormat.Y = backReverb.process(lateReflectionsWidth * W + (1.0f - lateReflectionsWidth) * bFormat.Y);
-
-		// Upmix to 5.1
-		const float leftUpmix = Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[0]);
-		const float rightUpmix = Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[1]);
-		const float centreUpmix = Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[2]);
-		const float leftSurroundUpmix = Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[3]);
-		const float rightSurroundUpmix = Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[4]);
-
-		//Out		
-		leftChannelBuffer[sample] = left - mix * (left - leftUpmix);
-		rightChannelBuffer[sample] = right - mix * (right - rightUpmix);
-		centreChannelBuffer[sample] = centre - mix * (centre - centreUpmix);
-		leftSurroundChannelBuffer[sample] = leftSurround - mix * (leftSurround - leftSurroundUpmix);
-		rightSurroundChannelBuffer[sample] = rightSurround - mix * (rightSurround - rightSurroundUpmix);
-	}
+			if (type == 2)
+			{
+				// Downmix to 3.0
+				for (int sample = 0; sample < blockSamples; sample++)
+				{
+					wet[0][sample] = 0.5f * left[sample] + 0.25f * centre[sample] + 0.25f * leftSurround[sample];
+					wet[1][sample] = 0.5f * right[sample] + 0.25f * centre[sample] + 0.25f * rightSurround[sample];
+					wet[2][sample] = 0.5f * leftSurround[sample] + 0.5f * rightSurround[sample];
+				}
+
+				// Process
+				m_reverb3.process(wetBuffers, REVERB3_CHANNELS, blockSamples);
+
+				for (int sample = 0; sample < blockSamples; sample++)
+				{
+					const float L = wet[0][sample];
+					const float R = wet[1][sample];
+					const float B = wet[2][sample];
+
+					// Upmix to 5.1
+					const float leftUpmix = L;
+					const float rightUpmix = R;
+					const float centreUpmix = 0.5f * L + 0.5f * R;
+					const float leftSurroundUpmix = 0.5f * L + 0.5f * B;
+					const float rightSurroundUpmix = 0.5f * R + 0.5f * B;
+
+					//Out
+					left[sample] = left[sample] - mix * (left[sample] - leftUpmix);
+					right[sample] = right[sample] - mix * (right[sample] - rightUpmix);
+					centre[sample] = centre[sample] - mix * (centre[sample] - centreUpmix);
+					leftSurround[sample] = leftSurround[sample] - mix * (leftSurround[sample] - leftSurroundUpmix);
+					rightSurround[sample] = rightSurround[sample] - mix * (rightSurround[sample] - rightSurroundUpmix);
+				}
+			}
+			else
+			{
+				// Downmix to FOA
+				const float encodeGain = 1.0f / sqrtf(5.0f);
+
+				for (int sample = 0; sample < blockSamples; sample++)
+				{
+					Ambisonic::BFormat bFormat;
+
+					Ambisonic::encodeToAmbisonics2D(left[sample],			Ambisonic::speakers50Deg[0], bFormat, encodeGain);
+					Ambisonic::encodeToAmbisonics2D(right[sample],			Ambisonic::speakers50Deg[1], bFormat, encodeGain);
+					Ambisonic::encodeToAmbisonics2D(centre[sample],			Ambisonic::speakers50Deg[2], bFormat, encodeGain);
+					Ambisonic::encodeToAmbisonics2D(leftSurround[sample],	Ambisonic::speakers50Deg[3], bFormat, encodeGain);
+					Ambisonic::encodeToAmbisonics2D(rightSurround[sample],	Ambisonic::speakers50Deg[4], bFormat, encodeGain);
+
+					wet[0][sample] = bFormat.W;
+
+					if (type == 3)
+					{
+						wet[1][sample] = bFormat.X;
+						wet[2][sample] = bFormat.Y;
+					}
+					else
+					{
+						wet[1][sample] = lateReflectionsWidth * bFormat.W + (1.0f - lateReflectionsWidth) * bFormat.X;
+						wet[2][sample] = lateReflectionsWidth * bFormat.W + (1.0f - lateReflectionsWidth) * bFormat.Y;
+					}
+				}
+
+				// Process
+				m_reverb3.process(wetBuffers, REVERB3_CHANNELS, blockSamples);
+
+				for (int sample = 0; sample < blockSamples; sample++)
+				{
+					Ambisonic::BFormat bFormat;
+					bFormat.W = wet[0][sample];
+					bFormat.X = wet[1][sample];
+					bFormat.Y = wet[2][sample];
+
+					// Upmix to 5.1
+					const float leftUpmix			= Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[0]);
+					const float rightUpmix			= Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[1]);
+					const float centreUpmix			= Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[2]);
+					const float leftSurroundUpmix	= Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[3]);
+					const float rightSurroundUpmix	= Ambisonic::decodeToSpeaker2D(bFormat, Ambisonic::speakers50Deg[4]);
+
+					//Out
+					left[sample] = left[sample] - mix * (left[sample] - leftUpmix);
+					right[sample] = right[sample] - mix * (right[sample] - rightUpmix);
+					centre[sample] = centre[sample] - mix * (centre[sample] - centreUpmix);
+					leftSurround[sample] = leftSurround[sample] - mix * (leftSurround[sample] - leftSurroundUpmix);
+					rightSurround[sample] = rightSurround[sample] - mix * (rightSurround[sample] - rightSurroundUpmix);
+				}
+			}
+		}
 
-	buffer.applyGain(juce::Decibels::decibelsToGain(-8.0f));
+		if (type != 2)
+		{
+			buffer.applyGain(juce::Decibels::decibelsToGain(-8.0f));
+		}
 	}
 
 	buffer.applyGain(gain);
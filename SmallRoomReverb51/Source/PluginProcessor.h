@@ -21,7 +21,8 @@
 
 #include <JuceHeader.h>
 
-#include "../../../zazzVSTPlugins/Shared/Reverbs/SmallRoomReverb.h"
+#include "../../../zazzVSTPlugins/Shared/Reverbs/MultiLaneSmallRoomReverb.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/WorkerPool.h"
 
 //==============================================================================
 class SmallRoomReverb51AudioProcessor  : public juce::AudioProcessor
@@ -39,10 +40,13 @@ public:
 	static const std::string paramsUnitNames[];
 	
 	static const int MAX_CHANNELS = 6;
+	static const int REVERB5_CHANNELS = 5;
+	static const int REVERB3_CHANNELS = 3;
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+	void audioWorkgroupContextChanged(const juce::AudioWorkgroup& workgroup) override;
 
 #ifndef JucePlugin_PreferredChannelConfigurations
 	bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
@@ -78,9 +82,32 @@ public:
 
 	APVTS apvts{ *this, nullptr, "Parameters", createParameterLayout() };
 
+	// Worker threads used by 5 channel type, 0 runs serially
+	int getWorkerThreadsCount()
+	{
+		return m_workerPool.getThreadsCount();
+	}
+	float getParallelSpeedup()
+	{
+		return m_workerPool.getSpeedup();
+	}
+
 private:	
 	//==============================================================================
-	SmallRoomReverb m_reverb[MAX_CHANNELS];
+	using Reverb5 = MultiLaneSmallRoomReverb<8>;
+	using Reverb3 = MultiLaneSmallRoomReverb<4>;
+
+	template <typename Reverb>
+	static void processReverb(Reverb& reverb, float* const* channelBuffers, const int channels, const int samples, const float mix) noexcept;
+
+	// L, R, C, Ls, Rs for 5 channel type, downmixed 3.0 or FOA for other types.
+	// With worker threads 5 channel type runs as two tasks, L, R, C in m_reverb3 and Ls, Rs in m_reverbSurround.
+	Reverb5 m_reverb5;
+	Reverb3 m_reverb3;
+	Reverb3 m_reverbSurround;
+
+	WorkerPool m_workerPool;
+	bool m_splitSurround = false;
 
 	std::atomic<float>* ERpredelayParameter = nullptr;
 	std::atomic<float>* ERsizeParameter = nullptr;
@@ -85,10 +85,14 @@ SpectrumAnalyzerAudioProcessorEditor::~SpectrumAnalyzerAudioProcessorEditor()
 //==============================================================================
 void SpectrumAnalyzerAudioProcessorEditor::timerCallback()
 {
-	juce::ScopedLock lock(scopeLock);
-	
-	m_spectrumAnalyzer.setScopeDataL(audioProcessor.getFrequencySpectrumL().getScopeData());
-	m_spectrumAnalyzer.setScopeDataR(audioProcessor.getFrequencySpectrumR().getScopeData());
+	// Samples pushed by audio thread are analyzed here
+	auto& frequencySpectrumL = audioProcessor.getFrequencySpectrumL();
+	auto& frequencySpectrumR = audioProcessor.getFrequencySpectrumR();
+	frequencySpectrumL.update();
+	frequencySpectrumR.update();
+
+	m_spectrumAnalyzer.setScopeDataL(frequencySpectrumL.getScopeData());
+	m_spectrumAnalyzer.setScopeDataR(frequencySpectrumR.getScopeData());
 	m_spectrumAnalyzer.setType(static_cast<SpectrumAnalyzerComponent::Type>(audioProcessor.getType()));
 	
 	m_spectrumAnalyzer.repaint();
@@ -109,6 +109,9 @@ void SpectrumAnalyzerAudioProcessor::prepareToPlay (double sampleRate, int sampl
 
 	m_frequenycSpectrum[0].init(sr);
 	m_frequenycSpectrum[1].init(sr);
+
+	m_mid.resize(samplesPerBlock);
+	m_side.resize(samplesPerBlock);
 }
 
 void SpectrumAnalyzerAudioProcessor::releaseResources()
@@ -181,32 +184,35 @@ void SpectrumAnalyzerAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
 	{
 		auto& frequencySpectrumM = m_frequenycSpectrum[0];
 		auto& frequencySpectrumS = m_frequenycSpectrum[1];
-		auto* channelDataL = buffer.getWritePointer(0);
-		auto* channelDataR = buffer.getWritePointer(1);
+		auto* channelDataL = buffer.getReadPointer(0);
+		auto* channelDataR = buffer.getReadPointer(1);
+
+		// Host can send larger block than announced, process in chunks
+		const int chunkSize = static_cast<int>(m_mid.size());
 
-		for (int sample = 0; sample < samples; sample++)
+		for (int start = 0; start < samples && chunkSize > 0; start += chunkSize)
 		{
-			const float inL = channelDataL[sample];
-			const float inR = channelDataR[sample];
+			const int count = std::min(chunkSize, samples - start);
+
+			for (int sample = 0; sample < count; sample++)
+			{
+				const float inL = channelDataL[start + sample];
+				const float inR = channelDataR[start + sample];
 
-			const float m = 0.5f * (inL + inR);
-			const float s = 0.5f * (inL - inR);
+				m_mid[sample] = 0.5f * (inL + inR);
+				m_side[sample] = 0.5f * (inL - inR);
+			}
 
-			frequencySpectrumM.process(m);
-			frequencySpectrumS.process(s);
+			frequencySpectrumM.push(m_mid.data(), count);
+			frequencySpectrumS.push(m_side.data(), count);
 		}
 	}
 	else
 	{
+		// Spectrum is calculated on GUI thread
 		for (int channel = 0; channel < channels; channel++)
 		{
-			auto& frequencySpectrum = m_frequenycSpectrum[channel];
-			auto* channelData = buffer.getWritePointer(channel);
-
-			for (int sample = 0; sample < samples; sample++)
-			{
-				frequencySpectrum.process(channelData[sample]);
-			}
+			m_frequenycSpectrum[channel].push(buffer.getReadPointer(channel), samples);
 		}
 	}
 
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include <JuceHeader.h>
 
@@ -92,6 +93,8 @@ public:
 private:
     //==============================================================================
 	std::array<FrequencySpectrum, 2> m_frequenycSpectrum;
+	std::vector<float> m_mid;
+	std::vector<float> m_side;
 
 	juce::AudioParameterBool* buttonAParameter = nullptr;
 	juce::AudioParameterBool* buttonBParameter = nullptr;
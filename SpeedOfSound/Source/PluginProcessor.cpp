@@ -152,7 +152,8 @@ void SpeedOfSoundAudioProcessor::changeProgramName (int index, const juce::Strin
 //==============================================================================
 void SpeedOfSoundAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-	const int size = (int)((float)sampleRate * MAXIMUM_DISTANCE / SPEED_OF_SOUND);
+	// Block reads need one more block of history, tri-linear interpolation reads one sample older
+	const int size = (int)((float)sampleRate * MAXIMUM_DISTANCE / SPEED_OF_SOUND) + BLOCK_SIZE + 2;
 
 	m_delayLine[0].init(size);
 	m_delayLine[1].init(size);
@@ -222,28 +223,39 @@ void SpeedOfSoundAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
 	const auto delaySizeFactor = sampleRate / SPEED_OF_SOUND;
 
+	// Delay lines are written and read per block, delay time still changes every sample
+	float delays[BLOCK_SIZE];
+	float blockLeft[BLOCK_SIZE];
+	float blockRight[BLOCK_SIZE];
+
 	if (channels == 1)
 	{
 		// Channel pointer
 		auto* channelBuffer = buffer.getWritePointer(0);
 
-		for (int sample = 0; sample < samples; sample++)
+		for (int start = 0; start < samples; start += BLOCK_SIZE)
 		{
-			// Read
-			const auto in = channelBuffer[sample];
+			const int count = std::min(BLOCK_SIZE, samples - start);
+			float* block = channelBuffer + start;
+
+			for (int sample = 0; sample < count; sample++)
+			{
+				// Read
+				const auto in = block[sample];
 
-			// Delay
-			const auto distanceSmooth = m_distanceSmoother.process(distance);
-			const auto attenuationGain = Math::getAmplitudeAttenuation(distanceSmooth, getAttenuationFactor(attenuation), 1.0f);
+				// Delay
+				const auto distanceSmooth = m_distanceSmoother.process(distance);
+				const auto attenuationGain = Math::getAmplitudeAttenuation(distanceSmooth, getAttenuationFactor(attenuation), 1.0f);
 
-			m_absorbtionFilter[0].setCoef(getAbsorbtionFrequency(distanceSmooth, absorbtion));
+				m_absorbtionFilter[0].setCoef(getAbsorbtionFrequency(distanceSmooth, absorbtion));
 
-			m_delayLine[0].write(m_absorbtionFilter[0].process(attenuationGain * in));
-			
-			const auto out = m_delayLine[0].readDelayTriLinearInterpolation(distanceSmooth * delaySizeFactor);
+				blockLeft[sample] = m_absorbtionFilter[0].process(attenuationGain * in);
+				delays[sample] = distanceSmooth * delaySizeFactor;
+			}
 
 			//Out
-			channelBuffer[sample] = out;
+			m_delayLine[0].writeBlock(blockLeft, count);
+			m_delayLine[0].readDelayBlock<CircularBuffer::Interpolation::TriLinear>(delays, block, count);
 		}
 	}
 	if (channels == 2)
@@ -252,30 +264,37 @@ void SpeedOfSoundAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 		auto* channelBufferLeft = buffer.getWritePointer(0);
 		auto* channelBufferRight = buffer.getWritePointer(1);
 
-		for (int sample = 0; sample < samples; sample++)
+		for (int start = 0; start < samples; start += BLOCK_SIZE)
 		{
-			// Read
-			const auto inLeft = channelBufferLeft[sample];
-			const auto inRight = channelBufferRight[sample];
+			const int count = std::min(BLOCK_SIZE, samples - start);
+			float* left = channelBufferLeft + start;
+			float* right = channelBufferRight + start;
 
+			for (int sample = 0; sample < count; sample++)
+			{
+				// Read
+				const auto inLeft = left[sample];
+				const auto inRight = right[sample];
 
-			// Delay
-			const auto distanceSmooth = m_distanceSmoother.process(distance);
-			const auto attenuationGain = Math::getAmplitudeAttenuation(distanceSmooth, getAttenuationFactor(attenuation), 1.0f);
-			const auto panSmooth = m_panSmoother.process(pan);
+				// Delay
+				const auto distanceSmooth = m_distanceSmoother.process(distance);
+				const auto attenuationGain = Math::getAmplitudeAttenuation(distanceSmooth, getAttenuationFactor(attenuation), 1.0f);
+				const auto panSmooth = m_panSmoother.process(pan);
 
-			m_absorbtionFilter[0].setCoef(getAbsorbtionFrequency(distanceSmooth, absorbtion));
-			m_absorbtionFilter[1].setCoef(getAbsorbtionFrequency(distanceSmooth, absorbtion));
+				m_absorbtionFilter[0].setCoef(getAbsorbtionFrequency(distanceSmooth, absorbtion));
+				m_absorbtionFilter[1].setCoef(getAbsorbtionFrequency(distanceSmooth, absorbtion));
 
-			m_delayLine[0].write(m_absorbtionFilter[0].process(attenuationGain * inLeft * (2.0f - panSmooth)));
-			m_delayLine[1].write(m_absorbtionFilter[1].process(attenuationGain * inRight * panSmooth));
-
-			const auto outLeft = m_delayLine[0].readDelayTriLinearInterpolation(distanceSmooth * delaySizeFactor);
-			const auto outRight = m_delayLine[1].readDelayTriLinearInterpolation(distanceSmooth * delaySizeFactor);
+				blockLeft[sample] = m_absorbtionFilter[0].process(attenuationGain * inLeft * (2.0f - panSmooth));
+				blockRight[sample] = m_absorbtionFilter[1].process(attenuationGain * inRight * panSmooth);
+				delays[sample] = distanceSmooth * delaySizeFactor;
+			}
 
 			//Out
-			channelBufferLeft[sample] = outLeft;
-			channelBufferRight[sample] = outRight;
+			m_delayLine[0].writeBlock(blockLeft, count);
+			m_delayLine[1].writeBlock(blockRight, count);
+
+			m_delayLine[0].readDelayBlock<CircularBuffer::Interpolation::TriLinear>(delays, left, count);
+			m_delayLine[1].readDelayBlock<CircularBuffer::Interpolation::TriLinear>(delays, right, count);
 		}
 	}
 
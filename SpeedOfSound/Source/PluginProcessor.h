@@ -42,6 +42,7 @@ public:
     static const int N_CHANNELS = 2;
 	static constexpr float MAXIMUM_DISTANCE = 1000.0f;
 	static constexpr float SPEED_OF_SOUND = 343.0f;
+	static constexpr int BLOCK_SIZE = 64;
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
@@ -136,16 +136,12 @@ void TubePreampAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
 	m_bias = new float[samplesPerBlock];
 
 	// Initialize  oversampling
-	oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
-		getTotalNumOutputChannels(),					// number of channels
-		OVERSAMPLING_FACTOR,							// oversampling factor. E.g.2^4 = 16x
-		juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
-		true);											// use interpolation for better quality
-
-	oversampler->reset();
-	oversampler->initProcessing(samplesPerBlock);
+	for (int channel = 0; channel < N_CHANNELS; channel++)
+	{
+		m_oversampling[channel].init((int)sampleRate, OVERSAMPLING_MULTIPLIER, samplesPerBlock, Oversampling::Phase::Minimum);
+	}
 
-	setLatencySamples((int)oversampler->getLatencyInSamples());
+	setLatencySamples(m_oversampling[0].getLatencyInSamples());
 }
 
 void TubePreampAudioProcessor::releaseResources()
@@ -198,62 +194,72 @@ void TubePreampAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
 	const float drivePerStagedB = drivedB / (float)N_STAGES;
 	const float drivePerStage = juce::Decibels::decibelsToGain(drivePerStagedB);
 
-	// Upsample
-	juce::dsp::AudioBlock<float> block(buffer);
-	auto oversampledBlock = oversampler->processSamplesUp(block);
-
 	for (int channel = 0; channel < channels; channel++)
 	{
 		auto* channelBuffer = buffer.getWritePointer(channel);
 		auto& envelopeFollower = m_envelopeFollower[channel];
+		auto& oversampling = m_oversampling[channel];
 
-		for (int sample = 0; sample < samples; sample++)
-		{
-			// Get input
-			float& in = channelBuffer[sample];
-
-			const float envelope = envelopeFollower.process(drive * in);
+		// Host can send larger block than announced, m_bias and oversampling hold samplesPerBlock
+		const int maxSamples = oversampling.getMaxSamples();
 
-			//const float bias = Math::remap(envelope, 0.1f, 0.6f, 0.00f, 0.15f);
-			constexpr float xMin = 0.1f;
-			constexpr float xMax = 0.6f;
-			constexpr float yMin = 0.0f;
-			constexpr float yMax = 0.15f;
-			constexpr float slope = yMax / (xMax - xMin);	// 0.15 / 0.5
-			constexpr float offset = -0.03f;				// -0.1 * 0.3
-			float bias = envelope * slope + offset;
-			bias = Math::clamp(bias, yMin, yMax);
-
-			m_bias[sample] = bias;
-		}
-
-		auto* oversampleBuffer = oversampledBlock.getChannelPointer(channel);
-		
-		for (int sample = 0; sample < oversampledBlock.getNumSamples(); sample++)
+		for (int start = 0; start < samples; start += maxSamples)
 		{
-			// Get input
-			float& in = oversampleBuffer[sample];
-
-			const float bias = m_bias[sample / OVERSAMPLING_MULTIPLIER];
-
-			float out = in;
-			out = TubeEmulation::process(drivePerStage * out + bias);
-			out = TubeEmulation::process(drivePerStage * out - bias);
-			out = TubeEmulation::process(drivePerStage * out + bias);
-			out = TubeEmulation::process(drivePerStage * out - bias);
-			out = TubeEmulation::process(drivePerStage * out + bias);
-			out = TubeEmulation::process(drivePerStage * out - bias);
-			out = TubeEmulation::process(drivePerStage * out + bias);
-			out = TubeEmulation::process(drivePerStage * out - bias);
+			const int chunk = std::min(maxSamples, samples - start);
+			float* chunkBuffer = channelBuffer + start;
+
+			for (int sample = 0; sample < chunk; sample++)
+			{
+				// Get input
+				float& in = chunkBuffer[sample];
+
+				const float envelope = envelopeFollower.process(drive * in);
+
+				//const float bias = Math::remap(envelope, 0.1f, 0.6f, 0.00f, 0.15f);
+				constexpr float xMin = 0.1f;
+				constexpr float xMax = 0.6f;
+				constexpr float yMin = 0.0f;
+				constexpr float yMax = 0.15f;
+				constexpr float slope = yMax / (xMax - xMin);	// 0.15 / 0.5
+				constexpr float offset = -0.03f;				// -0.1 * 0.3
+				float bias = envelope * slope + offset;
+				bias = Math::clamp(bias, yMin, yMax);
+
+				m_bias[sample] = bias;
+			}
+
+			// Upsample
+			oversampling.oversample(chunkBuffer, chunk);
+
+			auto* oversampleBuffer = oversampling.getOversampeBuffer();
+			const int oversampleSamples = oversampling.getOversampeBufferSize();
+		
+			for (int sample = 0; sample < oversampleSamples; sample++)
+			{
+				// Get input
+				float& in = oversampleBuffer[sample];
+
+				const float bias = m_bias[sample / OVERSAMPLING_MULTIPLIER];
+
+				float out = in;
+				out = TubeEmulation::process(drivePerStage * out + bias);
+				out = TubeEmulation::process(drivePerStage * out - bias);
+				out = TubeEmulation::process(drivePerStage * out + bias);
+				out = TubeEmulation::process(drivePerStage * out - bias);
+				out = TubeEmulation::process(drivePerStage * out + bias);
+				out = TubeEmulation::process(drivePerStage * out - bias);
+				out = TubeEmulation::process(drivePerStage * out + bias);
+				out = TubeEmulation::process(drivePerStage * out - bias);
 			
-			// Store output
-			in = out;
+				// Store output
+				in = out;
+			}
+
+			// Downsample
+			oversampling.downsample(chunkBuffer, chunk);
 		}
 	}
 
-	// Downsample
-	oversampler->processSamplesDown(block);
-
 	// LP + HP filters
 	for (int channel = 0; channel < channels; channel++)
 	{
@@ -21,6 +21,7 @@
 #include "../../../zazzVSTPlugins/Shared/NonLinearFilters/TubeEmulation.h"
 #include "../../../zazzVSTPlugins/Shared/Filters/BiquadFilters.h"
 #include "../../../zazzVSTPlugins/Shared/Dynamics/EnvelopeFollowers.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/Oversampling.h"
 
 //==============================================================================
 class TubePreampAudioProcessor  : public juce::AudioProcessor
@@ -82,7 +83,7 @@ public:
 
 private:	
 	//==============================================================================
-	std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+	Oversampling m_oversampling[N_CHANNELS];
 	
 	BiquadFilter m_preFilter[N_STAGES];
 	BiquadFilter m_postFilter[N_STAGES];
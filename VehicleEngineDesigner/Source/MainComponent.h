@@ -14,6 +14,8 @@
 #include "SpectrumMatchRegionProcessor.h"
 #include "SliderConfig.h"
 #include "ZeroPhaseFilter.h"
+#include "RegionDetectionJob.h"
+#include "RegionResampler.h"
 
 
 //==============================================================================
@@ -21,7 +23,7 @@
 	This component lives inside our window, and this is where you should put all
 	your controls and content.
 */
-class MainComponent  : public juce::AudioAppComponent, public juce::ChangeListener
+class MainComponent  : public juce::AudioAppComponent, public juce::ChangeListener, public juce::Timer
 {
 public:
 	//==============================================================================
@@ -78,6 +80,10 @@ public:
 	static const int FFT_ORDER = 14;
 	static const int FFT_SIZE = 1 << FFT_ORDER;
 
+	static const int DETECTION_TIMER_INTERVAL_MS = 100;
+	static const int GENERATE_THREADS_COUNT = 0;				// All cores
+	static const int GENERATE_MIN_REGIONS_PER_THREAD = 64;
+
 	//==============================================================================
 	void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
 	void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override;
@@ -95,6 +101,8 @@ public:
 	//==========================================================================
 	void openSourceButtonClicked()
 	{
+		cancelRegionDetection();
+
 		zazzDSP::FileIO::openWavFile(
 			m_bufferSource,
 			m_sampleRate,
@@ -217,44 +225,58 @@ public:
 			m_bufferOutput.setSize(channels, outputSize);
 		}
 
-		for (int channel = 0; channel < channels; channel++)
+		// Valid regions in the specified range, k-th valid region is written at k * exportRegionLength
+		std::vector<int> validRegionIndices;
+		validRegionIndices.reserve(validRegionsCount);
+		for (int regionIdx = exportRegionLeftIdx; regionIdx < exportRegionRightIdx; regionIdx++)
 		{
-			auto* pBufferSource = m_bufferSource.getReadPointer(channel);
-			auto* pBufferOut = m_bufferOutput.getWritePointer(channel);
+			if (m_regions[regionIdx].m_isValid)
+			{
+				validRegionIndices.push_back(regionIdx);
+			}
+		}
 
-			int outIndex = 0;
+		const bool linearInterpolation = m_interpolationType == InterpolationType::Linear;
 
-			// Only process regions in the specified range
-			for (int regionIdx = exportRegionLeftIdx; regionIdx < exportRegionRightIdx; regionIdx++)
+		// Regions are independent
+		zazzDSP::Parallel::forRanges(validRegionsCount, GENERATE_THREADS_COUNT, GENERATE_MIN_REGIONS_PER_THREAD, [&](const int, const int first, const int last)
+		{
+			RegionResampler resampler;
+			resampler.prepare(exportRegionLength);
+
+			for (int k = first; k < last; k++)
 			{
-				Region& region = m_regions[regionIdx];
+				const Region& region = m_regions[validRegionIndices[k]];
+				const int outIndex = k * exportRegionLength;
 
-				if (!region.m_isValid)
+				// Same geometry for all channels
+				resampler.setRegion(region.m_sampleIndex, region.m_length, exportRegionLength, sourceSize, linearInterpolation);
+
+				for (int channel = 0; channel < channels; channel++)
 				{
-					continue;
+					resampler.process(m_bufferSource.getReadPointer(channel), m_bufferOutput.getWritePointer(channel) + outIndex);
 				}
+			}
+		});
 
-				const int segmentStartIndex = region.m_sampleIndex;
-				const int sourceRegionLength = region.m_length;
+		// Apply spectrum matching if enabled, in place
+		if (m_useSpectrumMatching && m_spectrumRegionProcessor)
+		{
+			std::vector<SpectrumMatchRegionProcessor::RegionJob> jobs;
+			jobs.reserve(channels * validRegionsCount);
 
-				// Get resampled region data
-				std::vector<float> resampledRegion;
-				getResampledRegionData(pBufferSource, segmentStartIndex, sourceRegionLength, exportRegionLength, sourceSize, resampledRegion);
+			for (int channel = 0; channel < channels; channel++)
+			{
+				auto* pBufferOut = m_bufferOutput.getWritePointer(channel);
 
-				// Apply spectrum matching if enabled
-				if (m_useSpectrumMatching && m_spectrumRegionProcessor)
-				{
-					std::vector<float> adjustedRegion(exportRegionLength);
-					m_spectrumRegionProcessor->applySpectrumAdjustment(resampledRegion.data(), exportRegionLength, adjustedRegion.data());
-					std::copy(adjustedRegion.begin(), adjustedRegion.end(), pBufferOut + outIndex);
-				}
-				else
+				for (int k = 0; k < validRegionsCount; k++)
 				{
-					std::copy(resampledRegion.begin(), resampledRegion.end(), pBufferOut + outIndex);
+					float* pRegion = pBufferOut + k * exportRegionLength;
+					jobs.push_back({ pRegion, pRegion, exportRegionLength });
 				}
-
-				outIndex += exportRegionLength;
 			}
+
+			m_spectrumRegionProcessor->applySpectrumAdjustment(jobs, 1.0f, GENERATE_THREADS_COUNT);
 		}
 
 		// Set output waveform
@@ -337,149 +359,87 @@ public:
 		const int channels = m_bufferSource.getNumChannels();
 		tempBuffer.setSize(channels, tempBufferLength);
 
-		for (int channel = 0; channel < channels; channel++)
+		// Valid regions in the specified range, k-th valid region is written at k * tempRegionLength
+		std::vector<int> validRegionIndices;
+		validRegionIndices.reserve(tempBufferRegionCount);
+		for (int regionIdx = exportRegionLeftIdx; regionIdx < exportRegionRightIdx; regionIdx++)
 		{
-			auto* pBufferSource = m_bufferSource.getWritePointer(channel);
-			auto* pTempBuffer = tempBuffer.getWritePointer(channel);
-			int writeIndex = 0;
-
-			for (int regionIdx = exportRegionLeftIdx; regionIdx < exportRegionRightIdx; regionIdx++)
+			if (m_regions[regionIdx].m_isValid)
 			{
-				// Ignore invalid regions
-				if (m_regions[regionIdx].m_isValid == false)
-				{
-					continue;
-				}
+				validRegionIndices.push_back(regionIdx);
+			}
+		}
 
-				float readIndex = (float)m_regions[regionIdx].m_sampleIndex;
-				const int regionLenghtSource = m_regions[regionIdx].m_length;
-				const float indexIncrement = (float)regionLenghtSource / (float)exportRegionLength;
+		const bool linearInterpolation = m_interpolationType == InterpolationType::Linear;
 
-				readIndex -= halfCrossfade * indexIncrement;
+		// Odd crossfade leaves last sample of temp region silent
+		const int segmentLength = halfCrossfade + exportRegionLength + halfCrossfade;
 
-				// Collect full segment data (fade in + region + fade out)
-				std::vector<float> fullSegmentData(tempRegionLength);
-				int segmentWriteIndex = 0;
-
-				// Fade in data - with envelope applied BEFORE FFT for proper windowing
-				for (int i = 0; i < halfCrossfade; i++)
-				{
-					float sample = 0.0f;
-					if (m_interpolationType == InterpolationType::Point)
-					{
-						sample = (readIndex >= 0 && readIndex < sourceSampleCount) ? pBufferSource[(int)readIndex] : 0.0f;
-					}
-					else if (m_interpolationType == InterpolationType::Linear)
-					{
-						const int indexLeft = (int)readIndex;
-						const int indexRight = indexLeft + 1;
+		// Fade in (0 -> 1) and fade out (1 -> 0) envelopes for loopable segment
+		auto applyFades = [halfCrossfade, exportRegionLength](float* segment)
+		{
+			for (int i = 0; i < halfCrossfade; i++)
+			{
+				segment[i] *= ((float)(i + 1) / (float)halfCrossfade);
+				segment[halfCrossfade + exportRegionLength + i] *= (1.0f - ((float)(i + 1) / (float)halfCrossfade));
+			}
+		};
 
-						float valueLeft = 0.0f;
-						float valueRight = 0.0f;
+		// Regions are independent
+		zazzDSP::Parallel::forRanges(tempBufferRegionCount, GENERATE_THREADS_COUNT, GENERATE_MIN_REGIONS_PER_THREAD, [&](const int, const int first, const int last)
+		{
+			RegionResampler resampler;
+			resampler.prepare(segmentLength);
 
-						if (indexLeft >= 0 && indexLeft < sourceSampleCount)
-							valueLeft = pBufferSource[indexLeft];
-						if (indexRight >= 0 && indexRight < sourceSampleCount)
-							valueRight = pBufferSource[indexRight];
+			for (int k = first; k < last; k++)
+			{
+				const Region& region = m_regions[validRegionIndices[k]];
+				const int writeIndex = k * tempRegionLength;
 
-						const float delta = readIndex - std::floor(readIndex);
-						sample = valueLeft * (1.0f - delta) + valueRight * delta;
-					}
+				// Collect full segment data (fade in + region + fade out), same geometry for all channels
+				const float indexIncrement = (float)region.m_length / (float)exportRegionLength;
+				float readIndex = (float)region.m_sampleIndex;
+				readIndex -= halfCrossfade * indexIncrement;
 
-					// Apply fade-in envelope (0 -> 1) BEFORE FFT for loopable segment
-					fullSegmentData[segmentWriteIndex] = sample * ((float)(i + 1) / (float)halfCrossfade);
-					segmentWriteIndex++;
-					readIndex += indexIncrement;
-				}
+				resampler.setSegment(readIndex, indexIncrement, segmentLength, sourceSampleCount, linearInterpolation);
 
-				// Region data (no envelope in middle section)
-				for (int i = 0; i < exportRegionLength; i++)
+				for (int channel = 0; channel < channels; channel++)
 				{
-					if (m_interpolationType == InterpolationType::Point)
-					{
-						fullSegmentData[segmentWriteIndex] = (readIndex >= 0 && readIndex < sourceSampleCount) ? pBufferSource[(int)readIndex] : 0.0f;
-					}
-					else if (m_interpolationType == InterpolationType::Linear)
-					{
-						const int indexLeft = (int)readIndex;
-						const int indexRight = indexLeft + 1;
+					auto* pBufferSource = m_bufferSource.getReadPointer(channel);
+					auto* pTempBuffer = tempBuffer.getWritePointer(channel) + writeIndex;
 
-						float valueLeft = 0.0f;
-						float valueRight = 0.0f;
-
-						if (indexLeft >= 0 && indexLeft < sourceSampleCount)
-							valueLeft = pBufferSource[indexLeft];
-						if (indexRight >= 0 && indexRight < sourceSampleCount)
-							valueRight = pBufferSource[indexRight];
-
-						const float delta = readIndex - std::floor(readIndex);
-						const float interpolated = valueLeft * (1.0f - delta) + valueRight * delta;
-
-						fullSegmentData[segmentWriteIndex] = interpolated;
-					}
-
-					segmentWriteIndex++;
-					readIndex += indexIncrement;
+					// Envelope applied BEFORE FFT for proper windowing
+					resampler.process(pBufferSource, pTempBuffer);
+					std::fill(pTempBuffer + segmentLength, pTempBuffer + tempRegionLength, 0.0f);
+					applyFades(pTempBuffer);
 				}
+			}
+		});
 
-				// Fade out data - with envelope applied BEFORE FFT for proper windowing
-				for (int i = 0; i < halfCrossfade; i++)
-				{
-					float sample = 0.0f;
-					if (m_interpolationType == InterpolationType::Point)
-					{
-						sample = (readIndex >= 0 && readIndex < sourceSampleCount) ? pBufferSource[(int)readIndex] : 0.0f;
-					}
-					else if (m_interpolationType == InterpolationType::Linear)
-					{
-						const int indexLeft = (int)readIndex;
-						const int indexRight = indexLeft + 1;
-
-						float valueLeft = 0.0f;
-						float valueRight = 0.0f;
-
-						if (indexLeft >= 0 && indexLeft < sourceSampleCount)
-							valueLeft = pBufferSource[indexLeft];
-						if (indexRight >= 0 && indexRight < sourceSampleCount)
-							valueRight = pBufferSource[indexRight];
-
-						const float delta = readIndex - std::floor(readIndex);
-						sample = valueLeft * (1.0f - delta) + valueRight * delta;
-					}
+		// Apply spectrum matching to entire segments if enabled, in place
+		if (m_useSpectrumMatching && m_spectrumRegionProcessor)
+		{
+			std::vector<SpectrumMatchRegionProcessor::RegionJob> jobs;
+			jobs.reserve(channels * tempBufferRegionCount);
 
-					// Apply fade-out envelope (1 -> 0) BEFORE FFT for loopable segment
-					fullSegmentData[segmentWriteIndex] = sample * (1.0f - ((float)(i + 1) / (float)halfCrossfade));
-					segmentWriteIndex++;
-					readIndex += indexIncrement;
-				}
+			for (int channel = 0; channel < channels; channel++)
+			{
+				auto* pTempBuffer = tempBuffer.getWritePointer(channel);
 
-				// Apply spectrum matching to entire segment if enabled
-				std::vector<float> processedSegment(tempRegionLength);
-				if (m_useSpectrumMatching && m_spectrumRegionProcessor)
+				for (int k = 0; k < tempBufferRegionCount; k++)
 				{
 					// DC offset should be calculated only from middle region (no envelopes) when crossfade > 0
-					m_spectrumRegionProcessor->applySpectrumAdjustment(fullSegmentData.data(), tempRegionLength, processedSegment.data(), m_spectrumMatchIntensity, halfCrossfade, halfCrossfade + exportRegionLength - 1);
-
-					// Apply fade envelopes AGAIN after spectrum matching to ensure smooth boundaries post-FFT
-					// Apply fade-in envelope to first halfCrossfade samples
-					for (int i = 0; i < halfCrossfade; i++)
-					{
-						processedSegment[i] *= ((float)(i + 1) / (float)halfCrossfade);
-					}
-
-					// Apply fade-out envelope to last halfCrossfade samples
-					for (int i = 0; i < halfCrossfade; i++)
-					{
-						processedSegment[halfCrossfade + exportRegionLength + i] *= (1.0f - ((float)(i + 1) / (float)halfCrossfade));
-					}
-				}
-				else
-				{
-					std::copy(fullSegmentData.begin(), fullSegmentData.end(), processedSegment.begin());
+					float* pSegment = pTempBuffer + k * tempRegionLength;
+					jobs.push_back({ pSegment, pSegment, tempRegionLength, halfCrossfade, halfCrossfade + exportRegionLength - 1 });
 				}
+			}
+
+			m_spectrumRegionProcessor->applySpectrumAdjustment(jobs, m_spectrumMatchIntensity, GENERATE_THREADS_COUNT);
 
-				std::copy(processedSegment.begin(), processedSegment.end(), pTempBuffer + writeIndex);
-				writeIndex += tempRegionLength;
+			// Apply fade envelopes AGAIN after spectrum matching to ensure smooth boundaries post-FFT
+			for (const auto& job : jobs)
+			{
+				applyFades(job.output);
 			}
 		}
 
@@ -631,38 +591,6 @@ public:
 		}
 	}
 
-	//==========================================================================
-	void getResampledRegionData(const float* pBufferChan, int segmentStartIndex, int sourceRegionLength, 
-								int exportRegionLength, const int sourceSize, std::vector<float>& outData)
-	{
-		outData.resize(exportRegionLength);
-		const float indexIncrement = (float)sourceRegionLength / (float)exportRegionLength;
-		float sourceIndex = 0.0f;
-
-		for (int i = 0; i < exportRegionLength; i++)
-		{
-			if (m_interpolationType == InterpolationType::Point)
-			{
-				outData[i] = pBufferChan[segmentStartIndex + (int)sourceIndex];
-			}
-			else if (m_interpolationType == InterpolationType::Linear)
-			{
-				const int indexLeft = segmentStartIndex + (int)sourceIndex;
-				const int indexRight = indexLeft < sourceSize - 1 ? indexLeft + 1 : indexLeft;
-
-				const float valueLeft = pBufferChan[indexLeft];
-				const float valueRight = pBufferChan[indexRight];
-
-				const float delta = sourceIndex - std::floor(sourceIndex);
-				const float interpolated = valueLeft * (1.0f - delta) + valueRight * delta;
-
-				outData[i] = interpolated;
-			}
-
-			sourceIndex += indexIncrement;
-		}
-	}
-
 	//==========================================================================
 	void exportRegionsButtonClicked()
 	{
@@ -741,8 +669,14 @@ public:
 			int paddingWidth = juce::String((int)m_regions.size() - 1).length();
 
 			const auto channels = m_bufferSource.getNumChannels();
-			auto* pBufferSource = m_bufferSource.getWritePointer(0);
 			const int sourceSize = m_bufferSource.getNumSamples();
+			const bool linearInterpolation = m_interpolationType == InterpolationType::Linear;
+
+			// Reused for all regions
+			juce::AudioBuffer<float> regionBuffer(channels, exportRegionLength);
+			std::vector<float> resampledRegion(exportRegionLength);
+			RegionResampler resampler;
+			resampler.prepare(exportRegionLength);
 
 			int exportedCount = 0;
 
@@ -754,31 +688,23 @@ public:
 				if (!region.m_isValid)
 					continue;
 
-				// Create buffer for this region
-				juce::AudioBuffer<float> regionBuffer(channels, exportRegionLength);
+				// Resample and interpolate region data, same geometry for all channels
+				resampler.setRegion(region.m_sampleIndex, region.m_length, exportRegionLength, sourceSize, linearInterpolation);
 
-				const int segmentStartIndex = region.m_sampleIndex;
-				const int sourceRegionLength = region.m_length;
-				const float indexIncrement = (float)sourceRegionLength / (float)exportRegionLength;
-
-				// Resample and interpolate region data
 				for (int channel = 0; channel < channels; channel++)
 				{
 					auto* pBufferChan = m_bufferSource.getReadPointer(channel);
 					auto* pRegionBuffer = regionBuffer.getWritePointer(channel);
 
-					// Get resampled region
-					std::vector<float> resampledRegion;
-					getResampledRegionData(pBufferChan, segmentStartIndex, sourceRegionLength, exportRegionLength, sourceSize, resampledRegion);
-
 					// Apply spectrum matching if enabled
 					if (m_useSpectrumMatching && m_spectrumRegionProcessor)
 					{
+						resampler.process(pBufferChan, resampledRegion.data());
 						m_spectrumRegionProcessor->applySpectrumAdjustment(resampledRegion.data(), exportRegionLength, pRegionBuffer);
 					}
 					else
 					{
-						std::copy(resampledRegion.begin(), resampledRegion.end(), pRegionBuffer);
+						resampler.process(pBufferChan, pRegionBuffer);
 					}
 				}
 
@@ -819,6 +745,8 @@ public:
 	//==========================================================================
 	void newProjectButtonClicked()
 	{
+		cancelRegionDetection();
+
 		// Clear all buffers
 		{
 			std::lock_guard<std::mutex> lock(m_bufferMutex);
@@ -906,6 +834,8 @@ public:
 			if (projectFile == juce::File())
 				return;
 
+			cancelRegionDetection();
+
 			juce::String fileContents = projectFile.loadFileAsString();
 			auto jsonVar = juce::JSON::parse(fileContents);
 
@@ -1294,81 +1224,134 @@ public:
 	
 	//==========================================================================
 	void detectRegionsButtonClicked()
-	{		
+	{
+		// Button doubles as cancel while detection runs
+		if (m_regionDetectionJob.getState() == RegionDetectionJob::State::Running)
+		{
+			m_regionDetectionJob.cancel();
+			return;
+		}
+
 		if (m_bufferSource.getNumSamples() == 0)
 		{
 			return;
 		}
 
 		const int detectionTypeId = m_detectionTypeComboBox.getSelectedId();
-		ZeroCrossingOffline::Type detectionType = ZeroCrossingOffline::Type::Amplitude;
+
+		RegionDetectionJob::Settings settings;
+		settings.type = ZeroCrossingOffline::Type::Amplitude;
 		if (detectionTypeId == static_cast<int>(DetectionType::FFT))
 		{
-			detectionType = ZeroCrossingOffline::Type::FFT;
+			settings.type = ZeroCrossingOffline::Type::FFT;
 		}
 		else if (detectionTypeId == static_cast<int>(DetectionType::AmplitudeAdaptiveFilter))
 		{
-			detectionType = ZeroCrossingOffline::Type::AmplitudeAdaptiveFilter;
+			settings.type = ZeroCrossingOffline::Type::AmplitudeAdaptiveFilter;
 		}
-		const float minimumSamplesBetweenCrossings = (float)m_minimumLengthSlider.getValue();
-		const float minimumLengthMultiplier = (float)m_minimumLengthMultiplierSlider.getValue();
-		const bool isFilterType = detectionTypeId == static_cast<int>(DetectionType::AmplitudeFilter);
-		
-			
-		ZeroCrossingOffline zeroCrossing{};
-		zeroCrossing.init(m_sampleRate);
-
-		zeroCrossing.setAmplitudeThreshold((float)juce::Decibels::decibelsToGain(m_thresholdSlider.getValue()));
-		zeroCrossing.setMinimumSamplesBetweenCrossings(minimumSamplesBetweenCrossings);
-		zeroCrossing.setType(detectionType);
-		zeroCrossing.setFFTPhaseThreshold((float)m_fftPhaseThresholdSlider.getValue());
-		zeroCrossing.setMinimumLengthMultiplier(minimumLengthMultiplier);
-	
-		juce::AudioBuffer<float> filteredBuffer;
-		juce::AudioBuffer<float> bufferForProcessing;
+		settings.sampleRate = m_sampleRate;
+		settings.threshold = (float)juce::Decibels::decibelsToGain(m_thresholdSlider.getValue());
+		settings.minimumSamplesBetweenCrossings = (float)m_minimumLengthSlider.getValue();
+		settings.minimumLengthMultiplier = (float)m_minimumLengthMultiplierSlider.getValue();
+		settings.fftPhaseThreshold = (float)m_fftPhaseThresholdSlider.getValue();
+		settings.applyBandPass = detectionTypeId == static_cast<int>(DetectionType::AmplitudeFilter);
+		settings.highPassFrequency = 10.0f;
+		settings.lowPassFrequency = (float)m_sampleRate / (float)m_lowPassFrequencySlider.getValue();
+
+		// Settings used when the result arrives, sliders can change meanwhile
+		m_detectionTypeId = detectionTypeId;
+		m_detectionGroupCount = static_cast<int>(m_zeroCrossingCountSlider.getValue());
+		m_detectionCrossings.clear();
+		m_detectionPublishedRegions = 0;
+
+		// Detection uses first channel only
+		juce::AudioBuffer<float> source(1, m_bufferSource.getNumSamples());
+		source.copyFrom(0, 0, m_bufferSource, 0, 0, m_bufferSource.getNumSamples());
+
+		m_regionDetectionJob.start(std::move(source), settings);
 
-		if (isFilterType)
+		m_waveformDisplaySource.clearRegions();
+		m_detectRegionsButton.setButtonText("Cancel");
+		startTimer(DETECTION_TIMER_INTERVAL_MS);
+	}
+
+	//==========================================================================
+	void cancelRegionDetection()
+	{
+		if (m_regionDetectionJob.getState() != RegionDetectionJob::State::Idle)
 		{
-			const float lowPassSamples = (float)m_lowPassFrequencySlider.getValue();
-			const float lowPassFrequency = (float)m_sampleRate / lowPassSamples;
-			const float highPassFrequency = 10.0f;
+			m_regionDetectionJob.stopThread(RegionDetectionJob::STOP_TIMEOUT_MS);
+			m_regionDetectionJob.takeResult();
+		}
 
-			// Copy source buffer for filtering
-			juce::AudioBuffer<float> tempBuffer;
-			tempBuffer.makeCopyOf(m_bufferSource, true);
+		stopTimer();
+		m_detectRegionsButton.setButtonText("Detect");
+	}
 
-			// Apply zero-phase band-pass filtering
-			ZeroPhaseFilter zeroPhaseFilter(m_sampleRate);
-			zeroPhaseFilter.applyBandPassZeroPhase(tempBuffer, highPassFrequency, lowPassFrequency, 2.0f);
+	//==========================================================================
+	void timerCallback() override
+	{
+		const auto state = m_regionDetectionJob.getState();
 
-			filteredBuffer.makeCopyOf(tempBuffer, true);
-			bufferForProcessing.makeCopyOf(filteredBuffer, true);
+		if (state == RegionDetectionJob::State::Running)
+		{
+			m_detectRegionsButton.setButtonText("Cancel " + juce::String(juce::roundToInt(100.0f * m_regionDetectionJob.getProgress())) + "%");
+			publishDetectedRegions();
+		}
+		else if (state == RegionDetectionJob::State::Finished)
+		{
+			stopTimer();
+			m_detectRegionsButton.setButtonText("Detect");
+			applyDetectionResult(m_regionDetectionJob.takeResult());
 		}
 		else
 		{
-			// Use original buffer for processing
-			bufferForProcessing.makeCopyOf(m_bufferSource, true);
+			// Cancelled, restore regions from the last finished detection
+			cancelRegionDetection();
+			m_waveformDisplaySource.clearRegions();
+			m_waveformDisplaySource.setRegions(m_regions);
+			m_regionsCountLabel.setText("Regions count: " + juce::String((float)m_regions.size(), 0), juce::dontSendNotification);
 		}
+	}
 
-		std::vector<int> zeroCrossingIdxs;
-		zeroCrossing.process(bufferForProcessing, zeroCrossingIdxs);
+	//==========================================================================
+	// Appends regions whose end crossing is already known to the waveform display
+	void publishDetectedRegions()
+	{
+		m_regionDetectionJob.popCrossings(m_detectionCrossings);
+
+		const int crossingsCount = (int)m_detectionCrossings.size();
+		const int groupCount = m_detectionGroupCount;
 
-		// For FFT + Filter mode, retrieve the filtered buffer from the detector
-		if (detectionTypeId == static_cast<int>(DetectionType::AmplitudeAdaptiveFilter))
+		std::vector<Region> newRegions;
+		for (int start = m_detectionPublishedRegions * groupCount; start + groupCount < crossingsCount; start += groupCount)
 		{
-			const std::vector<float>& filteredData = zeroCrossing.getLastFilteredBuffer();
-			if (!filteredData.empty())
-			{
-				filteredBuffer.setSize(1, (int)filteredData.size(), false, true);
-				float* outputPtr = filteredBuffer.getWritePointer(0);
-				std::copy(filteredData.begin(), filteredData.end(), outputPtr);
-			}
+			Region& region = newRegions.emplace_back();
+			region.m_sampleIndex = m_detectionCrossings[start];
+			region.m_length = m_detectionCrossings[start + groupCount] - m_detectionCrossings[start];
+			region.m_isValid = true;
+
+			m_detectionPublishedRegions++;
 		}
 
+		if (!newRegions.empty())
+		{
+			m_waveformDisplaySource.appendRegions(newRegions);
+			m_regionsCountLabel.setText("Regions count: " + juce::String((float)m_detectionPublishedRegions, 0), juce::dontSendNotification);
+		}
+	}
+
+	//==========================================================================
+	void applyDetectionResult(RegionDetectionJob::Result result)
+	{
+		const int detectionTypeId = m_detectionTypeId;
+		const std::vector<int>& zeroCrossingIdxs = result.crossings;
+		juce::AudioBuffer<float>& filteredBuffer = result.filteredBuffer;
+
 		const size_t size = zeroCrossingIdxs.size();
 
 		// Get zero crossing grouping value
-		const int zcGroupCount = static_cast<int>(m_zeroCrossingCountSlider.getValue());
+		const int zcGroupCount = m_detectionGroupCount;
 
 		// Create regions
 		m_regions.clear();
@@ -1478,13 +1461,9 @@ public:
 		m_waveformDisplaySource.setFilteredAudioBuffer(filteredBuffer, shouldDisplayFiltered);
 
 		// Pass phase audio buffer for FFT mode visualization
-		if (detectionTypeId == static_cast<int>(DetectionType::FFT))
+		if (detectionTypeId == static_cast<int>(DetectionType::FFT) && result.phaseBuffer.getNumSamples() > 0)
 		{
-			const juce::AudioBuffer<float>& phaseBuffer = zeroCrossing.getLastPhaseAudioBuffer();
-			if (phaseBuffer.getNumSamples() > 0)
-			{
-				m_waveformDisplaySource.setPhaseTrajectory(phaseBuffer);
-			}
+			m_waveformDisplaySource.setPhaseTrajectory(result.phaseBuffer);
 		}
 
 		if (const size_t size = m_regions.size(); size > 1)
@@ -1825,6 +1804,13 @@ public:
 	WaveformEditorComponent m_waveformDisplaySource;
 	WaveformEditorComponent m_waveformDisplayOutput;
 
+	// Background region detection
+	RegionDetectionJob m_regionDetectionJob;
+	std::vector<int> m_detectionCrossings;			// Crossings received so far
+	int m_detectionPublishedRegions = 0;
+	int m_detectionGroupCount = 1;
+	int m_detectionTypeId = 1;
+
 	std::unique_ptr<SpectrumMatchRegionProcessor> m_spectrumRegionProcessor;
 	bool m_useSpectrumMatching = false;
 	bool m_useMedianSpectrum = false;
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "../../../zazzVSTPlugins/Shared/Utilities/ZeroCrossingOffline.h"
+#include "ZeroPhaseFilter.h"
+
+//==============================================================================
+/**
+ * Runs zero crossing detection on a background thread.
+ *
+ * Message thread starts the job with its own copy of the source and polls it from a timer:
+ * getProgress() for progress, popCrossings() for crossings found since the last call
+ * and getState() to find out when the job finished or was cancelled.
+ * Final filtered and phase buffers are taken with takeResult() once finished.
+ */
+class RegionDetectionJob : public juce::Thread
+{
+public:
+	enum class State
+	{
+		Idle,
+		Running,
+		Finished,
+		Cancelled
+	};
+
+	struct Settings
+	{
+		ZeroCrossingOffline::Type type = ZeroCrossingOffline::Type::Amplitude;
+		int sampleRate = 48000;
+		float threshold = 0.0f;
+		float minimumSamplesBetweenCrossings = 240.0f;
+		float minimumLengthMultiplier = 1.0f;
+		float fftPhaseThreshold = 0.0f;
+		int threadsCount = 0;							// FFT detection threads, 0 uses all cores
+
+		// Zero-phase band-pass applied before detection
+		bool applyBandPass = false;
+		float highPassFrequency = 10.0f;
+		float lowPassFrequency = 1000.0f;
+	};
+
+	struct Result
+	{
+		std::vector<int> crossings;
+		juce::AudioBuffer<float> filteredBuffer;
+		juce::AudioBuffer<float> phaseBuffer;
+	};
+
+	RegionDetectionJob() : juce::Thread("Region detection") {}
+	~RegionDetectionJob() override
+	{
+		stopThread(STOP_TIMEOUT_MS);
+	}
+
+	static const int STOP_TIMEOUT_MS = 5000;
+
+	//==========================================================================
+	// Message thread. Source is moved in, detection uses channel 0 only.
+	void start(juce::AudioBuffer<float>&& source, const Settings& settings)
+	{
+		stopThread(STOP_TIMEOUT_MS);
+
+		m_source = std::move(source);
+		m_settings = settings;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pendingCrossings.clear();
+			m_result = Result();
+		}
+
+		m_publishedCount = 0;
+		m_progress.store(0.0f);
+		m_state.store(State::Running);
+
+		startThread();
+	}
+
+	// Message thread. Does not block, state turns Cancelled once detection loop notices.
+	void cancel()
+	{
+		signalThreadShouldExit();
+	}
+
+	State getState() const
+	{
+		return m_state.load();
+	}
+
+	float getProgress() const
+	{
+		return m_progress.load();
+	}
+
+	// Appends crossings found since the last call
+	void popCrossings(std::vector<int>& crossings)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		crossings.insert(crossings.end(), m_pendingCrossings.begin(), m_pendingCrossings.end());
+		m_pendingCrossings.clear();
+	}
+
+	// Valid once state is Finished, resets state to Idle
+	Result takeResult()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_state.store(State::Idle);
+		return std::move(m_result);
+	}
+
+	//==========================================================================
+	void run() override
+	{
+		Result result;
+
+		// Filtering has no progress reporting, count it as first 20 %
+		const float detectionProgressStart = m_settings.applyBandPass ? 0.2f : 0.0f;
+
+		if (m_settings.applyBandPass)
+		{
+			ZeroPhaseFilter zeroPhaseFilter(m_settings.sampleRate);
+			zeroPhaseFilter.applyBandPassZeroPhase(m_source, m_settings.highPassFrequency, m_settings.lowPassFrequency, 2.0f);
+
+			result.filteredBuffer.makeCopyOf(m_source, true);
+			m_progress.store(detectionProgressStart);
+		}
+
+		if (threadShouldExit())
+		{
+			m_state.store(State::Cancelled);
+			return;
+		}
+
+		ZeroCrossingOffline zeroCrossing{};
+		zeroCrossing.init(m_settings.sampleRate);
+		zeroCrossing.setAmplitudeThreshold(m_settings.threshold);
+		zeroCrossing.setMinimumSamplesBetweenCrossings(m_settings.minimumSamplesBetweenCrossings);
+		zeroCrossing.setType(m_settings.type);
+		zeroCrossing.setFFTPhaseThreshold(m_settings.fftPhaseThreshold);
+		zeroCrossing.setMinimumLengthMultiplier(m_settings.minimumLengthMultiplier);
+		zeroCrossing.setThreadsCount(m_settings.threadsCount);
+
+		zeroCrossing.setProgressCallback([this, detectionProgressStart](const float progress, const std::vector<int>& crossings)
+		{
+			m_progress.store(detectionProgressStart + (1.0f - detectionProgressStart) * progress);
+			publishCrossings(crossings);
+
+			return !threadShouldExit();
+		});
+
+		zeroCrossing.process(m_source, result.crossings);
+
+		if (zeroCrossing.wasCancelled() || threadShouldExit())
+		{
+			m_state.store(State::Cancelled);
+			return;
+		}
+
+		if (m_settings.type == ZeroCrossingOffline::Type::AmplitudeAdaptiveFilter)
+		{
+			const std::vector<float>& filteredData = zeroCrossing.getLastFilteredBuffer();
+			if (!filteredData.empty())
+			{
+				result.filteredBuffer.setSize(1, (int)filteredData.size(), false, true);
+				std::copy(filteredData.begin(), filteredData.end(), result.filteredBuffer.getWritePointer(0));
+			}
+		}
+		else if (m_settings.type == ZeroCrossingOffline::Type::FFT)
+		{
+			result.phaseBuffer.makeCopyOf(zeroCrossing.getLastPhaseAudioBuffer(), true);
+		}
+
+		publishCrossings(result.crossings);
+
+		// Source copy is not needed anymore, free it before the result is picked up
+		m_source.setSize(0, 0);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_result = std::move(result);
+		}
+
+		m_progress.store(1.0f);
+		m_state.store(State::Finished);
+	}
+
+private:
+	// Detection only appends, so crossings past m_publishedCount are new
+	void publishCrossings(const std::vector<int>& crossings)
+	{
+		if (crossings.size() <= m_publishedCount)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pendingCrossings.insert(m_pendingCrossings.end(), crossings.begin() + m_publishedCount, crossings.end());
+		m_publishedCount = crossings.size();
+	}
+
+	juce::AudioBuffer<float> m_source;
+	Settings m_settings;
+
+	std::mutex m_mutex;
+	std::vector<int> m_pendingCrossings;
+	Result m_result;
+
+	size_t m_publishedCount = 0;						// Worker thread only
+	std::atomic<float> m_progress{ 0.0f };
+	std::atomic<State> m_state{ State::Idle };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RegionDetectionJob)
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <vector>
+#include <cmath>
+
+//==============================================================================
+/**
+ * Resamples source regions to export length.
+ *
+ * Read positions and interpolation weights of a region are calculated once
+ * and applied to every channel. Buffers are allocated in prepare() only,
+ * setRegion(), setSegment() and process() do not allocate.
+ * Each sample is sourceData[left] * leftGain + sourceData[right] * rightGain,
+ * samples outside of the source have zero gain.
+ */
+class RegionResampler
+{
+public:
+	RegionResampler() = default;
+	~RegionResampler() = default;
+
+	void prepare(const int maxLength)
+	{
+		m_indexLeft.resize(maxLength);
+		m_indexRight.resize(maxLength);
+		m_gainLeft.resize(maxLength);
+		m_gainRight.resize(maxLength);
+	}
+
+	//==========================================================================
+	/**
+	 * Region used by flat generation and region export.
+	 * Reads sourceLength samples from startIndex, right neighbour is clamped to the last source sample.
+	 */
+	void setRegion(const int startIndex, const int sourceLength, const int exportLength, const int sourceSize, const bool linearInterpolation)
+	{
+		jassert(exportLength <= (int)m_indexLeft.size());
+
+		m_length = exportLength;
+		const float indexIncrement = (float)sourceLength / (float)exportLength;
+		float sourceIndex = 0.0f;
+
+		for (int i = 0; i < exportLength; i++)
+		{
+			const int indexLeft = startIndex + (int)sourceIndex;
+
+			if (linearInterpolation)
+			{
+				const float delta = sourceIndex - std::floor(sourceIndex);
+
+				m_indexLeft[i] = indexLeft;
+				m_indexRight[i] = indexLeft < sourceSize - 1 ? indexLeft + 1 : indexLeft;
+				m_gainLeft[i] = 1.0f - delta;
+				m_gainRight[i] = delta;
+			}
+			else
+			{
+				m_indexLeft[i] = indexLeft;
+				m_indexRight[i] = indexLeft;
+				m_gainLeft[i] = 1.0f;
+				m_gainRight[i] = 0.0f;
+			}
+
+			sourceIndex += indexIncrement;
+		}
+	}
+
+	/**
+	 * Segment used by random generation, may start before and end after the source.
+	 * Reads length samples from readIndex with indexIncrement step.
+	 */
+	void setSegment(float readIndex, const float indexIncrement, const int length, const int sourceSize, const bool linearInterpolation)
+	{
+		jassert(length <= (int)m_indexLeft.size());
+
+		m_length = length;
+
+		for (int i = 0; i < length; i++)
+		{
+			if (linearInterpolation)
+			{
+				const int indexLeft = (int)readIndex;
+				const int indexRight = indexLeft + 1;
+				const float delta = readIndex - std::floor(readIndex);
+
+				setTap(i, indexLeft, 1.0f - delta, indexRight, delta, sourceSize);
+			}
+			else
+			{
+				const bool isInside = readIndex >= 0 && readIndex < sourceSize;
+				setTap(i, isInside ? (int)readIndex : 0, isInside ? 1.0f : 0.0f, 0, 0.0f, sourceSize);
+			}
+
+			readIndex += indexIncrement;
+		}
+	}
+
+	//==========================================================================
+	void process(const float* sourceData, float* output) const
+	{
+		const int* indexLeft = m_indexLeft.data();
+		const int* indexRight = m_indexRight.data();
+		const float* gainLeft = m_gainLeft.data();
+		const float* gainRight = m_gainRight.data();
+
+		for (int i = 0; i < m_length; i++)
+		{
+			output[i] = sourceData[indexLeft[i]] * gainLeft[i] + sourceData[indexRight[i]] * gainRight[i];
+		}
+	}
+
+	int getLength() const
+	{
+		return m_length;
+	}
+
+private:
+	void setTap(const int i, const int indexLeft, const float gainLeft, const int indexRight, const float gainRight, const int sourceSize)
+	{
+		const bool isLeftInside = indexLeft >= 0 && indexLeft < sourceSize;
+		const bool isRightInside = indexRight >= 0 && indexRight < sourceSize;
+
+		m_indexLeft[i] = isLeftInside ? indexLeft : 0;
+		m_indexRight[i] = isRightInside ? indexRight : 0;
+		m_gainLeft[i] = isLeftInside ? gainLeft : 0.0f;
+		m_gainRight[i] = isRightInside ? gainRight : 0.0f;
+	}
+
+	std::vector<int> m_indexLeft;
+	std::vector<int> m_indexRight;
+	std::vector<float> m_gainLeft;
+	std::vector<float> m_gainRight;
+	int m_length = 0;
+};
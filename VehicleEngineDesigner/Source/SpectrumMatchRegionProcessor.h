@@ -5,6 +5,7 @@
 #include <cmath>
 #include <cstring>
 #include <algorithm>
+#include <memory>
 
 #include <JuceHeader.h>
 
@@ -16,10 +17,26 @@
  * - Applies spectrum adjustment to regions without windowing (assumes looped regions)
  * - Resamples regions to/from FFT size for processing
  * - Supports region export and output buffer generation
+ * - Batch adjustment of many regions, optionally on multiple threads
  */
 class SpectrumMatchRegionProcessor
 {
 public:
+	/**
+	 * Region for batch spectrum adjustment.
+	 * Input and output can be the same buffer.
+	 */
+	struct RegionJob
+	{
+		const float* input = nullptr;
+		float* output = nullptr;
+		int size = 0;
+		int dcOffsetStartIdx = -1;
+		int dcOffsetEndIdx = -1;
+	};
+
+	static const int MIN_REGIONS_PER_THREAD = 16;
+
 	/** fftSize must be a power of two */
 	explicit SpectrumMatchRegionProcessor(int fftSizeInSamples)
 		: fftSize(fftSizeInSamples),
@@ -207,39 +224,47 @@ public:
 		jassert(outputRegion != nullptr);
 		jassert(inputSize > 0);
 
-		// Resample input to FFT size
-		std::vector<float> resampledInput(fftSize);
-		resampleToFFTSize(inputRegion, inputSize, resampledInput.data());
-
-		// Copy to FFT buffer (no windowing - assume looped region)
-		std::copy(resampledInput.begin(), resampledInput.end(), fftData.begin());
-
-		// Perform FFT
-		fft.performRealOnlyForwardTransform(fftData.data(), true);
+		adjustRegion(inputRegion, inputSize, outputRegion, intensity, dcOffsetStartIdx, dcOffsetEndIdx, fft, fftData.data());
+	}
 
-		// Apply spectrum adjustment with intensity scaling
-		applySpectrumGain(fftData.data(), intensity);
+	/**
+	 * Apply spectrum adjustment to many regions
+	 * Each thread has its own FFT and FFT work buffer and reuses them for all its regions.
+	 * Result is the same as calling applySpectrumAdjustment() for each region.
+	 *
+	 * @param regions Regions to adjust, must not overlap each other
+	 * @param intensity Spectrum matching intensity (0.0 = no adjustment, 1.0 = full ±24dB adjustment)
+	 * @param threadsCount Number of threads, 0 uses all cores
+	 */
+	void applySpectrumAdjustment(const std::vector<RegionJob>& regions, float intensity = 1.0f, int threadsCount = 1)
+	{
+		const int regionsCount = static_cast<int>(regions.size());
+		const int rangesCount = zazzDSP::Parallel::getRangesCount(regionsCount, threadsCount, MIN_REGIONS_PER_THREAD);
 
-		// Perform inverse FFT
-		fft.performRealOnlyInverseTransform(fftData.data());
+		// Range 0 uses member FFT and buffer, other ranges get their own.
+		// FFT engines without a thread safe plan (JUCE fallback) lock while performing, so a shared FFT would serialize ranges.
+		m_workBuffers.resize(rangesCount - 1);
+		for (auto& workBuffer : m_workBuffers)
+		{
+			workBuffer.resize(fftSize * 2);
+		}
 
-		// Resample back to original size
-		resampleFromFFTSize(fftData.data(), outputRegion, inputSize);
+		while (static_cast<int>(m_workFFTs.size()) < rangesCount - 1)
+		{
+			m_workFFTs.push_back(std::make_unique<juce::dsp::FFT>(fftOrder));
+		}
 
-		// DC offset compensation to ensure smooth looping
-		// Calculate average of first and last samples and subtract it to make their sum close to zero
-		if (inputSize > 1)
+		zazzDSP::Parallel::forRanges(regionsCount, threadsCount, MIN_REGIONS_PER_THREAD, [&](const int range, const int first, const int last)
 		{
-			// Use specified indices if provided, otherwise use full range
-			int startIdx = (dcOffsetStartIdx >= 0) ? dcOffsetStartIdx : 0;
-			int endIdx = (dcOffsetEndIdx >= 0) ? dcOffsetEndIdx : (inputSize - 1);
+			const juce::dsp::FFT& rangeFFT = range == 0 ? fft : *m_workFFTs[range - 1];
+			float* workBuffer = range == 0 ? fftData.data() : m_workBuffers[range - 1].data();
 
-			float dcOffset = (outputRegion[startIdx] + outputRegion[endIdx]) / 2.0f;
-			for (int i = 0; i < inputSize; ++i)
+			for (int i = first; i < last; ++i)
 			{
-				outputRegion[i] -= dcOffset;
+				const RegionJob& region = regions[i];
+				adjustRegion(region.input, region.size, region.output, intensity, region.dcOffsetStartIdx, region.dcOffsetEndIdx, rangeFFT, workBuffer);
 			}
-		}
+		});
 	}
 
 	/**
@@ -294,6 +319,45 @@ public:
 	}
 
 private:
+	/**
+	 * Resamples region to FFT size, applies spectrum gain, resamples back and removes DC offset
+	 * Input is fully read before output is written, so they can be the same buffer
+	 * @param regionFFT FFT of fftSize, not used by other threads at the same time
+	 * @param workBuffer FFT work buffer of fftSize * 2 samples
+	 */
+	void adjustRegion(const float* inputRegion, int inputSize, float* outputRegion, float intensity, int dcOffsetStartIdx, int dcOffsetEndIdx, const juce::dsp::FFT& regionFFT, float* workBuffer) const
+	{
+		// Resample input to FFT size (no windowing - assume looped region)
+		resampleToFFTSize(inputRegion, inputSize, workBuffer);
+
+		// Perform FFT
+		regionFFT.performRealOnlyForwardTransform(workBuffer, true);
+
+		// Apply spectrum adjustment with intensity scaling
+		applySpectrumGain(workBuffer, intensity);
+
+		// Perform inverse FFT
+		regionFFT.performRealOnlyInverseTransform(workBuffer);
+
+		// Resample back to original size
+		resampleFromFFTSize(workBuffer, outputRegion, inputSize);
+
+		// DC offset compensation to ensure smooth looping
+		// Calculate average of first and last samples and subtract it to make their sum close to zero
+		if (inputSize > 1)
+		{
+			// Use specified indices if provided, otherwise use full range
+			int startIdx = (dcOffsetStartIdx >= 0) ? dcOffsetStartIdx : 0;
+			int endIdx = (dcOffsetEndIdx >= 0) ? dcOffsetEndIdx : (inputSize - 1);
+
+			float dcOffset = (outputRegion[startIdx] + outputRegion[endIdx]) / 2.0f;
+			for (int i = 0; i < inputSize; ++i)
+			{
+				outputRegion[i] -= dcOffset;
+			}
+		}
+	}
+
 	/**
 	 * Process a single region to extract its spectrum magnitude
 	 */
@@ -321,7 +385,7 @@ private:
 	 * Scales each frequency bin by the ratio of average spectrum to current spectrum,
 	 * with the adjustment amount controlled by intensity (0.0 = no adjustment, 1.0 = full adjustment)
 	 */
-	void applySpectrumGain(float* fftData, float intensity = 1.0f)
+	void applySpectrumGain(float* fftData, float intensity = 1.0f) const
 	{
 		auto* cdata = reinterpret_cast<std::complex<float>*>(fftData);
 
@@ -329,7 +393,6 @@ private:
 		for (int i = 0; i < numBins; ++i)
 		{
 			float magnitude = std::abs(cdata[i]);
-			float phase = std::arg(cdata[i]);
 
 			// Calculate the gain for this bin: ratio of average spectrum to current magnitude
 			// This adjusts the spectrum to match the average while preserving relative amplitudes
@@ -350,15 +413,15 @@ private:
 				gain = 1.0f + (targetGain - 1.0f) * intensity;
 			}
 
-			// Apply gain while preserving phase
-			cdata[i] = std::polar(magnitude * gain, phase);
+			// Apply gain while preserving phase, real gain scales magnitude only
+			cdata[i] *= gain;
 		}
 	}
 
 	/**
 	 * Linear interpolation-based resampling to FFT size
 	 */
-	void resampleToFFTSize(const float* input, int inputSize, float* output)
+	void resampleToFFTSize(const float* input, int inputSize, float* output) const
 	{
 		if (inputSize == fftSize)
 		{
@@ -386,7 +449,7 @@ private:
 	/**
 	 * Linear interpolation-based resampling from FFT size back to original size
 	 */
-	void resampleFromFFTSize(const float* input, float* output, int outputSize)
+	void resampleFromFFTSize(const float* input, float* output, int outputSize) const
 	{
 		if (outputSize == fftSize)
 		{
@@ -422,6 +485,8 @@ private:
 	std::vector<float> m_averageSpectrum;
 	std::vector<float> m_spectrumGain;
 	std::vector<float> m_tempSpectrum;
+	std::vector<std::vector<float>> m_workBuffers;
+	std::vector<std::unique_ptr<juce::dsp::FFT>> m_workFFTs;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumMatchRegionProcessor)
 };
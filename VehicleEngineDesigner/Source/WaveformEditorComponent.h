@@ -329,6 +329,35 @@ public:
 
 		repaint();
 	}
+	// Used while regions detection is running
+	void appendRegions(const std::vector<Region>& regions)
+	{
+		if (regions.empty())
+		{
+			return;
+		}
+
+		m_regions.insert(m_regions.end(), regions.begin(), regions.end());
+
+		m_leftRegionIndex = 0;
+		m_rightRegionIndex = (int)(m_regions.size() - 1);
+
+		m_zoomRegionLeftLabel.setText("0", juce::dontSendNotification);
+		m_zoomRegionRightLabel.setText(juce::String((float)m_rightRegionIndex, 0), juce::dontSendNotification);
+
+		repaint();
+	}
+	void clearRegions()
+	{
+		m_leftRegionIndex = -1;
+		m_rightRegionIndex = -1;
+
+		m_zoomRegionLeftLabel.setText("-1", juce::dontSendNotification);
+		m_zoomRegionRightLabel.setText("-1", juce::dontSendNotification);
+
+		m_regions.clear();
+		repaint();
+	}
 	void setVerticalZoom(const float verticalZoom)
 	{
 		m_waveformDisplayComponent.setVerticalZoom(verticalZoom);
@@ -94,13 +94,7 @@ public:
 		// Forward pass
 		for (int channel = 0; channel < numChannels; ++channel)
 		{
-			auto* data = buffer.getWritePointer(channel);
-			for (int i = 0; i < numSamples; ++i)
-			{
-				float sample = data[i];
-				sample = filter.processDF1(sample);
-				data[i] = sample;
-			}
+			filter.processBlockDF1(buffer.getWritePointer(channel), numSamples);
 			filter.reset();
 		}
 
@@ -114,13 +108,7 @@ public:
 		// Backward pass
 		for (int channel = 0; channel < numChannels; ++channel)
 		{
-			auto* data = buffer.getWritePointer(channel);
-			for (int i = 0; i < numSamples; ++i)
-			{
-				float sample = data[i];
-				sample = filter.processDF1(sample);
-				data[i] = sample;
-			}
+			filter.processBlockDF1(buffer.getWritePointer(channel), numSamples);
 			filter.reset();
 		}
 
@@ -22,6 +22,7 @@
 
 const std::string VelvetNoiseReverbAudioProcessor::paramsNames[] = { "Predelay", "Decay", "Shape", "Density", "Low", "High", "Width", "Mix", "Volume" };
 const std::string VelvetNoiseReverbAudioProcessor::paramsUnitNames[] = { " ms", " s", "", " %", " %", " %", " %", " %", " dB" };
+const long VelvetNoiseReverbAudioProcessor::SEEDS[] = { 79L, 99L };
 
 //==============================================================================
 VelvetNoiseReverbAudioProcessor::VelvetNoiseReverbAudioProcessor()
@@ -36,15 +37,8 @@ VelvetNoiseReverbAudioProcessor::VelvetNoiseReverbAudioProcessor()
                        )
 #endif
 {
-	preDelayTimeParameter	= apvts.getRawParameterValue(paramsNames[0]);
-	reverbTimeParameter		= apvts.getRawParameterValue(paramsNames[1]);
-	decayShapeParameter		= apvts.getRawParameterValue(paramsNames[2]);
-	densityParameter		= apvts.getRawParameterValue(paramsNames[3]);
-	lowParameter			= apvts.getRawParameterValue(paramsNames[4]);
-	highParameter			= apvts.getRawParameterValue(paramsNames[5]);
-	widthParameter			= apvts.getRawParameterValue(paramsNames[6]);
-	mixParameter			= apvts.getRawParameterValue(paramsNames[7]);
-	volumeParameter			= apvts.getRawParameterValue(paramsNames[8]);
+	m_parameters.init(apvts, paramsNames);
+	m_tapBuilder.init(apvts);
 }
 
 VelvetNoiseReverbAudioProcessor::~VelvetNoiseReverbAudioProcessor()
@@ -118,14 +112,21 @@ void VelvetNoiseReverbAudioProcessor::prepareToPlay (double sampleRate, int samp
 {
 	const int sr = (int)sampleRate;
 
-	const float lengthSeconds = 2.0f + 0.1f;
+	m_tapBuilder.stopThread(1000);
 
-	m_reverb[0].init(sr, lengthSeconds);
-	m_reverb[1].init(sr, lengthSeconds);
+	m_reverb[0].init(sr, LENGTH_SECONDS);
+	m_reverb[1].init(sr, LENGTH_SECONDS);
+
+	m_tapBuilder.prepare(sr);
+	m_tapBuilder.startThread();
+
+	m_parameters.invalidate();
 }
 
 void VelvetNoiseReverbAudioProcessor::releaseResources()
 {
+	m_tapBuilder.stopThread(1000);
+
 	m_reverb[0].release();
 	m_reverb[1].release();
 }
@@ -162,23 +163,18 @@ void VelvetNoiseReverbAudioProcessor::processBlock (juce::AudioBuffer<float>& bu
 	juce::ScopedNoDenormals noDenormals;
 	
 	// Get params
-	const auto preDelayTime = 0.001f * preDelayTimeParameter->load();
-	const auto reverbTime = reverbTimeParameter->load();
-	const auto decayShape = decayShapeParameter->load();
-	const auto density = 0.01f * densityParameter->load();
-	const auto low = 0.01f * lowParameter->load();
-	const auto high = 0.01f * highParameter->load();
-	const auto mix = 0.01f * mixParameter->load();
-	const auto gain = juce::Decibels::decibelsToGain(volumeParameter->load());
+	updateParameters();
+
+	const auto density = 0.01f * m_parameters.get(Parameters::Density);
+	const auto mix = 0.01f * m_parameters.get(Parameters::Mix);
+	const auto gain = juce::Decibels::decibelsToGain(m_parameters.get(Parameters::Volume));
 
 	// Mics constants
 	const auto channels = getTotalNumOutputChannels();
 	const auto samples = buffer.getNumSamples();
 	const auto reverbGainCompensation = juce::Decibels::decibelsToGain(-32.0f + (1.0f - density) * 9.0f);
 
-	//TEMP
-	m_reverb[0].set(reverbTime, preDelayTime, decayShape, density, 79L, low, high);
-	m_reverb[1].set(reverbTime, preDelayTime, decayShape, density, 99L, low, high);
+	constexpr int blockSize = VelvetNoiseReverb::BLOCK_SIZE;
 
 	if (channels == 1)
 	{
@@ -186,15 +182,23 @@ void VelvetNoiseReverbAudioProcessor::processBlock (juce::AudioBuffer<float>& bu
 		auto* channelBuffer = buffer.getWritePointer(0);
 		auto& reverb = m_reverb[0];
 
-		for (int sample = 0; sample < samples; sample++)
+		float out[blockSize];
+
+		for (int start = 0; start < samples; start += blockSize)
 		{
-			// Read
-			const float in = channelBuffer[sample];
+			const int count = std::min(blockSize, samples - start);
+			float* block = channelBuffer + start;
 
-			const float out = reverbGainCompensation * reverb.process(in);
+			reverb.process(block, out, count);
 
-			//Out
-			channelBuffer[sample] = (1.0f - mix) * in + mix * out;
+			for (int sample = 0; sample < count; sample++)
+			{
+				// Read
+				const float in = block[sample];
+
+				//Out
+				block[sample] = (1.0f - mix) * in + mix * reverbGainCompensation * out[sample];
+			}
 		}
 	}
 	else if (channels == 2)
@@ -207,30 +211,43 @@ void VelvetNoiseReverbAudioProcessor::processBlock (juce::AudioBuffer<float>& bu
 		auto& rightReverb = m_reverb[1];
 
 		// MidSide gain
-		const auto width = 0.01f * widthParameter->load();
+		const auto width = 0.01f * m_parameters.get(Parameters::Width);
 		const float midGain = 2.0f - width;
 		const float sideGain = width;
 
-		for (int sample = 0; sample < samples; sample++)
+		float outLeftBlock[blockSize];
+		float outRightBlock[blockSize];
+
+		for (int start = 0; start < samples; start += blockSize)
 		{
-			// Read
-			const float inLeft = leftChannelBuffer[sample];
-			const float inRight = rightChannelBuffer[sample];
+			const int count = std::min(blockSize, samples - start);
+			float* leftBlock = leftChannelBuffer + start;
+			float* rightBlock = rightChannelBuffer + start;
 
 			// Process reverb
-			float outLeft = reverbGainCompensation * leftReverb.process(inLeft);
-			float outRight = reverbGainCompensation * rightReverb.process(inRight);
+			leftReverb.process(leftBlock, outLeftBlock, count);
+			rightReverb.process(rightBlock, outRightBlock, count);
+
+			for (int sample = 0; sample < count; sample++)
+			{
+				// Read
+				const float inLeft = leftBlock[sample];
+				const float inRight = rightBlock[sample];
+
+				float outLeft = reverbGainCompensation * outLeftBlock[sample];
+				float outRight = reverbGainCompensation * outRightBlock[sample];
 
-			// Handle MS
-			const float mid = midGain * (outLeft + outRight);
-			const float side = sideGain * (outLeft - outRight);
+				// Handle MS
+				const float mid = midGain * (outLeft + outRight);
+				const float side = sideGain * (outLeft - outRight);
 
-			outLeft = mid + side;
-			outRight = mid - side;
+				outLeft = mid + side;
+				outRight = mid - side;
 
-			//Out
-			leftChannelBuffer[sample] = (1.0f - mix) * inLeft + mix * outLeft;
-			rightChannelBuffer[sample] = (1.0f - mix) * inRight + mix * outRight;
+				//Out
+				leftBlock[sample] = (1.0f - mix) * inLeft + mix * outLeft;
+				rightBlock[sample] = (1.0f - mix) * inRight + mix * outRight;
+			}
 		}
 	}
 
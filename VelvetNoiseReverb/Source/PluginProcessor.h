@@ -22,6 +22,8 @@
 #include <JuceHeader.h>
 
 #include "../../../zazzVSTPlugins/Shared/Reverbs/VelvetNoiseReverb.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/ParameterSnapshot.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/TripleBuffer.h"
 
 //==============================================================================
 class VelvetNoiseReverbAudioProcessor  : public juce::AudioProcessor
@@ -35,9 +37,25 @@ public:
     VelvetNoiseReverbAudioProcessor();
     ~VelvetNoiseReverbAudioProcessor() override;
 
+	enum Parameters
+	{
+		Predelay,
+		Decay,
+		Shape,
+		Density,
+		Low,
+		High,
+		Width,
+		Mix,
+		Volume,
+		COUNT
+	};
+
 	static const std::string paramsNames[];
 	static const std::string paramsUnitNames[];
     static const int N_CHANNELS = 2;
+	static const long SEEDS[N_CHANNELS];
+	static constexpr float LENGTH_SECONDS = 2.0f + 0.1f;
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
@@ -79,17 +97,152 @@ public:
 
 private:	
 	//==============================================================================
-	VelvetNoiseReverb m_reverb[2];
-
-	std::atomic<float>* preDelayTimeParameter = nullptr;
-	std::atomic<float>* reverbTimeParameter = nullptr;
-	std::atomic<float>* decayShapeParameter = nullptr;
-	std::atomic<float>* densityParameter = nullptr;
-	std::atomic<float>* lowParameter = nullptr;
-	std::atomic<float>* highParameter = nullptr;
-	std::atomic<float>* widthParameter = nullptr;
-	std::atomic<float>* mixParameter = nullptr;
-	std::atomic<float>* volumeParameter = nullptr;
+	// Parameters the tap tables depend on, in reverb units
+	struct TapParameters
+	{
+		float reverbTime = 0.0f;
+		float preDelayTime = 0.0f;
+		float decayShape = 0.0f;
+		float density = 0.0f;
+
+		bool operator!=(const TapParameters& other) const noexcept
+		{
+			return reverbTime != other.reverbTime || preDelayTime != other.preDelayTime || decayShape != other.decayShape || density != other.density;
+		}
+	};
+
+	static TapParameters getTapParameters(const float predelay, const float decay, const float shape, const float density) noexcept
+	{
+		TapParameters parameters;
+		parameters.reverbTime = decay;
+		parameters.preDelayTime = 0.001f * predelay;
+		parameters.decayShape = shape;
+		parameters.density = 0.01f * density;
+		return parameters;
+	}
+
+	struct TapTables
+	{
+		VelvetNoiseReverb::Taps taps[N_CHANNELS];
+	};
+
+	static void buildTapTables(TapTables& tables, const int sampleRate, const TapParameters& parameters)
+	{
+		for (int channel = 0; channel < N_CHANNELS; channel++)
+		{
+			VelvetNoiseReverb::generateTaps(tables.taps[channel], sampleRate, parameters.reverbTime, parameters.preDelayTime, parameters.decayShape, parameters.density, SEEDS[channel]);
+		}
+	}
+
+	//==============================================================================
+	// Polls tap parameters and rebuilds tap tables when they change.
+	// Audio thread only picks up the newest published tables.
+	class TapBuilder : public juce::Thread
+	{
+	public:
+		static const int POLL_INTERVAL_MS = 20;
+
+		TapBuilder() : juce::Thread("VelvetNoiseReverb taps") {}
+		~TapBuilder() override
+		{
+			stopThread(1000);
+		}
+
+		void init(APVTS& apvts)
+		{
+			m_predelayParameter	= apvts.getRawParameterValue(paramsNames[Parameters::Predelay]);
+			m_decayParameter	= apvts.getRawParameterValue(paramsNames[Parameters::Decay]);
+			m_shapeParameter	= apvts.getRawParameterValue(paramsNames[Parameters::Shape]);
+			m_densityParameter	= apvts.getRawParameterValue(paramsNames[Parameters::Density]);
+		}
+		// Call while thread is stopped, tables for current parameters are published before it returns
+		void prepare(const int sampleRate)
+		{
+			m_sampleRate = sampleRate;
+			m_built = getParameters();
+
+			buildTapTables(m_tables.getWriteBuffer(), m_sampleRate, m_built);
+			m_tables.publish();
+		}
+		TapParameters getParameters() const noexcept
+		{
+			return getTapParameters(m_predelayParameter->load(), m_decayParameter->load(), m_shapeParameter->load(), m_densityParameter->load());
+		}
+		void run() override
+		{
+			while (!threadShouldExit())
+			{
+				const auto parameters = getParameters();
+
+				if (parameters != m_built)
+				{
+					buildTapTables(m_tables.getWriteBuffer(), m_sampleRate, parameters);
+					m_tables.publish();
+					m_built = parameters;
+				}
+
+				wait(POLL_INTERVAL_MS);
+			}
+		}
+
+		TripleBuffer<TapTables> m_tables;
+
+	private:
+		std::atomic<float>* m_predelayParameter = nullptr;
+		std::atomic<float>* m_decayParameter = nullptr;
+		std::atomic<float>* m_shapeParameter = nullptr;
+		std::atomic<float>* m_densityParameter = nullptr;
+		TapParameters m_built;
+		int m_sampleRate = 48000;
+	};
+
+	//==============================================================================
+	// Filters are cheap and set on audio thread, tap tables come from m_tapBuilder.
+	// Offline rendering can not wait for the builder, so tables are built in place.
+	void updateParameters()
+	{
+		const bool tapsChanged = m_parameters.update() && m_parameters.hasChanged({ Parameters::Predelay, Parameters::Decay, Parameters::Shape, Parameters::Density });
+
+		if (isNonRealtime())
+		{
+			if (tapsChanged)
+			{
+				const auto parameters = getTapParameters(m_parameters.get(Parameters::Predelay), m_parameters.get(Parameters::Decay),
+														 m_parameters.get(Parameters::Shape), m_parameters.get(Parameters::Density));
+				buildTapTables(m_tapTables, (int)getSampleRate(), parameters);
+
+				for (int channel = 0; channel < N_CHANNELS; channel++)
+				{
+					m_reverb[channel].setTaps(m_tapTables.taps[channel]);
+				}
+			}
+		}
+		else if (m_tapBuilder.m_tables.update())
+		{
+			const auto& tables = m_tapBuilder.m_tables.getReadBuffer();
+
+			for (int channel = 0; channel < N_CHANNELS; channel++)
+			{
+				m_reverb[channel].setTaps(tables.taps[channel]);
+			}
+		}
+
+		if (m_parameters.hasChanged({ Parameters::Low, Parameters::High }))
+		{
+			const float low = 0.01f * m_parameters.get(Parameters::Low);
+			const float high = 0.01f * m_parameters.get(Parameters::High);
+
+			for (int channel = 0; channel < N_CHANNELS; channel++)
+			{
+				m_reverb[channel].setFilters(low, high);
+			}
+		}
+	}
+
+	VelvetNoiseReverb m_reverb[N_CHANNELS];
+	ParameterSnapshot<Parameters::COUNT> m_parameters;
+	TapBuilder m_tapBuilder;
+	TapTables m_tapTables;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VelvetNoiseReverbAudioProcessor)
 };
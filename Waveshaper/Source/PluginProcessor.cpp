@@ -117,7 +117,8 @@ void WaveshaperAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
 	m_postFilter[0].init(sr);
 	m_postFilter[1].init(sr);
 
-	m_oversampling.initProcessing((size_t)samplesPerBlock);
+	m_oversampling[0].init(sr, OVERSAMPLING_MULTIPLIER, samplesPerBlock, Oversampling::Phase::Minimum);
+	m_oversampling[1].init(sr, OVERSAMPLING_MULTIPLIER, samplesPerBlock, Oversampling::Phase::Minimum);
 }
 
 void WaveshaperAudioProcessor::releaseResources()
@@ -163,6 +164,7 @@ void WaveshaperAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
 
 	// Mics constants
 	const auto channels = getTotalNumOutputChannels();
+	const auto samples = buffer.getNumSamples();
 	constexpr float frequency = 440.0f;
 	const auto dry = volume * (1.0f - mix);
 	const auto wet = volume * mix;
@@ -198,50 +200,59 @@ void WaveshaperAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
 		}
 	}
 	
-	// Create AudioBlock
-	juce::dsp::AudioBlock<float> outputBlock(outBuffer);
-
-	// Upsample
-	auto upsampledBlock = m_oversampling.processSamplesUp(outputBlock);
-
 	// Process upsampeled buffer
 	for (int channel = 0; channel < channels; ++channel)
 	{
-		// Channel pointer
-		auto* channelBuffer = upsampledBlock.getChannelPointer(channel);
-		
-		if (type == 1)
-		{
-			const auto drive = 1.0f;
+		auto& oversampling = m_oversampling[channel];
+		auto* outChannel = outBuffer.getWritePointer(channel);
 
-			for (int sample = 0; sample < upsampledBlock.getNumSamples(); sample++)
-			{
-				channelBuffer[sample] = Waveshapers::Tanh(channelBuffer[sample], drive, asymetry);
-			}
-		}
-		else if (type == 2)
+		// Host can send larger block than announced, process in chunks
+		const int maxSamples = oversampling.getMaxSamples();
+
+		for (int start = 0; start < samples; start += maxSamples)
 		{
-			const auto drive = 1.0f;
+			const int chunk = std::min(maxSamples, samples - start);
+
+			// Upsample
+			oversampling.oversample(outChannel + start, chunk);
 
-			for (int sample = 0; sample < upsampledBlock.getNumSamples(); sample++)
+			// Channel pointer
+			auto* channelBuffer = oversampling.getOversampeBuffer();
+			const int oversampleSamples = oversampling.getOversampeBufferSize();
+		
+			if (type == 1)
 			{
-				channelBuffer[sample] = Waveshapers::Reciprocal(channelBuffer[sample], drive, asymetry);
+				const auto drive = 1.0f;
+
+				for (int sample = 0; sample < oversampleSamples; sample++)
+				{
+					channelBuffer[sample] = Waveshapers::Tanh(channelBuffer[sample], drive, asymetry);
+				}
 			}
-		}
-		else if (type == 3)
-		{
-			const auto drive = Math::remap(gain, 0.0f, 18.0f, 1.0f, 8.0f);
+			else if (type == 2)
+			{
+				const auto drive = 1.0f;
 
-			for (int sample = 0; sample < upsampledBlock.getNumSamples(); sample++)
+				for (int sample = 0; sample < oversampleSamples; sample++)
+				{
+					channelBuffer[sample] = Waveshapers::Reciprocal(channelBuffer[sample], drive, asymetry);
+				}
+			}
+			else if (type == 3)
 			{
-				channelBuffer[sample] = Waveshapers::Exponential(channelBuffer[sample], drive, asymetry);
+				const auto drive = Math::remap(gain, 0.0f, 18.0f, 1.0f, 8.0f);
+
+				for (int sample = 0; sample < oversampleSamples; sample++)
+				{
+					channelBuffer[sample] = Waveshapers::Exponential(channelBuffer[sample], drive, asymetry);
+				}
 			}
+
+			//Downsample
+			oversampling.downsample(outChannel + start, chunk);
 		}
 	}
 
-	//Downsample
-	m_oversampling.processSamplesDown(outputBlock);
-
 	// Post filter + Mix
 	for (int channel = 0; channel < channels; ++channel)
 	{
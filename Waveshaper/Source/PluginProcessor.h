@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include "../../../zazzVSTPlugins/Shared/NonLinearFilters/WaveShapers.h"
 #include "../../../zazzVSTPlugins/Shared/Filters/BiquadFilters.h"
+#include "../../../zazzVSTPlugins/Shared/Utilities/Oversampling.h"
 
 //==============================================================================
 class WaveshaperAudioProcessor  : public juce::AudioProcessor
@@ -62,11 +63,7 @@ public:
 
 private:	
 	//==============================================================================
-	juce::dsp::Oversampling<float> m_oversampling{ 2,                      // numChannels
-												   OVERSAMPLING_FACTOR,    // oversampling factor = 2^4 = 16x
-												   juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
-												   false,                  // don't use linear-phase
-												   false };					// don't process by blocks only};
+	Oversampling m_oversampling[2];
 	
 	BiquadFilter m_preFilter[2];
 	BiquadFilter m_postFilter[2];
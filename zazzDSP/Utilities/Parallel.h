@@ -0,0 +1,72 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace zazzDSP
+{
+	/// <summary>
+	/// Helpers for splitting offline analysis across threads.
+	/// Work is split into consecutive ranges that depend only on item count and thread count,
+	/// so results merged in range order are the same for any number of threads.
+	/// Spawns threads per call, not intended for realtime use.
+	/// </summary>
+	class Parallel
+	{
+	public:
+		/// <summary>
+		/// Resolves requested thread count, 0 means all logical cores.
+		/// </summary>
+		static int getThreadsCount(const int threadsCount)
+		{
+			return threadsCount > 0 ? threadsCount : std::max(1, juce::SystemStats::getNumCpus());
+		}
+
+		/// <summary>
+		/// Number of ranges forRanges() will use, every range has at least minRangeSize items.
+		/// </summary>
+		static int getRangesCount(const int count, const int threadsCount, const int minRangeSize = 1)
+		{
+			const int maxRanges = std::max(1, count / std::max(1, minRangeSize));
+			return std::min(getThreadsCount(threadsCount), maxRanges);
+		}
+
+		/// <summary>
+		/// First item of range, range == rangesCount returns count.
+		/// </summary>
+		static int getRangeStart(const int count, const int rangesCount, const int range)
+		{
+			return (int)((long long)count * range / rangesCount);
+		}
+
+		/// <summary>
+		/// Calls function(range, first, last) for each of getRangesCount() ranges of [0, count).
+		/// Range 0 runs on the calling thread, returns when all ranges are done.
+		/// </summary>
+		template <typename Function>
+		static void forRanges(const int count, const int threadsCount, const int minRangeSize, Function&& function)
+		{
+			const int rangesCount = getRangesCount(count, threadsCount, minRangeSize);
+
+			std::vector<std::thread> workers;
+			workers.reserve(rangesCount - 1);
+
+			for (int range = 1; range < rangesCount; ++range)
+			{
+				const int first = getRangeStart(count, rangesCount, range);
+				const int last = getRangeStart(count, rangesCount, range + 1);
+
+				workers.emplace_back([&function, range, first, last]() { function(range, first, last); });
+			}
+
+			function(0, 0, getRangeStart(count, rangesCount, 1));
+
+			for (auto& worker : workers)
+			{
+				worker.join();
+			}
+		}
+	};
+}
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <cmath>
 
+#include "Parallel.h"
+
 namespace zazzDSP
 {
 	class Spectrum
@@ -516,6 +518,7 @@ namespace zazzDSP
 		/// <param name="binsPerSecond">Time-frequency resolution in bins per second (default 512)</param>
 		/// <param name="fftOrder">FFT order (FFT_SIZE = 2^fftOrder). Default is 12 (4096 samples)</param>
 		/// <param name="phaseWindowSize">Window size for phase averaging around dominant bin (0=single bin, 2=±2 bins for 5-bin average, etc.)</param>
+		/// <param name="threadsCount">Threads used for frame analysis (1=serial, 0=all cores). Result does not depend on it.</param>
 		static void calculateDominantFrequenciesWithIQInterpolation(
 			const juce::AudioBuffer<float>& buffer,
 			int sampleRate,
@@ -524,10 +527,12 @@ namespace zazzDSP
 			std::vector<float>* outPhaseTrajectory = nullptr,
 			int binsPerSecond = BINS_PER_SECOND,
 			int fftOrder = 12,
-			int phaseWindowSize = 3)
+			int phaseWindowSize = 3,
+			int threadsCount = 1)
 		{
 			constexpr int MIN_BIN = 1;
 			constexpr float MAX_FREQUENCY = 400.0f;
+			constexpr int MIN_FRAMES_PER_THREAD = 256;
 
 			const int FFT_SIZE = 1 << fftOrder;
 			const auto samples = buffer.getNumSamples();
@@ -541,86 +546,94 @@ namespace zazzDSP
 
 			const int NUM_TIME_BINS = calculateNumTimeBins(samples, sampleRate, binsPerSecond);
 
-			juce::dsp::FFT forwardFFT(fftOrder);
-			juce::dsp::WindowingFunction<float> window(FFT_SIZE, juce::dsp::WindowingFunction<float>::hann);
-
 			const float binFrequencyResolution = (float)sampleRate / FFT_SIZE;
 			const float blockSize = (float)samples / NUM_TIME_BINS;
-
-			// Prepare output containers
-			std::vector<std::vector<float>> magnitudes(NUM_TIME_BINS, std::vector<float>(FFT_SIZE / 2 + 1, 0.0f));
-			std::vector<std::vector<float>> realData(NUM_TIME_BINS, std::vector<float>(FFT_SIZE / 2 + 1, 0.0f));
-			std::vector<std::vector<float>> imagData(NUM_TIME_BINS, std::vector<float>(FFT_SIZE / 2 + 1, 0.0f));
+			const int maxBin = (int)(MAX_FREQUENCY / binFrequencyResolution);
+			const int numBins = FFT_SIZE / 2 + 1;
 
 			timeBinCenterSamples.assign(NUM_TIME_BINS, 0);
+			dominantFrequencies.assign(NUM_TIME_BINS, 0.0f);
+			if (outPhaseTrajectory != nullptr)
+			{
+				outPhaseTrajectory->assign(NUM_TIME_BINS, 0.0f);
+			}
 
-			std::vector<float> fftData(2 * FFT_SIZE);
-
-			// Step 1: Perform FFT and extract magnitudes + real/imaginary components
-			for (int timeIdx = 0; timeIdx < NUM_TIME_BINS; ++timeIdx)
+			// Frames are independent. Each frame is analysed on its own, so spectra of all frames
+			// do not have to be kept in memory and frame ranges can run on separate threads.
+			// Frame windows overlap neighbouring ranges, buffer is only read.
+			Parallel::forRanges(NUM_TIME_BINS, threadsCount, MIN_FRAMES_PER_THREAD, [&](const int, const int firstFrame, const int lastFrame)
 			{
-				float centerSampleFloat = blockSize * (timeIdx + 0.5f);
-				int centerSample = (int)centerSampleFloat;
-				int startSample = centerSample - FFT_SIZE / 2;
+				juce::dsp::FFT forwardFFT(fftOrder);
+				juce::dsp::WindowingFunction<float> window(FFT_SIZE, juce::dsp::WindowingFunction<float>::hann);
 
-				if (startSample < 0)
-				{
-					startSample = 0;
-				}
-				else if (startSample + FFT_SIZE > samples)
-				{
-					startSample = samples - FFT_SIZE;
-				}
+				std::vector<float> fftData(2 * FFT_SIZE);
+				std::vector<std::vector<float>> magnitudes(1, std::vector<float>(numBins, 0.0f));
+				std::vector<std::vector<float>> realData(1, std::vector<float>(numBins, 0.0f));
+				std::vector<std::vector<float>> imagData(1, std::vector<float>(numBins, 0.0f));
+				std::vector<float> frameDominantFrequency(1, 0.0f);
+				std::vector<float> framePhase(1, 0.0f);
 
-				timeBinCenterSamples[timeIdx] = centerSample;
+				for (int timeIdx = firstFrame; timeIdx < lastFrame; ++timeIdx)
+				{
+					float centerSampleFloat = blockSize * (timeIdx + 0.5f);
+					int centerSample = (int)centerSampleFloat;
+					int startSample = centerSample - FFT_SIZE / 2;
 
-				// Clear FFT buffer
-				std::fill(fftData.begin(), fftData.end(), 0.0f);
+					if (startSample < 0)
+					{
+						startSample = 0;
+					}
+					else if (startSample + FFT_SIZE > samples)
+					{
+						startSample = samples - FFT_SIZE;
+					}
 
-				// Copy audio data
-				std::copy(pBuffer + startSample, pBuffer + startSample + FFT_SIZE, fftData.begin());
+					timeBinCenterSamples[timeIdx] = centerSample;
 
-				// Apply windowing
-				window.multiplyWithWindowingTable(fftData.data(), FFT_SIZE);
+					// Clear FFT buffer
+					std::fill(fftData.begin(), fftData.end(), 0.0f);
 
-				// Perform FFT
-				forwardFFT.performRealOnlyForwardTransform(fftData.data());
+					// Copy audio data
+					std::copy(pBuffer + startSample, pBuffer + startSample + FFT_SIZE, fftData.begin());
 
-				// Extract magnitudes and real/imaginary components
-				const int numBins = FFT_SIZE / 2 + 1;
-				for (int bin = 0; bin < numBins; ++bin)
-				{
-					const float real = fftData[2 * bin];
-					const float imag = fftData[2 * bin + 1];
-					const float magnitude = std::sqrt(real * real + imag * imag);
+					// Apply windowing
+					window.multiplyWithWindowingTable(fftData.data(), FFT_SIZE);
 
-					magnitudes[timeIdx][bin] = magnitude;
-					realData[timeIdx][bin] = real;
-					imagData[timeIdx][bin] = imag;
-				}
-			}
+					// Perform FFT
+					forwardFFT.performRealOnlyForwardTransform(fftData.data());
 
-			// Step 2: Find dominant frequencies using I/Q interpolation for phase
-			dominantFrequencies.assign(NUM_TIME_BINS, 0.0f);
-			if (outPhaseTrajectory != nullptr)
-			{
-				outPhaseTrajectory->assign(NUM_TIME_BINS, 0.0f);
-			}
+					// Extract magnitudes and real/imaginary components
+					for (int bin = 0; bin < numBins; ++bin)
+					{
+						const float real = fftData[2 * bin];
+						const float imag = fftData[2 * bin + 1];
+						const float magnitude = std::sqrt(real * real + imag * imag);
 
-			const int maxBin = (int)(MAX_FREQUENCY / binFrequencyResolution);
+						magnitudes[0][bin] = magnitude;
+						realData[0][bin] = real;
+						imagData[0][bin] = imag;
+					}
 
-			// Call findDominantFrequenciesFromFFT with I/Q data for superior phase accuracy
-			findDominantFrequenciesFromFFT(
-				magnitudes,
-				binFrequencyResolution,
-				MIN_BIN,
-				maxBin,
-				dominantFrequencies,
-				nullptr,  // Don't use legacy phase interpolation
-				outPhaseTrajectory,
-				&realData,  // Pass real FFT components
-				&imagData,  // Pass imaginary FFT components
-				phaseWindowSize);  // Use window-based phase averaging
+					// Find dominant frequency using I/Q interpolation for phase
+					findDominantFrequenciesFromFFT(
+						magnitudes,
+						binFrequencyResolution,
+						MIN_BIN,
+						maxBin,
+						frameDominantFrequency,
+						nullptr,  // Don't use legacy phase interpolation
+						outPhaseTrajectory != nullptr ? &framePhase : nullptr,
+						&realData,  // Pass real FFT components
+						&imagData,  // Pass imaginary FFT components
+						phaseWindowSize);  // Use window-based phase averaging
+
+					dominantFrequencies[timeIdx] = frameDominantFrequency[0];
+					if (outPhaseTrajectory != nullptr)
+					{
+						(*outPhaseTrajectory)[timeIdx] = framePhase[0];
+					}
+				}
+			});
 		}
 	};
 }
\ No newline at end of file
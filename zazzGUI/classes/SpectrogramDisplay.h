@@ -1,11 +1,23 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <JuceHeader.h>
 
 namespace zazzGUI
 {
-	class SpectrogramDisplay : public juce::Component, public juce::TooltipClient
+	/**
+	 * Spectrogram of the zoomed range, one column per pixel.
+	 *
+	 * Columns are computed on a background thread, every 8th pixel first, then refined.
+	 * Computed columns are cached, zoom and pan compute only newly visible ones.
+	 * Magnitudes are scaled against the buffer peak, so columns computed later match earlier ones
+	 * and only pixel columns of newly computed columns are redrawn.
+	 */
+	class SpectrogramDisplay : public juce::Component, public juce::TooltipClient, private juce::Timer
 	{
 	public:
 		SpectrogramDisplay(juce::String name) : m_nameGroupComponent(name)
@@ -13,213 +25,407 @@ namespace zazzGUI
 			addAndMakeVisible(m_nameGroupComponent);
 		}
 
-		~SpectrogramDisplay() = default;
+		~SpectrogramDisplay() override
+		{
+			stopTimer();
+		}
 
 		juce::String getTooltip() override
 		{
 			return "";  // Tooltip is drawn in paint() instead of using the tooltip system
 		}
 
-		void setAudioBuffer(const juce::AudioBuffer<float> buffer)
+		void setAudioBuffer(const juce::AudioBuffer<float>& buffer)
 		{
-			m_audioBuffer = buffer;
-			m_leftSampleIndex = 0;
-			m_rightSampleIndex = buffer.getNumSamples();
-			
-			computeSpectrogram();
-			updateSpectrogramImage();
+			setSharedAudioBuffer(std::make_shared<const juce::AudioBuffer<float>>(buffer));
+		}
+
+		void setAudioBuffer(juce::AudioBuffer<float>&& buffer)
+		{
+			setSharedAudioBuffer(std::make_shared<const juce::AudioBuffer<float>>(std::move(buffer)));
 		}
 
 		void setSampleRate(const int sampleRate)
 		{
-			if (sampleRate > 0)
+			if (sampleRate > 0 && sampleRate != m_sampleRate)
 			{
 				m_sampleRate = sampleRate;
+
+				// Frame grid and bin mapping depend on sample rate
+				invalidateColumns();
 			}
 		}
 
 		void setHorizontalZoom(const int leftSampleIndex, const int rightSampleIndex)
 		{
 			if (leftSampleIndex >= rightSampleIndex) return;  // Invalid range
-			if (rightSampleIndex > m_audioBuffer.getNumSamples()) return;  // Out of bounds
+			if (m_audioBuffer == nullptr || rightSampleIndex > m_audioBuffer->getNumSamples()) return;  // Out of bounds
 
 			m_leftSampleIndex = std::max(0, leftSampleIndex);
 			m_rightSampleIndex = rightSampleIndex;
 
-			// Recompute spectrogram for the zoomed region if it's large enough
-			const int zoomSamples = m_rightSampleIndex - m_leftSampleIndex;
-			if (zoomSamples >= FFT_SIZE)
-			{
-				// Zoom region is large enough, recompute spectrogram for better resolution
-				computeSpectrogramForZoomedRegion();
-			}
-			// else: use the pre-computed full buffer spectrogram, just display a zoomed portion
-
+			// Cached columns are reused, only newly visible ones are computed
+			requestVisibleColumns();
 			updateSpectrogramImage();
 		}
 
-		void computeSpectrogramForZoomedRegion()
+		int getLeftSampleIndex() const
+		{
+			return m_leftSampleIndex;
+		}
+
+		int getRightSampleIndex() const
+		{
+			return m_rightSampleIndex;
+		}
+
+	private:
+		static constexpr int FFT_ORDER = 14;
+		static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+		static constexpr float MIN_FREQUENCY = 10.0f;
+		static constexpr int NUM_FREQUENCY_BINS = 256;
+		static constexpr float MAX_FREQUENCY = 400.0f;
+		static constexpr int COARSE_STRIDE = 8;				// First pass computes every 8th pixel column
+		static constexpr int TILE_SIZE = 32;				// Columns published by worker at once
+		static constexpr int MAX_CACHED_COLUMNS = 16384;
+		static constexpr int TIMER_INTERVAL_MS = 50;
+		static constexpr int PALETTE_SIZE = 256;
+		static constexpr int STOP_TIMEOUT_MS = 2000;
+
+		//==============================================================================
+		/**
+		 * Computes spectrogram columns on a background thread.
+		 *
+		 * Column is identified by key, its frame is centered at key * frameHop samples.
+		 * Keys are computed in requested order, columns are published in tiles.
+		 * New request replaces the one in progress.
+		 */
+		class ColumnWorker : public juce::Thread
 		{
-			m_spectrogram.validTimeSteps = 0;
-			m_spectrogram.maxMagnitude = 0.0f;
-			m_spectrogram.frameCenterSamples.clear();
+		public:
+			struct Request
+			{
+				std::shared_ptr<const juce::AudioBuffer<float>> buffer;
+				std::vector<int> keys;
+				int generation = 0;
+				int frameHop = 1;
+				int minBin = 0;
+				int maxBin = 0;
+			};
+
+			struct Column
+			{
+				int key = 0;
+				int generation = 0;
+				std::vector<float> magnitudes;
+			};
 
-			const int zoomSamples = m_rightSampleIndex - m_leftSampleIndex;
-			if (zoomSamples <= 0 || m_audioBuffer.getNumSamples() == 0)
+			ColumnWorker() : juce::Thread("Spectrogram"), m_fft(FFT_ORDER), m_window(FFT_SIZE, juce::dsp::WindowingFunction<float>::hann)
 			{
-				return;
+				m_fftData.resize(2 * FFT_SIZE);
 			}
 
-			// Create a temporary buffer containing only the zoomed region
-			juce::AudioBuffer<float> zoomedBuffer(m_audioBuffer.getNumChannels(), zoomSamples);
-			for (int channel = 0; channel < m_audioBuffer.getNumChannels(); ++channel)
+			~ColumnWorker() override
 			{
-				const auto* sourceData = m_audioBuffer.getReadPointer(channel, m_leftSampleIndex);
-				auto* destData = zoomedBuffer.getWritePointer(channel);
-				std::copy(sourceData, sourceData + zoomSamples, destData);
+				stopThread(STOP_TIMEOUT_MS);
 			}
 
-			// Calculate FFT magnitudes using centered windows on the zoomed buffer
-			std::vector<std::vector<float>> magnitudes;
-			std::vector<int> frameCenterSamples;
-			float binFrequencyResolution = 0.0f;
-			int numTimeBins = 0;
+			// Message thread
+			void request(Request&& request)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_request = std::move(request);
+					m_hasRequest = true;
+					m_busy = true;
+				}
 
-			zazzDSP::Spectrum::calculateFFTMagnitudes(
-				zoomedBuffer,
-				m_sampleRate,
-				FFT_ORDER,
-				magnitudes,
-				frameCenterSamples,
-				binFrequencyResolution,
-				numTimeBins);
+				if (!isThreadRunning())
+				{
+					startThread();
+				}
 
-			if (numTimeBins == 0 || magnitudes.empty())
+				notify();
+			}
+
+			// Message thread, appends columns computed since the last call
+			void popColumns(std::vector<Column>& columns)
 			{
-				return;
+				std::lock_guard<std::mutex> lock(m_mutex);
+				std::move(m_columns.begin(), m_columns.end(), std::back_inserter(columns));
+				m_columns.clear();
 			}
 
-			// Store frame center samples, converting from zoomed buffer coordinates to original buffer coordinates
-			m_spectrogram.frameCenterSamples.resize(frameCenterSamples.size());
-			for (size_t i = 0; i < frameCenterSamples.size(); ++i)
+			// False once all requested columns were published
+			bool isBusy()
 			{
-				m_spectrogram.frameCenterSamples[i] = frameCenterSamples[i] + m_leftSampleIndex;
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_busy;
 			}
 
-			// Remap FFT bins to display frequency range and normalize
-			remapFFTBinsToDisplay(magnitudes, binFrequencyResolution, numTimeBins);
-		}
+			void run() override
+			{
+				while (!threadShouldExit())
+				{
+					Request request;
 
-		int getLeftSampleIndex() const
+					{
+						std::lock_guard<std::mutex> lock(m_mutex);
+						if (m_hasRequest)
+						{
+							request = std::move(m_request);
+							m_hasRequest = false;
+						}
+						else
+						{
+							m_busy = false;
+						}
+					}
+
+					if (request.buffer == nullptr)
+					{
+						wait(-1);
+						continue;
+					}
+
+					std::vector<Column> tile;
+					tile.reserve(TILE_SIZE);
+
+					for (const int key : request.keys)
+					{
+						if (threadShouldExit() || hasNewRequest())
+						{
+							break;
+						}
+
+						Column column;
+						column.key = key;
+						column.generation = request.generation;
+						computeColumn(*request.buffer, key * request.frameHop, request.minBin, request.maxBin, column.magnitudes);
+						tile.push_back(std::move(column));
+
+						if ((int)tile.size() == TILE_SIZE)
+						{
+							publish(tile);
+						}
+					}
+
+					publish(tile);
+				}
+			}
+
+		private:
+			bool hasNewRequest()
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_hasRequest;
+			}
+
+			void publish(std::vector<Column>& tile)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				std::move(tile.begin(), tile.end(), std::back_inserter(m_columns));
+				tile.clear();
+			}
+
+			// Hann windowed frame centered at centerSample, magnitudes of display bins only
+			void computeColumn(const juce::AudioBuffer<float>& buffer, const int centerSample, const int minBin, const int maxBin, std::vector<float>& magnitudes)
+			{
+				const int samples = buffer.getNumSamples();
+				const int startSample = juce::jlimit(0, samples - FFT_SIZE, centerSample - FFT_SIZE / 2);
+				const float* pBuffer = buffer.getReadPointer(0);
+
+				std::fill(m_fftData.begin(), m_fftData.end(), 0.0f);
+				std::copy(pBuffer + startSample, pBuffer + startSample + FFT_SIZE, m_fftData.begin());
+
+				m_window.multiplyWithWindowingTable(m_fftData.data(), FFT_SIZE);
+				m_fft.performRealOnlyForwardTransform(m_fftData.data());
+
+				const int freqBinRange = maxBin - minBin;
+				magnitudes.assign(NUM_FREQUENCY_BINS, 0.0f);
+
+				for (int freqIdx = 0; freqIdx < NUM_FREQUENCY_BINS; ++freqIdx)
+				{
+					const int fftBin = minBin + (freqIdx * freqBinRange) / NUM_FREQUENCY_BINS;
+
+					if (fftBin >= 0 && fftBin <= FFT_SIZE / 2)
+					{
+						const float real = m_fftData[2 * fftBin];
+						const float img = m_fftData[2 * fftBin + 1];
+						magnitudes[freqIdx] = std::sqrt(real * real + img * img);
+					}
+				}
+			}
+
+			juce::dsp::FFT m_fft;
+			juce::dsp::WindowingFunction<float> m_window;
+			std::vector<float> m_fftData;
+
+			std::mutex m_mutex;
+			Request m_request;
+			std::vector<Column> m_columns;
+			bool m_hasRequest = false;
+			bool m_busy = false;
+		};
+
+		//==============================================================================
+		void setSharedAudioBuffer(std::shared_ptr<const juce::AudioBuffer<float>> buffer)
 		{
-			return m_leftSampleIndex;
+			// Shared with worker thread, columns of previous buffer are dropped
+			m_audioBuffer = std::move(buffer);
+			m_leftSampleIndex = 0;
+			m_rightSampleIndex = m_audioBuffer->getNumSamples();
+
+			// Hann windowed sine of buffer peak amplitude peaks at amplitude * FFT_SIZE / 4,
+			// fixed for the whole buffer, unlike the maximum of columns computed so far
+			const bool hasSamples = m_audioBuffer->getNumChannels() > 0 && m_audioBuffer->getNumSamples() > 0;
+			const float peak = hasSamples ? m_audioBuffer->getMagnitude(0, 0, m_audioBuffer->getNumSamples()) : 0.0f;
+			m_maxMagnitude = 0.25f * (float)FFT_SIZE * peak;
+
+			invalidateColumns();
+			requestVisibleColumns();
+			updateSpectrogramImage();
 		}
 
-		int getRightSampleIndex() const
+		// Frames lie on a grid of sample rate / BINS_PER_SECOND samples, same spacing as Spectrum::calculateFFTMagnitudes
+		int getFrameHop() const
 		{
-			return m_rightSampleIndex;
+			return std::max(1, m_sampleRate / zazzDSP::Spectrum::BINS_PER_SECOND);
 		}
 
-	private:
-		static constexpr int FFT_ORDER = 14;
-		static constexpr int FFT_SIZE = 1 << FFT_ORDER;
-		static constexpr float MIN_FREQUENCY = 10.0f;
-		static constexpr int NUM_FREQUENCY_BINS = 256;
-		static constexpr float MAX_FREQUENCY = 400.0f;
-		static constexpr int NUM_TIME_BINS = 2048;
-
-		struct SpectrogramData
+		void invalidateColumns()
 		{
-			std::vector<std::vector<float>> data;
-			std::vector<int> frameCenterSamples;  // Maps time bin index to sample position
-			int validTimeSteps = 0;
-			float maxMagnitude = 0.0f;
-
-			SpectrogramData() : data(NUM_TIME_BINS, std::vector<float>(NUM_FREQUENCY_BINS, 0.0f)) {}
-		};
+			m_generation++;
+			m_columnCache.clear();
+		}
 
-		void computeSpectrogram()
+		// Maps pixel columns to frame keys and requests the ones not cached yet, coarse pass first
+		void requestVisibleColumns()
 		{
-			m_spectrogram.validTimeSteps = 0;
-			m_spectrogram.maxMagnitude = 0.0f;
-			m_spectrogram.frameCenterSamples.clear();
+			const int width = getWidth();
+			m_visibleKeys.clear();
 
-			if (m_audioBuffer.getNumSamples() == 0)
+			if (width <= 0 || !isVisible() || m_audioBuffer == nullptr || m_audioBuffer->getNumSamples() < FFT_SIZE)
 			{
 				return;
 			}
 
-			// Calculate FFT magnitudes using centered windows
-			std::vector<std::vector<float>> magnitudes;
-			std::vector<int> frameCenterSamples;
-			float binFrequencyResolution = 0.0f;
-			int numTimeBins = 0;
+			// Zoomed out views use every 2^n-th frame, so frames are shared between zoom levels
+			const int frameHop = getFrameHop();
+			const double samplesPerPixel = (double)(m_rightSampleIndex - m_leftSampleIndex) / (double)width;
+			const int maxKey = m_audioBuffer->getNumSamples() / frameHop;
+
+			int keyStep = 1;
+			while ((double)(2 * keyStep * frameHop) <= samplesPerPixel)
+			{
+				keyStep *= 2;
+			}
+
+			m_visibleKeys.resize(width);
+			for (int x = 0; x < width; ++x)
+			{
+				const double centerSample = m_leftSampleIndex + (x + 0.5) * samplesPerPixel;
+				const int key = (int)std::lround(centerSample / (double)(keyStep * frameHop)) * keyStep;
+				m_visibleKeys[x] = juce::jlimit(0, maxKey, key);
+			}
 
-			zazzDSP::Spectrum::calculateFFTMagnitudes(
-				m_audioBuffer,
-				m_sampleRate,
-				FFT_ORDER,
-				magnitudes,
-				frameCenterSamples,
-				binFrequencyResolution,
-				numTimeBins);
+			// Keep cache bounded, visible columns stay
+			if ((int)m_columnCache.size() > MAX_CACHED_COLUMNS)
+			{
+				std::unordered_set<int> visible(m_visibleKeys.begin(), m_visibleKeys.end());
+				for (auto it = m_columnCache.begin(); it != m_columnCache.end();)
+				{
+					it = visible.count(it->first) ? std::next(it) : m_columnCache.erase(it);
+				}
+			}
+
+			ColumnWorker::Request request;
+			std::unordered_set<int> requested;
+
+			for (int stride = COARSE_STRIDE; stride >= 1; stride /= 2)
+			{
+				for (int x = 0; x < width; x += stride)
+				{
+					const int key = m_visibleKeys[x];
+					if (m_columnCache.count(key) == 0 && requested.insert(key).second)
+					{
+						request.keys.push_back(key);
+					}
+				}
+			}
 
-			if (numTimeBins == 0 || magnitudes.empty())
+			if (request.keys.empty())
 			{
 				return;
 			}
 
-			// Store frame center samples for later zoom calculations
-			m_spectrogram.frameCenterSamples = frameCenterSamples;
+			const float binFrequencyResolution = (float)m_sampleRate / FFT_SIZE;
+			request.buffer = m_audioBuffer;
+			request.generation = m_generation;
+			request.frameHop = frameHop;
+			request.minBin = (int)(MIN_FREQUENCY / binFrequencyResolution);
+			request.maxBin = (int)(MAX_FREQUENCY / binFrequencyResolution);
 
-			// Remap FFT bins to display frequency range and normalize
-			remapFFTBinsToDisplay(magnitudes, binFrequencyResolution, numTimeBins);
+			m_worker.request(std::move(request));
+			startTimer(TIMER_INTERVAL_MS);
 		}
 
-		void remapFFTBinsToDisplay(const std::vector<std::vector<float>>& magnitudes, float binFrequencyResolution, int numTimeBins)
+		void timerCallback() override
 		{
-			// Map FFT bins to display frequency range
-			const int minBin = (int)(MIN_FREQUENCY / binFrequencyResolution);
-			const int maxBin = (int)(MAX_FREQUENCY / binFrequencyResolution);
-			const int freqBinRange = maxBin - minBin;
+			// Worker publishes before it turns idle, so nothing is left behind once it is idle
+			const bool isBusy = m_worker.isBusy();
 
-			float maxMagnitudeLocal = 0.0f;
+			m_receivedColumns.clear();
+			m_worker.popColumns(m_receivedColumns);
 
-			// First pass: map to display range and find maximum magnitude
-			for (int timeIdx = 0; timeIdx < numTimeBins; ++timeIdx)
+			m_newKeys.clear();
+			for (auto& column : m_receivedColumns)
 			{
-				for (int freqIdx = 0; freqIdx < NUM_FREQUENCY_BINS; ++freqIdx)
+				if (column.generation != m_generation)
 				{
-					const int fftBin = minBin + (freqIdx * freqBinRange) / NUM_FREQUENCY_BINS;
-
-					if (fftBin >= 0 && fftBin < (int)magnitudes[timeIdx].size())
-					{
-						const float magnitude = magnitudes[timeIdx][fftBin];
-						m_spectrogram.data[timeIdx][freqIdx] = magnitude;
-						maxMagnitudeLocal = std::max(maxMagnitudeLocal, magnitude);
-					}
+					continue;
 				}
 
-				m_spectrogram.validTimeSteps++;
+				m_columnCache[column.key] = std::move(column.magnitudes);
+				m_newKeys.insert(column.key);
 			}
 
-			// Second pass: normalize all values based on maximum magnitude
-			m_spectrogram.maxMagnitude = maxMagnitudeLocal;
+			if (!m_newKeys.empty())
+			{
+				drawNewColumns();
+				repaint();
+			}
 
-			if (maxMagnitudeLocal > 0.0f)
+			if (!isBusy)
 			{
-				for (int timeIdx = 0; timeIdx < m_spectrogram.validTimeSteps; ++timeIdx)
+				stopTimer();
+			}
+		}
+
+		// Nearest cached column within coarse stride, nullptr if none is ready yet
+		const std::vector<float>* findColumnForPixel(const int x) const
+		{
+			const int width = (int)m_visibleKeys.size();
+
+			for (int distance = 0; distance < COARSE_STRIDE; ++distance)
+			{
+				for (const int neighbour : { x - distance, x + distance })
 				{
-					for (int freqIdx = 0; freqIdx < NUM_FREQUENCY_BINS; ++freqIdx)
+					if (neighbour >= 0 && neighbour < width)
 					{
-						m_spectrogram.data[timeIdx][freqIdx] /= maxMagnitudeLocal;
-						m_spectrogram.data[timeIdx][freqIdx] = juce::jlimit(0.0f, 1.0f, m_spectrogram.data[timeIdx][freqIdx]);
+						const auto it = m_columnCache.find(m_visibleKeys[neighbour]);
+						if (it != m_columnCache.end())
+						{
+							return &it->second;
+						}
 					}
 				}
 			}
+
+			return nullptr;
 		}
 
-		
+		// Redraws the whole image
 		void updateSpectrogramImage()
 		{
 			const int width = getWidth();
@@ -231,68 +437,104 @@ namespace zazzGUI
 			}
 
 			// Create image to cache the spectrogram
-			m_spectrogramImage = juce::Image(juce::Image::RGB, width, height, true);
-			juce::Graphics g(m_spectrogramImage);
+			if (m_spectrogramImage.isNull() || m_spectrogramImage.getWidth() != width || m_spectrogramImage.getHeight() != height)
+			{
+				m_spectrogramImage = juce::Image(juce::Image::RGB, width, height, true);
+			}
+			else
+			{
+				m_spectrogramImage.clear(m_spectrogramImage.getBounds());
+			}
 
 			// Draw spectrogram
-			if (m_spectrogram.validTimeSteps > 0 && !m_spectrogram.frameCenterSamples.empty())
+			if ((int)m_visibleKeys.size() != width || m_maxMagnitude <= 0.0f)
 			{
-				// Find the time bin range that corresponds to the zoom sample range
-				// Use lower_bound and upper_bound for robust searching
-				int startTimeBin = 0;
-				int endTimeBin = m_spectrogram.validTimeSteps - 1;
+				return;
+			}
 
-				// Find first frame center that is >= m_leftSampleIndex
-				auto it = std::lower_bound(m_spectrogram.frameCenterSamples.begin(), m_spectrogram.frameCenterSamples.end(), m_leftSampleIndex);
-				if (it != m_spectrogram.frameCenterSamples.end())
-				{
-					startTimeBin = std::distance(m_spectrogram.frameCenterSamples.begin(), it);
-				}
-				else
+			if (m_palette.empty())
+			{
+				m_palette.resize(PALETTE_SIZE);
+				for (int i = 0; i < PALETTE_SIZE; ++i)
 				{
-					// If no frame >= m_leftSampleIndex, use the last frame
-					startTimeBin = m_spectrogram.frameCenterSamples.size() - 1;
+					m_palette[i] = getColourForValue((float)i / (float)(PALETTE_SIZE - 1));
 				}
+			}
 
-				// Find last frame center that is <= m_rightSampleIndex
-				auto it_upper = std::upper_bound(m_spectrogram.frameCenterSamples.begin(), m_spectrogram.frameCenterSamples.end(), m_rightSampleIndex);
-				if (it_upper != m_spectrogram.frameCenterSamples.begin())
-				{
-					endTimeBin = std::distance(m_spectrogram.frameCenterSamples.begin(), std::prev(it_upper));
-				}
-				else
-				{
-					// If no frame <= m_rightSampleIndex, use the first frame
-					endTimeBin = 0;
-				}
+			// Frequency bin of each pixel row, highest frequency on top
+			m_rowFrequencyIndices.resize(height);
+			for (int y = 0; y < height; ++y)
+			{
+				m_rowFrequencyIndices[y] = NUM_FREQUENCY_BINS - 1 - (y * NUM_FREQUENCY_BINS) / height;
+			}
 
-				// Ensure valid range
-				startTimeBin = std::max(0, std::min(startTimeBin, (int)m_spectrogram.frameCenterSamples.size() - 1));
-				endTimeBin = std::max(0, std::min(endTimeBin, (int)m_spectrogram.frameCenterSamples.size() - 1));
+			juce::Image::BitmapData bitmap(m_spectrogramImage, juce::Image::BitmapData::writeOnly);
 
-				const int numDisplayBins = endTimeBin - startTimeBin + 1;
-				if (numDisplayBins <= 0) return;
+			for (int x = 0; x < width; ++x)
+			{
+				drawPixelColumn(bitmap, x);
+			}
+		}
 
-				const float pixelWidth = (float)width / (float)numDisplayBins;
-				const float pixelHeight = (float)height / (float)NUM_FREQUENCY_BINS;
+		// Redraws only pixel columns that may use one of m_newKeys, the image is otherwise up to date
+		void drawNewColumns()
+		{
+			const int width = getWidth();
+			const int height = getHeight();
 
-				for (int displayIdx = 0; displayIdx < numDisplayBins; ++displayIdx)
-				{
-					const int timeIdx = startTimeBin + displayIdx;
-					if (timeIdx < 0 || timeIdx >= m_spectrogram.validTimeSteps) continue;
+			if (m_spectrogramImage.isNull() || m_spectrogramImage.getWidth() != width || m_spectrogramImage.getHeight() != height ||
+				(int)m_visibleKeys.size() != width || (int)m_rowFrequencyIndices.size() != height || m_palette.empty())
+			{
+				updateSpectrogramImage();
+				return;
+			}
 
-					for (int freqIdx = 0; freqIdx < NUM_FREQUENCY_BINS; ++freqIdx)
-					{
-						const float value = m_spectrogram.data[timeIdx][NUM_FREQUENCY_BINS - 1 - freqIdx];
-						const juce::Colour colour = getColourForValue(value);
+			if (m_maxMagnitude <= 0.0f)
+			{
+				return;
+			}
 
-						g.setColour(colour);
-						const float x = (float)displayIdx * pixelWidth;
-						const float y = (float)freqIdx * pixelHeight;
-						g.fillRect(x, y, pixelWidth, pixelHeight);
+			// Pixels without own column show the nearest one within coarse stride
+			m_dirtyPixels.assign(width, false);
+			for (int x = 0; x < width; ++x)
+			{
+				if (m_newKeys.count(m_visibleKeys[x]) != 0)
+				{
+					const int last = std::min(width - 1, x + COARSE_STRIDE - 1);
+					for (int neighbour = std::max(0, x - COARSE_STRIDE + 1); neighbour <= last; ++neighbour)
+					{
+						m_dirtyPixels[neighbour] = true;
 					}
 				}
 			}
+
+			juce::Image::BitmapData bitmap(m_spectrogramImage, juce::Image::BitmapData::writeOnly);
+
+			for (int x = 0; x < width; ++x)
+			{
+				if (m_dirtyPixels[x])
+				{
+					drawPixelColumn(bitmap, x);
+				}
+			}
+		}
+
+		void drawPixelColumn(juce::Image::BitmapData& bitmap, const int x)
+		{
+			const std::vector<float>* column = findColumnForPixel(x);
+			if (column == nullptr)
+			{
+				return;
+			}
+
+			const float normalization = (float)(PALETTE_SIZE - 1) / m_maxMagnitude;
+			const int height = (int)m_rowFrequencyIndices.size();
+
+			for (int y = 0; y < height; ++y)
+			{
+				const int paletteIdx = juce::jlimit(0, PALETTE_SIZE - 1, (int)((*column)[m_rowFrequencyIndices[y]] * normalization));
+				bitmap.setPixelColour(x, y, m_palette[paletteIdx]);
+			}
 		}
 
 		void paint(juce::Graphics& g) override
@@ -343,6 +585,14 @@ namespace zazzGUI
 			m_nameGroupComponent.setTopLeftPosition(column1, row1);
 
 			// Regenerate cached spectrogram image when component is resized
+			requestVisibleColumns();
+			updateSpectrogramImage();
+		}
+
+		void visibilityChanged() override
+		{
+			// Hidden spectrogram is not computed
+			requestVisibleColumns();
 			updateSpectrogramImage();
 		}
 
@@ -364,7 +614,7 @@ namespace zazzGUI
 				const int freqIdx = (int)((relativY / (float)spectrogramHeight) * NUM_FREQUENCY_BINS);
 				const int clampedFreqIdx = juce::jlimit(0, NUM_FREQUENCY_BINS - 1, freqIdx);
 
-				// Convert pixel index back to FFT bin using the same logic as computeSpectrogram
+				// Convert pixel index back to FFT bin using the same logic as ColumnWorker::computeColumn
 				const float binFrequencyResolution = (float)m_sampleRate / FFT_SIZE;
 				const int minBin = (int)(MIN_FREQUENCY / binFrequencyResolution);
 				const int maxBin = (int)(MAX_FREQUENCY / binFrequencyResolution);
@@ -408,15 +658,23 @@ namespace zazzGUI
 			return juce::Colour::fromHSV(hue, saturation, brightness, 1.0f);
 		}
 
-		juce::AudioBuffer<float> m_audioBuffer;
-		SpectrogramData m_spectrogram;
+		std::shared_ptr<const juce::AudioBuffer<float>> m_audioBuffer;
 		zazzGUI::GroupLabel m_nameGroupComponent;
 		juce::Image m_spectrogramImage;  // Cached spectrogram rendering
+		std::unordered_map<int, std::vector<float>> m_columnCache;  // Raw display bin magnitudes by frame key
+		std::vector<ColumnWorker::Column> m_receivedColumns;
+		std::unordered_set<int> m_newKeys;  // Keys received in the last timer callback
+		std::vector<bool> m_dirtyPixels;
+		std::vector<int> m_visibleKeys;  // Frame key of each pixel column
+		std::vector<int> m_rowFrequencyIndices;
+		std::vector<juce::Colour> m_palette;
+		float m_maxMagnitude = 0.0f;  // Magnitude drawn with the last palette colour
+		int m_generation = 0;
 		float m_tooltipFrequency = -1.0f;  // Current frequency at mouse position (-1 = no tooltip)
-		std::vector<int> m_dominantFrequencyBins;  // Smoothed dominant frequency bins for each time step
 		int m_sampleRate = 48000;  // Audio sample rate in Hz (default 48kHz)
 		int m_leftSampleIndex = 0;
 		int m_rightSampleIndex = 0;
+		ColumnWorker m_worker;  // Last member, thread stops before the rest is destroyed
 
 	};
 }
\ No newline at end of file